@@ -0,0 +1,133 @@
+// File description:
+// Implements axis aligned bounding box stored as minimum and maximum corner.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Box.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// An axis aligned bounding box stored as its minimum and maximum corner.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Unlike <see cref="Box"/> (center and half extent), tests against bounds need only comparisons.
+/// Converting a box to bounds is exact for integers; for floating point types it rounds like `center ± halfExtent` does.
+/// Converting bounds to a box is lossy for integers: center and half extent are rounded down, so a component of odd
+/// extent comes back one smaller at the maximum corner, e.g. bounds (0, 0)-(3, 3) round trip to (0, 0)-(2, 2).
+/// </para>
+/// </remarks>
+template <template <typename> typename TVectorType, typename TValueType>
+struct Aabb
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using BoxType		= Box<TVectorType, ValueType>;
+
+	// Methods:
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Aabb"/> struct.
+	/// </summary>
+	constexpr Aabb() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Aabb"/> struct.
+	/// </summary>
+	/// <param name="lower_">The minimum corner.</param>
+	/// <param name="upper_">The maximum corner. Must not be less than `lower_` in any component.</param>
+	constexpr Aabb(VectorType const& lower_, VectorType const& upper_);
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Aabb"/> struct from a box.
+	/// </summary>
+	/// <param name="box_">The box.</param>
+	constexpr explicit Aabb(BoxType const& box_);
+
+	/// <summary>
+	/// Returns the empty bounds (inverted infinite bounds), neutral element of `extend`.
+	/// </summary>
+	/// <returns>The empty bounds.</returns>
+	constexpr static Aabb empty();
+
+	/// <summary>
+	/// Converts the bounds to a box.
+	/// </summary>
+	/// <returns>The box. For integers, center and half extent are rounded down.</returns>
+	constexpr BoxType toBox() const;
+
+	/// <summary>
+	/// Returns center of the bounds.
+	/// </summary>
+	/// <returns>Center of the bounds.</returns>
+	constexpr VectorType getCenter() const;
+
+	/// <summary>
+	/// Returns full extent of the bounds.
+	/// </summary>
+	/// <returns>Full extent of the bounds.</returns>
+	constexpr VectorType getExtent() const;
+
+	/// <summary>
+	/// Checks whether the bounds contain nothing (some component of `lower` exceeds `upper`).
+	/// </summary>
+	/// <returns>
+	///   <c>true</c> if the bounds are empty; otherwise, <c>false</c>.
+	/// </returns>
+	constexpr bool isEmpty() const;
+
+	/// <summary>
+	/// Extends the bounds to contain the point.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	constexpr void extend(VectorType const& point_);
+
+	/// <summary>
+	/// Extends the bounds to contain other bounds.
+	/// </summary>
+	/// <param name="other_">The other bounds.</param>
+	constexpr void extend(Aabb const& other_);
+
+	VectorType lower;
+	VectorType upper;
+};
+
+template <typename TValueType>
+using Aabb2			= Aabb<Vector2, TValueType>;
+
+template <typename TValueType>
+using Aabb3			= Aabb<Vector3, TValueType>;
+
+using Aabb2f		= Aabb2<float>;
+using Aabb2d		= Aabb2<double>;
+using Aabb2ld		= Aabb2<long double>;
+using Aabb2i8		= Aabb2<std::int8_t>;
+using Aabb2i16		= Aabb2<std::int16_t>;
+using Aabb2i32		= Aabb2<std::int32_t>;
+using Aabb2i64		= Aabb2<std::int64_t>;
+using Aabb2u8		= Aabb2<std::uint8_t>;
+using Aabb2u16		= Aabb2<std::uint16_t>;
+using Aabb2u32		= Aabb2<std::uint32_t>;
+using Aabb2u64		= Aabb2<std::uint64_t>;
+
+using Aabb3f		= Aabb3<float>;
+using Aabb3d		= Aabb3<double>;
+using Aabb3ld		= Aabb3<long double>;
+using Aabb3i8		= Aabb3<std::int8_t>;
+using Aabb3i16		= Aabb3<std::int16_t>;
+using Aabb3i32		= Aabb3<std::int32_t>;
+using Aabb3i64		= Aabb3<std::int64_t>;
+using Aabb3u8		= Aabb3<std::uint8_t>;
+using Aabb3u16		= Aabb3<std::uint16_t>;
+using Aabb3u32		= Aabb3<std::uint32_t>;
+using Aabb3u64		= Aabb3<std::uint64_t>;
+
+}
+
+#include "Private/Aabb.inl"
\ No newline at end of file
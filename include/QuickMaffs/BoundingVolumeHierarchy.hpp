@@ -0,0 +1,171 @@
+// File description:
+// Implements bounding volume hierarchy over a collection of balls, boxes or bounds.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Aabb.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+/// <summary>
+/// Node of the flat bounding volume hierarchy.
+/// </summary>
+template <typename TAabbType>
+struct BvhNode
+{
+	TAabbType		bounds;
+	std::uint32_t	offset;		// Leaf: index of the first shape. Inner node: index of the first child, the second one follows it.
+	std::uint32_t	count;		// Number of shapes in a leaf, 0 for inner nodes.
+};
+
+}
+
+/// <summary>
+/// Bounding volume hierarchy over a collection of shapes (<see cref="Ball"/>, <see cref="Box"/> or <see cref="Aabb"/>).
+/// </summary>
+/// <remarks>
+/// <para>
+/// Built top-down with binned surface area heuristic. Large nodes are binned in parallel, then the subtrees are built
+/// in parallel. Nodes live in one flat array with siblings next to each other, and shapes are reordered to leaf order,
+/// so a traversal touches memory mostly sequentially. Queries report indices of the shapes as passed to <c>build</c>.
+/// </para>
+/// </remarks>
+template <typename TShapeType>
+class BoundingVolumeHierarchy
+{
+public:
+
+	using ShapeType		= TShapeType;
+	using ValueType		= typename ShapeType::ValueType;
+	using VectorType	= typename ShapeType::VectorType;
+	using AabbType		= decltype(computeBounds(std::declval<ShapeType>()));
+	using Node			= priv::BvhNode<AabbType>;
+
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	/// <summary>
+	/// Result of a ray cast.
+	/// </summary>
+	struct RayHit
+	{
+		std::size_t	index = npos;		// Index of the hit shape, npos if nothing was hit.
+		ValueType	distance = 0;		// Ray parameter of the hit: the point is `origin + direction * distance`.
+	};
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="BoundingVolumeHierarchy"/> class.
+	/// </summary>
+	BoundingVolumeHierarchy() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="BoundingVolumeHierarchy"/> class.
+	/// </summary>
+	/// <param name="shapes_">The shapes.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	explicit BoundingVolumeHierarchy(std::vector<ShapeType> shapes_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Rebuilds the hierarchy over the shapes.
+	/// </summary>
+	/// <param name="shapes_">The shapes.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	void build(std::vector<ShapeType> shapes_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Returns number of shapes.
+	/// </summary>
+	/// <returns>Number of shapes.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Returns the nodes. The root is the first one.
+	/// </summary>
+	/// <returns>The nodes.</returns>
+	std::vector<Node> const & getNodes() const;
+
+	/// <summary>
+	/// Returns the shapes in leaf order.
+	/// </summary>
+	/// <returns>The shapes in leaf order.</returns>
+	std::vector<ShapeType> const & getShapes() const;
+
+	/// <summary>
+	/// Returns original index of every shape in leaf order.
+	/// </summary>
+	/// <returns>Original indices of the shapes.</returns>
+	std::vector<std::size_t> const & getShapeIndices() const;
+
+	/// <summary>
+	/// Calls the function with index of every shape containing the point.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	/// <param name="function_">The function, called as function_(index).</param>
+	template <typename TFunction>
+	void forEachContaining(VectorType const & point_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds indices of the shapes containing the point.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	/// <returns>Indices of the shapes, in traversal order.</returns>
+	std::vector<std::size_t> findContaining(VectorType const & point_) const;
+
+	/// <summary>
+	/// Calls the function with index of every shape intersecting the query shape.
+	/// </summary>
+	/// <param name="shape_">The query shape: ball, box or bounds.</param>
+	/// <param name="function_">The function, called as function_(index).</param>
+	template <typename TQueryShapeType, typename TFunction>
+	void forEachOverlapping(TQueryShapeType const & shape_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds indices of the shapes intersecting the query shape.
+	/// </summary>
+	/// <param name="shape_">The query shape: ball, box or bounds.</param>
+	/// <returns>Indices of the shapes, in traversal order.</returns>
+	template <typename TQueryShapeType>
+	std::vector<std::size_t> findOverlapping(TQueryShapeType const & shape_) const;
+
+	/// <summary>
+	/// Calls the function with index of every shape the ray intersects.
+	/// </summary>
+	/// <param name="origin_">The ray origin.</param>
+	/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+	/// <param name="function_">The function, called as function_(index).</param>
+	template <typename TFunction>
+	void forEachIntersectingRay(VectorType const & origin_, VectorType const & direction_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds indices of the shapes the ray intersects.
+	/// </summary>
+	/// <param name="origin_">The ray origin.</param>
+	/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+	/// <returns>Indices of the shapes, in traversal order.</returns>
+	std::vector<std::size_t> findIntersectingRay(VectorType const & origin_, VectorType const & direction_) const;
+
+	/// <summary>
+	/// Finds the first shape hit by the ray. Children are visited front to back and pruned by the closest hit so far.
+	/// </summary>
+	/// <param name="origin_">The ray origin.</param>
+	/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+	/// <param name="maxDistance_">Maximum ray parameter of the hit.</param>
+	/// <returns>The closest hit. Shapes containing the origin are hit at distance 0.</returns>
+	RayHit castRay(VectorType const & origin_, VectorType const & direction_,
+					ValueType const maxDistance_ = std::numeric_limits<ValueType>::infinity()) const;
+
+private:
+	std::vector<Node>			m_nodes;
+	std::vector<ShapeType>		m_shapes;
+	std::vector<std::size_t>	m_shapeIndices;
+};
+
+}
+
+#include "Private/BoundingVolumeHierarchy.inl"
\ No newline at end of file
@@ -0,0 +1,56 @@
+// File description:
+// Implements fitting of bounding volumes (minimum enclosing ball, bounding box) to point sets.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Ball.hpp"
+#include "Box.hpp"
+#include "Aabb.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Computes the smallest ball containing all points (Welzl's algorithm).
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <returns>The minimum enclosing ball; a zero ball when there are no points.</returns>
+/// <remarks>
+/// <para>
+/// Randomized incremental form of Welzl's algorithm: points are visited in shuffled order and the ball is
+/// recomputed only when a point lies outside, which takes expected linear time. The shuffle uses a fixed seed,
+/// so results are reproducible and the function can be called from several threads at once.
+/// </para>
+/// <para>
+/// A final pass grows the radius to cover points left outside by rounding.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V>
+Ball<T, V> computeEnclosingBall(T<V> const * points_, std::size_t const count_);
+
+/// <summary>
+/// Computes the smallest axis aligned box containing all points.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>The bounding box; a zero box when there are no points.</returns>
+/// <remarks>
+/// <para>
+/// One pass over the points. Every thread reduces its chunk into several independent minimum and maximum lanes
+/// per component, which the compiler keeps in SIMD registers; lanes and chunks are then merged with
+/// <c>lowerBounds</c> and <c>upperBounds</c>. The exact corners are converted to center and half extent,
+/// which rounds for floating point types, see <see cref="Aabb"/>.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V>
+Box<T, V> computeBoundingBox(T<V> const * points_, std::size_t const count_, std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/BoundingVolumes.inl"
\ No newline at end of file
@@ -0,0 +1,102 @@
+// File description:
+// Implements continuous collision detection: time of impact of moving balls against balls and boxes, single and batched.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Ball.hpp"
+#include "Box.hpp"
+#include "ShapeArrays.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+// Time of impact.
+// Shapes move linearly during a time step: at time t in [0, 1], a shape is at its position plus t * displacement,
+// where displacement is the velocity multiplied by the length of the step. Time of impact is the first t at which
+// the shapes touch: 0 when they already intersect at the start, infinity when they do not touch during the step.
+// Moving shapes are swept exactly, so fast shapes cannot pass through thin obstacles between steps.
+
+/// <summary>
+/// Computes time of impact of two moving balls.
+/// </summary>
+/// <param name="first_">The first ball at the start of the step.</param>
+/// <param name="firstDisplacement_">Displacement of the first ball during the step.</param>
+/// <param name="second_">The second ball at the start of the step.</param>
+/// <param name="secondDisplacement_">Displacement of the second ball during the step.</param>
+/// <returns>Time of impact in [0, 1], or infinity when the balls do not touch.</returns>
+template <template<typename> typename T, typename V>
+V computeTimeOfImpact(Ball<T, V> const & first_, T<V> const & firstDisplacement_, Ball<T, V> const & second_, T<V> const & secondDisplacement_);
+
+/// <summary>
+/// Computes time of impact of a moving ball and a moving box.
+/// </summary>
+/// <param name="ball_">The ball at the start of the step.</param>
+/// <param name="ballDisplacement_">Displacement of the ball during the step.</param>
+/// <param name="box_">The box at the start of the step.</param>
+/// <param name="boxDisplacement_">Displacement of the box during the step.</param>
+/// <returns>Time of impact in [0, 1], or infinity when the shapes do not touch.</returns>
+/// <remarks>
+/// <para>
+/// The center of the ball moves relative to the box, whose rounded copy (grown by the radius) it must not enter.
+/// Distance from the box is a quadratic function of time between the moments the center crosses planes of the
+/// box faces, so the first touch is found by solving at most 2 * dimensions + 1 quadratic equations.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V>
+V computeTimeOfImpact(Ball<T, V> const & ball_, T<V> const & ballDisplacement_, Box<T, V> const & box_, T<V> const & boxDisplacement_);
+
+/// <summary>
+/// Computes time of impact of a moving box and a moving ball, see the ball and box overload.
+/// </summary>
+/// <param name="box_">The box at the start of the step.</param>
+/// <param name="boxDisplacement_">Displacement of the box during the step.</param>
+/// <param name="ball_">The ball at the start of the step.</param>
+/// <param name="ballDisplacement_">Displacement of the ball during the step.</param>
+/// <returns>Time of impact in [0, 1], or infinity when the shapes do not touch.</returns>
+template <template<typename> typename T, typename V>
+V computeTimeOfImpact(Box<T, V> const & box_, T<V> const & boxDisplacement_, Ball<T, V> const & ball_, T<V> const & ballDisplacement_);
+
+// Batched variants.
+// Every ball of the array moves by the displacement with the same index against a static obstacle;
+// `times_` receives time of impact of every ball, so it must have room for `size()` entries.
+// Balls are processed in blocks by loops without branches, which the compiler vectorizes, and chunks of the
+// array run on worker threads. Throws std::invalid_argument when the displacement count differs from the ball count.
+
+/// <summary>
+/// Computes time of impact of every moving ball of the array against the static ball.
+/// </summary>
+/// <param name="balls_">The balls at the start of the step.</param>
+/// <param name="displacements_">Displacement of every ball during the step.</param>
+/// <param name="obstacle_">The static ball.</param>
+/// <param name="times_">Time of impact of every ball.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+template <template<typename> typename T, typename V>
+void computeTimesOfImpact(BallArray<T, V> const & balls_, PointArray<T, V> const & displacements_, Ball<T, V> const & obstacle_,
+						  V * times_, std::size_t const threadCount_ = 0);
+
+/// <summary>
+/// Computes time of impact of every moving ball of the array against the static box.
+/// </summary>
+/// <param name="balls_">The balls at the start of the step.</param>
+/// <param name="displacements_">Displacement of every ball during the step.</param>
+/// <param name="obstacle_">The static box.</param>
+/// <param name="times_">Time of impact of every ball.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <remarks>
+/// <para>
+/// A vectorized slab test against the box grown by the radius rejects balls that miss it; only the balls that
+/// reach the grown box are solved exactly, as in <see cref="computeTimeOfImpact"/>.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V>
+void computeTimesOfImpact(BallArray<T, V> const & balls_, PointArray<T, V> const & displacements_, Box<T, V> const & obstacle_,
+						  V * times_, std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/ContinuousCollision.inl"
\ No newline at end of file
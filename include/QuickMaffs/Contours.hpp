@@ -0,0 +1,51 @@
+// File description:
+// Implements marching squares contour extraction from scalar grids.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Polygon2.hpp"
+#include "ScalarGrid2.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Closed contour ring extracted from a scalar grid.
+/// </summary>
+template <typename TValueType>
+struct Contour2
+{
+	static constexpr std::size_t noParent = std::numeric_limits<std::size_t>::max();
+
+	Polygon2<TValueType>	ring;					// Area above the iso value is on the left side of the ring.
+	bool					hole = false;			// Ring is clockwise - it bounds area below the iso value.
+	std::size_t				parent = noParent;		// Index of the innermost ring enclosing this one.
+};
+
+/// <summary>
+/// Extracts iso-contours of the grid with marching squares.
+/// </summary>
+/// <param name="grid_">The scalar grid.</param>
+/// <param name="isoValue_">The iso value. Samples greater than it are inside.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Closed rings. Outer rings are counterclockwise, holes are clockwise.</returns>
+/// <remarks>
+/// <para>
+/// Area outside the grid is treated as being below the iso value, so contours touching the grid border
+/// are closed along the border of the grid region. Saddle cells are resolved with the average of the corners.
+/// </para>
+/// <para>
+/// Rings are traced in parallel within bands of rows. Pieces crossing band seams are stitched afterwards.
+/// Points are written into flat per-band buffers, so no allocation is made per segment.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+std::vector< Contour2<TValueType> > extractContours(ScalarGrid2<TValueType> const & grid_, TValueType const isoValue_,
+													std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/Contours.inl"
\ No newline at end of file
@@ -0,0 +1,166 @@
+// File description:
+// Implements intersection and penetration tests of convex shapes: GJK with EPA, and separating axis test for small polygons.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Polygon2.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Convex shape given as the convex hull of its vertices.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The vertices need no order and may include points inside the hull, which only slow down the tests.
+/// </para>
+/// </remarks>
+template <template <typename> typename TVectorType, typename TValueType>
+struct ConvexHull
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+
+	static_assert(std::is_floating_point_v<ValueType>, "Convex hull requires floating point type");
+
+	// Methods:
+	/// <summary>
+	/// Initializes a new, empty instance of the <see cref="ConvexHull"/> struct.
+	/// </summary>
+	ConvexHull() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="ConvexHull"/> struct.
+	/// </summary>
+	/// <param name="vertices_">The vertices.</param>
+	explicit ConvexHull(std::vector<VectorType> vertices_);
+
+	std::vector<VectorType> vertices;
+};
+
+/// <summary>
+/// Result of a penetration test of two convex shapes.
+/// </summary>
+/// <remarks>
+/// <para>
+/// When the shapes intersect, moving the second shape by `normal * depth` separates them (they only touch afterwards).
+/// Otherwise depth is 0 and the normal is an axis separating the shapes, pointing from the first one to the second.
+/// </para>
+/// </remarks>
+template <template <typename> typename TVectorType, typename TValueType>
+struct Penetration
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+
+	bool		intersecting = false;
+	ValueType	depth = ValueType(0);
+	VectorType	normal;
+};
+
+/// <summary>
+/// Data kept between repeated tests of the same pair of shapes.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Tests start from the axis found by the previous test: the separating axis, or the penetration normal.
+/// Shapes move little between frames, so an axis that separated them usually still does and
+/// the test finishes after projecting both shapes on it once.
+/// A zero axis (the initial value) means there is no previous result.
+/// </para>
+/// </remarks>
+template <template <typename> typename TVectorType, typename TValueType>
+struct SeparatingAxisCache
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+
+	VectorType axis;
+};
+
+/// <summary>
+/// Determines whether two convex polygons intersect. Touching polygons intersect.
+/// </summary>
+/// <param name="first_">The first polygon.</param>
+/// <param name="second_">The second polygon.</param>
+/// <param name="cache_">Optional data of the previous test of the pair, updated by the test.</param>
+/// <returns>
+///   <c>true</c> if polygons intersect; otherwise, <c>false</c>.
+/// </returns>
+/// <remarks>
+/// <para>
+/// Polygons must be convex; their winding does not matter. Small polygons are tested on the edge normals of both
+/// (separating axis test), larger ones with GJK, whose cost grows with the number of vertices only linearly.
+/// </para>
+/// </remarks>
+template <typename V>
+bool intersects(Polygon2<V> const & first_, Polygon2<V> const & second_, SeparatingAxisCache<Vector2, V> * cache_ = nullptr);
+
+/// <summary>
+/// Determines whether two convex hulls intersect (GJK). Touching hulls intersect.
+/// </summary>
+/// <param name="first_">The first hull.</param>
+/// <param name="second_">The second hull.</param>
+/// <param name="cache_">Optional data of the previous test of the pair, updated by the test.</param>
+/// <returns>
+///   <c>true</c> if hulls intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersects(ConvexHull<T, V> const & first_, ConvexHull<T, V> const & second_, SeparatingAxisCache<T, V> * cache_ = nullptr);
+
+/// <summary>
+/// Computes penetration of two convex polygons.
+/// </summary>
+/// <param name="first_">The first polygon.</param>
+/// <param name="second_">The second polygon.</param>
+/// <param name="cache_">Optional data of the previous test of the pair, updated by the test.</param>
+/// <returns>The penetration.</returns>
+/// <remarks>
+/// <para>
+/// Small polygons use the separating axis test, whose axis of the smallest overlap gives the penetration exactly;
+/// larger ones use GJK followed by EPA, see the convex hull overload.
+/// </para>
+/// </remarks>
+template <typename V>
+Penetration<Vector2, V> computePenetration(Polygon2<V> const & first_, Polygon2<V> const & second_, SeparatingAxisCache<Vector2, V> * cache_ = nullptr);
+
+/// <summary>
+/// Computes penetration of two convex hulls.
+/// </summary>
+/// <param name="first_">The first hull.</param>
+/// <param name="second_">The second hull.</param>
+/// <param name="cache_">Optional data of the previous test of the pair, updated by the test.</param>
+/// <returns>The penetration.</returns>
+/// <remarks>
+/// <para>
+/// GJK finds whether the Minkowski difference of the hulls contains the origin; if it does, EPA expands
+/// the final simplex towards the boundary of the difference until the face closest to the origin is found.
+/// Depth is accurate to a small relative tolerance. Hulls without volume (area in 2D) touching each other
+/// report zero depth.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V>
+Penetration<T, V> computePenetration(ConvexHull<T, V> const & first_, ConvexHull<T, V> const & second_, SeparatingAxisCache<T, V> * cache_ = nullptr);
+
+template <typename TValueType>
+using ConvexHull2		= ConvexHull<Vector2, TValueType>;
+
+template <typename TValueType>
+using ConvexHull3		= ConvexHull<Vector3, TValueType>;
+
+using ConvexHull2f		= ConvexHull2<float>;
+using ConvexHull2d		= ConvexHull2<double>;
+using ConvexHull3f		= ConvexHull3<float>;
+using ConvexHull3d		= ConvexHull3<double>;
+
+}
+
+#include "Private/ConvexCollision.inl"
\ No newline at end of file
@@ -0,0 +1,78 @@
+// File description:
+// Implements Delaunay triangulation and Voronoi diagram of planar point sets.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Polygon2.hpp"
+#include "Box.hpp"
+#include "Predicates.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Delaunay triangulation stored as a half-edge structure over indices of the input points.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Half-edge `e` belongs to triangle `e / 3` and goes from point `triangles[e]` to the next point of the same triangle.
+/// </para>
+/// </remarks>
+struct DelaunayTriangulation
+{
+	static constexpr std::size_t noEdge = std::numeric_limits<std::size_t>::max();
+
+	std::vector<std::size_t> triangles;		// Three point indices per triangle, counterclockwise.
+	std::vector<std::size_t> halfEdges;		// Opposite half-edge of every half-edge, or noEdge on the convex hull.
+	std::vector<std::size_t> hull;			// Convex hull point indices, counterclockwise.
+	std::vector<std::size_t> inEdges;		// Half-edge ending at every point (hull edge for hull points), or noEdge for skipped duplicates.
+	std::vector<std::size_t> hullPositions;	// Position of every point in hull, or noEdge for points inside it and skipped duplicates.
+};
+
+/// <summary>
+/// Computes Delaunay triangulation of the points.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <returns>The triangulation. Contains no triangles when all points are collinear.</returns>
+/// <remarks>
+/// <para>
+/// Uses radial sweep (s-hull): points are sorted by distance from the seed triangle and added to the convex hull,
+/// followed by edge flips. The sweep needs this order, so there is no separate spatial (Morton) presort; the points
+/// are copied in sweep order, so that the sweep reads them from contiguous memory instead of through the index order.
+/// Runs in O(n log n). Orientation and incircle tests are exact, duplicate points are skipped.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+DelaunayTriangulation triangulateDelaunay(std::vector< Vector2<TValueType> > const & points_);
+
+/// <summary>
+/// Finds index of the point nearest to the query by walking the Delaunay graph.
+/// </summary>
+/// <param name="points_">The triangulated points.</param>
+/// <param name="triangulation_">The triangulation of the points.</param>
+/// <param name="query_">The query point.</param>
+/// <param name="startPoint_">The point to start the walk from. Result of a previous nearby query makes the walk short.</param>
+/// <returns>Index of the nearest point, or DelaunayTriangulation::noEdge if there are no points.</returns>
+template <typename TValueType>
+std::size_t findNearestSite(std::vector< Vector2<TValueType> > const & points_, DelaunayTriangulation const & triangulation_,
+							Vector2<TValueType> const & query_, std::size_t startPoint_ = 0);
+
+/// <summary>
+/// Computes Voronoi cells of the points, clipped to the specified bounds.
+/// </summary>
+/// <param name="points_">The triangulated points.</param>
+/// <param name="triangulation_">The triangulation of the points.</param>
+/// <param name="bounds_">The bounds every cell is clipped to.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Counterclockwise cell of every point. Cells of skipped duplicate points are empty.</returns>
+template <typename TValueType>
+std::vector< Polygon2<TValueType> > computeVoronoiCells(std::vector< Vector2<TValueType> > const & points_,
+														DelaunayTriangulation const & triangulation_,
+														Rect2<TValueType> const & bounds_, std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/Delaunay.inl"
\ No newline at end of file
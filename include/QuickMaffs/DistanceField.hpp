@@ -0,0 +1,64 @@
+// File description:
+// Implements signed distance field generation from polygons.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Polygon2.hpp"
+#include "Box.hpp"
+#include "ScalarGrid2.hpp"
+#include "Rasterizer.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Computes approximate signed distance field of the specified polygons sampled over a grid.
+/// The distances are never below the exact ones and exceed them by less than 2.1 times the longer side of a cell.
+/// </summary>
+/// <param name="polygons_">The polygons. Overlapping polygons are combined with even-odd rule, so a polygon placed inside another one makes a hole.</param>
+/// <param name="region_">The region covered by the grid.</param>
+/// <param name="resolution_">Number of grid cells in x and y direction.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>
+///   Grid of distances from cell centers to the nearest polygon edge,
+///   negative inside polygons and positive outside. Infinite when there are no edges.
+/// </returns>
+/// <remarks>
+/// <para>
+/// Exact distances are computed only in a one cell wide band around the edges.
+/// They are propagated to the rest of the grid with separable (Felzenszwalb-Huttenlocher) distance transform,
+/// run in parallel over cache-sized blocks of columns and then over rows.
+/// The cost is linear in the number of cells plus the length of the edges, no matter how many edges there are,
+/// unless no edge passes through the region.
+/// </para>
+/// <para>
+/// Every cell measures the edges of the seed cells around the one selected by the transform, and their neighbours
+/// along the rings. The result differs from the exact distance only where the nearest edge has no seed
+/// close to the selected one, which happens near sharp corners and crossing edges; errors are then typically
+/// below one cell. The bound holds where the nearest point of the edges lies within the region.
+/// When no edge passes through the region, every cell measures every edge and the distances are exact.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+ScalarGrid2<TValueType> computeSignedDistanceField(std::vector< Polygon2<TValueType> > const & polygons_,
+													Rect2<TValueType> const & region_, Vector2size const & resolution_,
+													std::size_t const threadCount_ = 0);
+
+/// <summary>
+/// Computes signed distance field of the specified polygon sampled over a grid.
+/// </summary>
+/// <param name="polygon_">The polygon.</param>
+/// <param name="region_">The region covered by the grid.</param>
+/// <param name="resolution_">Number of grid cells in x and y direction.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Grid of signed distances, negative inside the polygon.</returns>
+template <typename TValueType>
+ScalarGrid2<TValueType> computeSignedDistanceField(Polygon2<TValueType> const & polygon_,
+													Rect2<TValueType> const & region_, Vector2size const & resolution_,
+													std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/DistanceField.inl"
\ No newline at end of file
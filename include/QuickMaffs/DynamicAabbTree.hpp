@@ -0,0 +1,209 @@
+// File description:
+// Implements dynamic bounding volume tree for moving balls, boxes or bounds.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Aabb.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+/// <summary>
+/// Node of the dynamic bounding volume tree.
+/// </summary>
+template <typename TAabbType>
+struct DynamicAabbTreeNode
+{
+	TAabbType		bounds;			// Fattened bounds of the shape for leaves.
+	std::size_t		parent;			// Next free node for unused nodes.
+	std::size_t		children[2];	// Unused for leaves.
+	int				height;			// 0 for leaves, -1 for unused nodes.
+};
+
+}
+
+/// <summary>
+/// Dynamic bounding volume tree over moving shapes (<see cref="Ball"/>, <see cref="Box"/> or <see cref="Aabb"/>).
+/// </summary>
+/// <remarks>
+/// <para>
+/// Leaves store bounds of the shapes enlarged by a margin, so a shape moving a little stays inside them
+/// and the tree does not change. A shape leaving its fattened bounds is reinserted in O(log n):
+/// the sibling is chosen by the surface area cost and the ancestors are rebalanced by tree rotations.
+/// </para>
+/// <para>
+/// When most of the shapes move every step, update them with <c>setShape</c> and call <c>refit</c> once:
+/// it recomputes leaves in parallel, then the inner nodes level by level, without changing the topology.
+/// </para>
+/// <para>
+/// Shapes are identified by proxies returned from <c>insert</c>, stable until the shape is removed.
+/// </para>
+/// </remarks>
+template <typename TShapeType>
+class DynamicAabbTree
+{
+public:
+
+	using ShapeType		= TShapeType;
+	using ValueType		= typename ShapeType::ValueType;
+	using VectorType	= typename ShapeType::VectorType;
+	using AabbType		= decltype(computeBounds(std::declval<ShapeType>()));
+	using Node			= priv::DynamicAabbTreeNode<AabbType>;
+
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="DynamicAabbTree"/> class.
+	/// </summary>
+	/// <param name="margin_">Distance the leaf bounds are enlarged by in every direction.</param>
+	explicit DynamicAabbTree(ValueType const margin_ = ValueType(0));
+
+	/// <summary>
+	/// Inserts the shape.
+	/// </summary>
+	/// <param name="shape_">The shape.</param>
+	/// <returns>Proxy of the shape.</returns>
+	std::size_t insert(ShapeType const & shape_);
+
+	/// <summary>
+	/// Removes the shape.
+	/// </summary>
+	/// <param name="proxy_">Proxy of the shape, as returned by <c>insert</c>.</param>
+	void remove(std::size_t const proxy_);
+
+	/// <summary>
+	/// Moves the shape. The tree changes only when the shape leaves its fattened bounds
+	/// (or the fattened bounds became much larger than needed).
+	/// </summary>
+	/// <param name="proxy_">Proxy of the shape, as returned by <c>insert</c>.</param>
+	/// <param name="shape_">The shape at its new position.</param>
+	/// <param name="displacement_">Expected displacement until the next move; the new bounds are enlarged in its direction.</param>
+	/// <returns>
+	///   <c>true</c> if the shape was reinserted; otherwise, <c>false</c>.
+	/// </returns>
+	bool move(std::size_t const proxy_, ShapeType const & shape_, VectorType const & displacement_ = VectorType{});
+
+	/// <summary>
+	/// Replaces the shape without updating the tree. Call <c>refit</c> before the next query.
+	/// </summary>
+	/// <param name="proxy_">Proxy of the shape, as returned by <c>insert</c>.</param>
+	/// <param name="shape_">The shape.</param>
+	void setShape(std::size_t const proxy_, ShapeType const & shape_);
+
+	/// <summary>
+	/// Updates bounds of all the nodes after <c>setShape</c> calls. Leaves whose shapes left their fattened bounds
+	/// get new ones, inner nodes are recomputed from their children. Topology of the tree does not change.
+	/// </summary>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	void refit(std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Removes all the shapes.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Returns the shape.
+	/// </summary>
+	/// <param name="proxy_">Proxy of the shape, as returned by <c>insert</c>.</param>
+	/// <returns>The shape.</returns>
+	ShapeType const & getShape(std::size_t const proxy_) const;
+
+	/// <summary>
+	/// Returns the fattened bounds of the shape.
+	/// </summary>
+	/// <param name="proxy_">Proxy of the shape, as returned by <c>insert</c>.</param>
+	/// <returns>The fattened bounds.</returns>
+	AabbType const & getFatBounds(std::size_t const proxy_) const;
+
+	/// <summary>
+	/// Returns number of shapes.
+	/// </summary>
+	/// <returns>Number of shapes.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Returns height of the tree: 0 for a single leaf, -1 when empty.
+	/// </summary>
+	/// <returns>Height of the tree.</returns>
+	int getHeight() const;
+
+	/// <summary>
+	/// Calls the function with proxy of every shape containing the point.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	/// <param name="function_">The function, called as function_(proxy).</param>
+	template <typename TFunction>
+	void forEachContaining(VectorType const & point_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds proxies of the shapes containing the point.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	/// <returns>Proxies of the shapes, in traversal order.</returns>
+	std::vector<std::size_t> findContaining(VectorType const & point_) const;
+
+	/// <summary>
+	/// Calls the function with proxy of every shape intersecting the query shape.
+	/// </summary>
+	/// <param name="shape_">The query shape: ball, box or bounds.</param>
+	/// <param name="function_">The function, called as function_(proxy).</param>
+	template <typename TQueryShapeType, typename TFunction>
+	void forEachOverlapping(TQueryShapeType const & shape_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds proxies of the shapes intersecting the query shape.
+	/// </summary>
+	/// <param name="shape_">The query shape: ball, box or bounds.</param>
+	/// <returns>Proxies of the shapes, in traversal order.</returns>
+	template <typename TQueryShapeType>
+	std::vector<std::size_t> findOverlapping(TQueryShapeType const & shape_) const;
+
+	/// <summary>
+	/// Calls the function with proxy of every shape the ray intersects.
+	/// </summary>
+	/// <param name="origin_">The ray origin.</param>
+	/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+	/// <param name="function_">The function, called as function_(proxy).</param>
+	template <typename TFunction>
+	void forEachIntersectingRay(VectorType const & origin_, VectorType const & direction_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds proxies of the shapes the ray intersects.
+	/// </summary>
+	/// <param name="origin_">The ray origin.</param>
+	/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+	/// <returns>Proxies of the shapes, in traversal order.</returns>
+	std::vector<std::size_t> findIntersectingRay(VectorType const & origin_, VectorType const & direction_) const;
+
+private:
+	std::size_t allocateNode();
+	void freeNode(std::size_t const index_);
+
+	AabbType fatten(AabbType const & bounds_, VectorType const & displacement_) const;
+
+	void insertLeaf(std::size_t const leaf_);
+	void removeLeaf(std::size_t const leaf_);
+	void updateAncestors(std::size_t index_);
+	std::size_t balance(std::size_t const index_);
+
+	template <typename TPredicate, typename TFunction>
+	void traverse(TPredicate && predicate_, TFunction && function_) const;
+
+	std::vector<Node>		m_nodes;
+	std::vector<ShapeType>	m_shapes;			// Indexed by node, valid for leaves.
+	std::size_t				m_root = npos;
+	std::size_t				m_freeList = npos;
+	std::size_t				m_size = 0;
+	ValueType				m_margin;
+};
+
+}
+
+#include "Private/DynamicAabbTree.inl"
\ No newline at end of file
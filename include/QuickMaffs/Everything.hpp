@@ -9,9 +9,44 @@
 #include "Vector2.hpp"
 #include "Vector3.hpp"
 #include "VectorStringBuilder.hpp"
+#include "Predicates.hpp"
 
 // Shapes:
 #include "Polygon2.hpp"
 #include "Ball.hpp"
 #include "Box.hpp"
-#include "ShapeAlgorithms.hpp"
\ No newline at end of file
+#include "Aabb.hpp"
+#include "ShapeArrays.hpp"
+#include "ShapeAlgorithms.hpp"
+#include "Ray.hpp"
+#include "TriangleMesh.hpp"
+#include "BoundingVolumes.hpp"
+#include "OrientedBox.hpp"
+#include "Frustum.hpp"
+#include "ContinuousCollision.hpp"
+#include "ConvexCollision.hpp"
+
+// Grids:
+#include "ScalarGrid2.hpp"
+#include "DistanceField.hpp"
+#include "Rasterizer.hpp"
+#include "Contours.hpp"
+
+// Triangulation:
+#include "Delaunay.hpp"
+
+// Spatial structures:
+#include "BoundingVolumeHierarchy.hpp"
+#include "DynamicAabbTree.hpp"
+#include "SpatialHashGrid.hpp"
+#include "SweepAndPrune.hpp"
+#include "LinearTree.hpp"
+#include "NearestNeighbors.hpp"
+#include "KdTree.hpp"
+
+// Clustering:
+#include "KMeans.hpp"
+
+// Simulation:
+#include "ParticleSystem.hpp"
+#include "NBody.hpp"
\ No newline at end of file
@@ -0,0 +1,214 @@
+// File description:
+// Implements planes and view frustums in 3D and culling of ball and box arrays against them.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector3.hpp"
+#include "Ball.hpp"
+#include "Box.hpp"
+#include "ShapeArrays.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// A plane in 3D: points `p` with `normal.dot(p) + distance == 0`.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Points with positive signed distance are in front of the plane (on the side the normal points to).
+/// Signed distances are Euclidean only when the normal has unit length, see <see cref="normalize"/>.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+struct Plane3
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= Vector3<ValueType>;
+
+	static_assert(std::is_floating_point_v<ValueType>, "Plane requires floating point type");
+
+	// Methods:
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Plane3"/> struct: plane z = 0 facing +z.
+	/// </summary>
+	constexpr Plane3();
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Plane3"/> struct.
+	/// </summary>
+	/// <param name="normal_">The normal.</param>
+	/// <param name="distance_">The offset: negated signed distance of the origin along the normal.</param>
+	constexpr Plane3(VectorType const & normal_, ValueType const distance_);
+
+	/// <summary>
+	/// Creates plane through the point.
+	/// </summary>
+	/// <param name="point_">The point on the plane.</param>
+	/// <param name="normal_">The normal.</param>
+	/// <returns>The plane.</returns>
+	constexpr static Plane3 fromPointNormal(VectorType const & point_, VectorType const & normal_);
+
+	/// <summary>
+	/// Creates plane through three points, facing the side from which they appear counterclockwise.
+	/// </summary>
+	/// <param name="first_">The first point.</param>
+	/// <param name="second_">The second point.</param>
+	/// <param name="third_">The third point.</param>
+	/// <returns>The plane with unit normal.</returns>
+	static Plane3 fromPoints(VectorType const & first_, VectorType const & second_, VectorType const & third_);
+
+	/// <summary>
+	/// Computes signed distance of the point (scaled by length of the normal).
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	/// <returns>Positive in front of the plane, negative behind it.</returns>
+	constexpr ValueType signedDistance(VectorType const & point_) const;
+
+	/// <summary>
+	/// Returns the same plane with unit normal.
+	/// </summary>
+	/// <returns>The normalized plane.</returns>
+	Plane3 normalize() const;
+
+	VectorType	normal;
+	ValueType	distance;
+};
+
+/// <summary>
+/// A convex view volume bounded by six planes whose normals point inside.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Culling tests treat a shape as visible unless it lies entirely behind one of the planes. This is exact for
+/// points but conservative for shapes: one close to an edge or a corner of the frustum may be reported
+/// as visible even though it is outside. Plane normals must have unit length for balls to be tested correctly.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+struct Frustum3
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= Vector3<ValueType>;
+	using PlaneType		= Plane3<ValueType>;
+
+	static constexpr std::size_t PlaneCount = 6;
+
+	// Methods:
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Frustum3"/> struct: all planes equal to default plane.
+	/// </summary>
+	constexpr Frustum3() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Frustum3"/> struct.
+	/// </summary>
+	/// <param name="planes_">The planes, normals pointing inside.</param>
+	constexpr explicit Frustum3(std::array<PlaneType, PlaneCount> const & planes_);
+
+	/// <summary>
+	/// Creates frustum of a perspective camera.
+	/// </summary>
+	/// <param name="eye_">Position of the camera.</param>
+	/// <param name="forward_">The view direction.</param>
+	/// <param name="up_">The up direction; must not be parallel to the view direction.</param>
+	/// <param name="verticalFieldOfView_">Vertical field of view, in radians.</param>
+	/// <param name="aspectRatio_">Width divided by height.</param>
+	/// <param name="nearDistance_">Distance of the near plane.</param>
+	/// <param name="farDistance_">Distance of the far plane.</param>
+	/// <returns>The frustum with unit plane normals, in order left, right, bottom, top, near, far.</returns>
+	static Frustum3 fromPerspective(VectorType const & eye_, VectorType const & forward_, VectorType const & up_,
+									ValueType const verticalFieldOfView_, ValueType const aspectRatio_,
+									ValueType const nearDistance_, ValueType const farDistance_);
+
+	/// <summary>
+	/// Returns the same frustum with unit plane normals.
+	/// </summary>
+	/// <returns>The normalized frustum.</returns>
+	Frustum3 normalize() const;
+
+	std::array<PlaneType, PlaneCount> planes;
+};
+
+/// <summary>
+/// Determines whether the point is inside the frustum, boundary included.
+/// </summary>
+/// <param name="frustum_">The frustum.</param>
+/// <param name="point_">The point.</param>
+/// <returns>
+///   <c>true</c> if the point is inside; otherwise, <c>false</c>.
+/// </returns>
+template <typename V>
+bool contains(Frustum3<V> const & frustum_, Vector3<V> const & point_);
+
+/// <summary>
+/// Determines whether the ball is not entirely behind any plane of the frustum.
+/// </summary>
+/// <param name="frustum_">The frustum.</param>
+/// <param name="ball_">The ball.</param>
+/// <returns>
+///   <c>true</c> if the ball may be visible; otherwise, <c>false</c>.
+/// </returns>
+template <typename V>
+bool intersects(Frustum3<V> const & frustum_, Sphere3<V> const & ball_);
+
+/// <summary>
+/// Determines whether the box is not entirely behind any plane of the frustum.
+/// </summary>
+/// <param name="frustum_">The frustum.</param>
+/// <param name="box_">The box.</param>
+/// <returns>
+///   <c>true</c> if the box may be visible; otherwise, <c>false</c>.
+/// </returns>
+template <typename V>
+bool intersects(Frustum3<V> const & frustum_, Cuboid3<V> const & box_);
+
+/// <summary>
+/// Finds the balls of the array that may be visible in the frustum.
+/// </summary>
+/// <param name="frustum_">The frustum.</param>
+/// <param name="balls_">The balls.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Indices of the balls for which <see cref="intersects"/> returns <c>true</c>, in ascending order.</returns>
+/// <remarks>
+/// <para>
+/// Balls are processed in blocks: every plane is tested against the whole block in a branch free loop,
+/// which the compiler vectorizes, and the remaining planes are skipped once no ball of the block is left.
+/// Indices of the remaining balls are then written without branches. Chunks of the array are culled
+/// on worker threads and their results are joined in order.
+/// </para>
+/// </remarks>
+template <typename V>
+std::vector<std::uint32_t> findVisible(Frustum3<V> const & frustum_, Sphere3Array<V> const & balls_, std::size_t const threadCount_ = 0);
+
+/// <summary>
+/// Finds the boxes of the array that may be visible in the frustum.
+/// </summary>
+/// <param name="frustum_">The frustum.</param>
+/// <param name="boxes_">The boxes.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Indices of the boxes for which <see cref="intersects"/> returns <c>true</c>, in ascending order.</returns>
+/// <remarks>
+/// <para>
+/// Works like the ball overload; a box is tested as a ball whose radius is the projection of its half extent on the plane normal.
+/// </para>
+/// </remarks>
+template <typename V>
+std::vector<std::uint32_t> findVisible(Frustum3<V> const & frustum_, Cuboid3Array<V> const & boxes_, std::size_t const threadCount_ = 0);
+
+using Plane3f		= Plane3<float>;
+using Plane3d		= Plane3<double>;
+using Plane3ld		= Plane3<long double>;
+
+using Frustum3f		= Frustum3<float>;
+using Frustum3d		= Frustum3<double>;
+using Frustum3ld	= Frustum3<long double>;
+
+}
+
+#include "Private/Frustum.inl"
\ No newline at end of file
@@ -0,0 +1,110 @@
+// File description:
+// Implements k-means clustering of structure-of-arrays point sets: k-means++ seeding and parallel Lloyd iterations.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Random.hpp"
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "ShapeArrays.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Skipping of distance computations the assignment step can prove useless.
+/// </summary>
+enum class KMeansPruning
+{
+	None,		// Every point is compared with every centroid, in vectorized blocks.
+	Hamerly		// Per point bounds from the triangle inequality skip the points whose centroid cannot change.
+};
+
+/// <summary>
+/// Parameters of <see cref="computeKMeans"/>.
+/// </summary>
+template <typename TValueType>
+struct KMeansSettings
+{
+	std::size_t		maxIterations	= 100;						// Upper limit of assignment steps.
+	TValueType		tolerance		= TValueType(0);			// Stops when no centroid moves farther than this.
+	KMeansPruning	pruning			= KMeansPruning::None;
+};
+
+/// <summary>
+/// Clusters found by <see cref="computeKMeans"/>.
+/// </summary>
+template <template <typename> typename TVectorType, typename TValueType>
+struct KMeansResult
+{
+	std::vector< TVectorType<TValueType> >	centroids;		// Mean of the points of every cluster.
+	std::vector<std::uint32_t>				assignments;	// Cluster of every point: index of its nearest centroid.
+	TValueType								inertia;		// Sum of squared distances of the points from their centroids.
+	std::size_t								iterations;		// Number of assignment steps done.
+	bool									converged;		// Whether the clusters settled before the iteration limit.
+};
+
+/// <summary>
+/// Chooses initial centroids by k-means++: every next one is a point drawn with probability proportional
+/// to the squared distance from the nearest centroid chosen so far.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="k_">Number of centroids.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>The centroids.</returns>
+/// <remarks>
+/// <para>
+/// Draws from the generator of the <c>random</c> module on the calling thread; distances are updated in parallel.
+/// Throws std::invalid_argument unless 1 &lt;= k_ &lt;= points_.size().
+/// </para>
+/// </remarks>
+template <template <typename> typename T, typename V>
+std::vector< T<V> > seedKMeans(PointArray<T, V> const & points_, std::size_t const k_, std::size_t const threadCount_ = 0);
+
+/// <summary>
+/// Clusters the points by Lloyd's algorithm starting from the centroids.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="centroids_">Initial centroids; their count is the number of clusters.</param>
+/// <param name="settings_">The settings.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>The clusters.</returns>
+/// <remarks>
+/// <para>
+/// Every step assigns each point to its nearest centroid and moves the centroids to the means of their points, until
+/// no assignment changes, no centroid moves farther than the tolerance, or the iteration limit. Points are split
+/// among worker threads; each thread sums the points of every cluster into its own buffer, and the buffers are
+/// added in a fixed order, so results do not depend on timing. A cluster left without points keeps its centroid.
+/// </para>
+/// <para>
+/// Without pruning, distances of a block of points to one centroid after another are computed component by component
+/// over the contiguous arrays, in a loop the compiler vectorizes. Hamerly pruning keeps an upper bound of the distance
+/// to the assigned centroid and a lower bound of the distance to any other one; a point whose bounds are separated,
+/// or whose upper bound is below half the distance from its centroid to the nearest other centroid, is skipped.
+/// It pays off for well separated clusters and k of about ten or more, and costs two values of memory per point.
+/// </para>
+/// <para>
+/// Throws std::invalid_argument unless 1 &lt;= k &lt;= points_.size(), std::length_error for 2^32 points or more.
+/// </para>
+/// </remarks>
+template <template <typename> typename T, typename V>
+KMeansResult<T, V> computeKMeans(PointArray<T, V> const & points_, std::vector< T<V> > centroids_,
+								 KMeansSettings<V> const & settings_ = KMeansSettings<V>{}, std::size_t const threadCount_ = 0);
+
+/// <summary>
+/// Clusters the points by Lloyd's algorithm starting from centroids chosen by <see cref="seedKMeans"/>.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="k_">Number of clusters.</param>
+/// <param name="settings_">The settings.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>The clusters.</returns>
+template <template <typename> typename T, typename V>
+KMeansResult<T, V> computeKMeans(PointArray<T, V> const & points_, std::size_t const k_,
+								 KMeansSettings<V> const & settings_ = KMeansSettings<V>{}, std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/KMeans.inl"
\ No newline at end of file
@@ -0,0 +1,155 @@
+// File description:
+// Implements implicit k-d tree with nearest neighbor and radius search over point sets.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "NearestNeighbors.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Implicit k-d tree over a point set.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The points are reordered so that the tree needs no nodes: a range of the array is a subtree, its median
+/// element is the splitting point and the halves before and after it are the children. Only the split axis
+/// of every median is stored. Ranges of at most a few points are leaves, scanned linearly.
+/// </para>
+/// <para>
+/// Built with <c>std::nth_element</c> along the axis of the largest extent; the top levels are split on the calling
+/// thread and the subtrees below them are built in parallel. Queries do not modify the tree, so any number
+/// of threads can run them at once; the batched ones split the queries among worker threads.
+/// For small point sets, the brute force <see cref="findNearestNeighbors"/> is faster.
+/// </para>
+/// </remarks>
+template <template <typename> class TVectorType, typename TValueType>
+class KdTree
+{
+public:
+
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using NeighborType	= Neighbor<ValueType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="KdTree"/> class.
+	/// </summary>
+	KdTree() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="KdTree"/> class.
+	/// </summary>
+	/// <param name="points_">The points.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	explicit KdTree(std::vector<VectorType> points_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Rebuilds the tree over the points.
+	/// </summary>
+	/// <param name="points_">The points.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	void build(std::vector<VectorType> points_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Returns number of points.
+	/// </summary>
+	/// <returns>Number of points.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Returns the points in tree order.
+	/// </summary>
+	/// <returns>The points in tree order.</returns>
+	std::vector<VectorType> const & getPoints() const;
+
+	/// <summary>
+	/// Returns original index of every point in tree order.
+	/// </summary>
+	/// <returns>Original indices of the points.</returns>
+	std::vector<std::uint32_t> const & getPointIndices() const;
+
+	/// <summary>
+	/// Finds the nearest point.
+	/// </summary>
+	/// <param name="query_">The query point.</param>
+	/// <returns>The nearest point; index is npos when the tree is empty.</returns>
+	NeighborType findNearest(VectorType const & query_) const;
+
+	/// <summary>
+	/// Finds the k nearest points.
+	/// </summary>
+	/// <param name="query_">The query point.</param>
+	/// <param name="k_">Number of points to find.</param>
+	/// <returns>min(k_, size()) nearest points, nearest first.</returns>
+	std::vector<NeighborType> findNearest(VectorType const & query_, std::size_t const k_) const;
+
+	/// <summary>
+	/// Finds the k nearest points of every query point, in parallel.
+	/// </summary>
+	/// <param name="queries_">The query points.</param>
+	/// <param name="k_">Number of points to find per query.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <returns>
+	/// k_ neighbors per query, nearest first: neighbors of query i start at i * k_.
+	/// When there are fewer points than k_, the rest has index npos and maximum distance.
+	/// </returns>
+	std::vector<NeighborType> findNearest(std::vector<VectorType> const & queries_, std::size_t const k_, std::size_t const threadCount_ = 0) const;
+
+	/// <summary>
+	/// Calls the function with every point within the radius (boundary included).
+	/// </summary>
+	/// <param name="center_">The query point.</param>
+	/// <param name="radius_">The radius.</param>
+	/// <param name="function_">The function, called as function_(index, distanceSquared).</param>
+	template <typename TFunction>
+	void forEachInRadius(VectorType const & center_, ValueType const radius_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds the points within the radius (boundary included).
+	/// </summary>
+	/// <param name="center_">The query point.</param>
+	/// <param name="radius_">The radius.</param>
+	/// <returns>Indices of the points, in tree order.</returns>
+	std::vector<std::size_t> findInRadius(VectorType const & center_, ValueType const radius_) const;
+
+	/// <summary>
+	/// Finds the points within the radius of every query point, in parallel.
+	/// </summary>
+	/// <param name="centers_">The query points.</param>
+	/// <param name="radius_">The radius.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <returns>Indices of the points, per query.</returns>
+	std::vector< std::vector<std::size_t> > findInRadius(std::vector<VectorType> const & centers_, ValueType const radius_,
+														std::size_t const threadCount_ = 0) const;
+
+private:
+	void searchNearest(VectorType const & query_, std::size_t const k_, std::vector<NeighborType> & heap_) const;
+
+	std::vector<VectorType>		m_points;
+	std::vector<std::uint32_t>	m_pointIndices;
+	std::vector<std::uint8_t>	m_splitAxes;		// Split axis of the subtree whose median is the point.
+};
+
+template <typename TValueType>
+using KdTree2		= KdTree<Vector2, TValueType>;
+
+template <typename TValueType>
+using KdTree3		= KdTree<Vector3, TValueType>;
+
+using KdTree2f		= KdTree2<float>;
+using KdTree2d		= KdTree2<double>;
+using KdTree3f		= KdTree3<float>;
+using KdTree3d		= KdTree3<double>;
+
+}
+
+#include "Private/KdTree.inl"
\ No newline at end of file
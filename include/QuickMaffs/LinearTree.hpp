@@ -0,0 +1,139 @@
+// File description:
+// Implements pointerless quadtree and octree over point sets, ordered by Morton keys.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Aabb.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+/// <summary>
+/// Node of the linear tree. Children of a node are stored next to each other.
+/// </summary>
+template <typename TAabbType>
+struct LinearTreeNode
+{
+	TAabbType		bounds;			// Tight bounds of the points of the node.
+	std::uint32_t	begin, end;		// Range of the points in Morton order.
+	std::uint32_t	firstChild;		// Index of the first child.
+	std::uint32_t	childCount;		// Number of non-empty children, 0 for leaves.
+};
+
+}
+
+/// <summary>
+/// Quadtree (2D) or octree (3D) over a point set without child pointers: points are sorted by their Morton keys,
+/// so every cell of the tree covers a contiguous range of them.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Points are quantized to a grid over their bounds (31 bits per axis in 2D, 21 in 3D), the keys are sorted
+/// by parallel radix sort and the nodes are built level by level, each level in parallel.
+/// Nodes and points are stored contiguously; children of a node are adjacent.
+/// </para>
+/// <para>
+/// Queries report indices of the points as passed to <c>build</c>.
+/// </para>
+/// </remarks>
+template <template <typename> class TVectorType, typename TValueType>
+class LinearTree
+{
+public:
+
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using AabbType		= Aabb<TVectorType, TValueType>;
+	using Node			= priv::LinearTreeNode<AabbType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+	static constexpr std::size_t Levels = 63 / Dimensions;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="LinearTree"/> class.
+	/// </summary>
+	LinearTree() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="LinearTree"/> class.
+	/// </summary>
+	/// <param name="points_">The points.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	explicit LinearTree(std::vector<VectorType> points_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Rebuilds the tree over the points.
+	/// </summary>
+	/// <param name="points_">The points.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	void build(std::vector<VectorType> points_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Returns number of points.
+	/// </summary>
+	/// <returns>Number of points.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Returns the nodes. The root is the first one.
+	/// </summary>
+	/// <returns>The nodes.</returns>
+	std::vector<Node> const & getNodes() const;
+
+	/// <summary>
+	/// Returns the points in Morton order.
+	/// </summary>
+	/// <returns>The points in Morton order.</returns>
+	std::vector<VectorType> const & getPoints() const;
+
+	/// <summary>
+	/// Returns original index of every point in Morton order.
+	/// </summary>
+	/// <returns>Original indices of the points.</returns>
+	std::vector<std::uint32_t> const & getPointIndices() const;
+
+	/// <summary>
+	/// Calls the function with index of every point inside the shape: range query for <see cref="Box"/> or
+	/// <see cref="Aabb"/>, radius query for <see cref="Ball"/>. Points are tested with <c>isPointInside</c>.
+	/// </summary>
+	/// <param name="shape_">The query shape.</param>
+	/// <param name="function_">The function, called as function_(index).</param>
+	template <typename TQueryShapeType, typename TFunction>
+	void forEachInside(TQueryShapeType const & shape_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds indices of the points inside the shape, see <see cref="forEachInside"/>.
+	/// </summary>
+	/// <param name="shape_">The query shape.</param>
+	/// <returns>Indices of the points, in Morton order.</returns>
+	template <typename TQueryShapeType>
+	std::vector<std::size_t> findInside(TQueryShapeType const & shape_) const;
+
+private:
+	std::vector<Node>			m_nodes;
+	std::vector<VectorType>		m_points;
+	std::vector<std::uint32_t>	m_pointIndices;
+};
+
+template <typename TValueType>
+using Quadtree2		= LinearTree<Vector2, TValueType>;
+
+template <typename TValueType>
+using Octree3		= LinearTree<Vector3, TValueType>;
+
+using Quadtree2f	= Quadtree2<float>;
+using Quadtree2d	= Quadtree2<double>;
+using Octree3f		= Octree3<float>;
+using Octree3d		= Octree3<double>;
+
+}
+
+#include "Private/LinearTree.inl"
\ No newline at end of file
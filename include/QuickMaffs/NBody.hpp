@@ -0,0 +1,146 @@
+// File description:
+// Implements gravitational N-body accelerations: direct summation and Barnes-Hut approximation over an octree.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector3.hpp"
+#include "ShapeArrays.hpp"
+#include "LinearTree.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Parameters of gravitational acceleration: body j accelerates point p by
+/// `G * m_j * (x_j - p) / (|x_j - p|^2 + softening^2)^(3/2)`.
+/// </summary>
+template <typename TValueType>
+struct GravitySettings
+{
+	TValueType	gravitationalConstant	= TValueType(1);	// G in the units of positions, masses and time.
+	TValueType	softening				= TValueType(0);	// Plummer softening length, limits acceleration of close bodies.
+	TValueType	openingAngle			= TValueType(0.5);	// Barnes-Hut accuracy: cells smaller than this times their distance are point masses; 0 is exact.
+};
+
+/// <summary>
+/// Computes acceleration of every body caused by all the others, by direct summation.
+/// </summary>
+/// <param name="positions_">Positions of the bodies.</param>
+/// <param name="masses_">Masses of the bodies.</param>
+/// <param name="settings_">The settings; opening angle is not used.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Acceleration of every body.</returns>
+/// <remarks>
+/// <para>
+/// Exact up to rounding, O(n^2). Serves as reference of <see cref="BarnesHutTree3"/> and is faster than it for up to
+/// a few thousand bodies. A tile of bodies is kept in per-lane accumulators while all bodies act on it one by one,
+/// so the loop over the tile vectorizes; tiles are processed on worker threads.
+/// Coincident bodies do not act on each other. Throws std::invalid_argument when mass count differs from body count.
+/// </para>
+/// </remarks>
+template <typename V>
+std::vector< Vector3<V> > computeGravityDirect(Point3Array<V> const & positions_, std::vector<V> const & masses_,
+											   GravitySettings<V> const & settings_ = GravitySettings<V>{}, std::size_t const threadCount_ = 0);
+
+/// <summary>
+/// Octree of bodies with masses, approximating gravity of distant groups of bodies by their total mass (Barnes-Hut).
+/// </summary>
+/// <remarks>
+/// <para>
+/// Built as <see cref="Octree3"/> (parallel radix sort of Morton keys, levels built in parallel); total mass and center
+/// of mass of the cells are then accumulated from the deepest level up, each level in parallel.
+/// </para>
+/// <para>
+/// A cell acts as a point mass at its center of mass when the longest side of its tight bounds is smaller than
+/// opening angle times the distance to the center of mass, and it does not contain the point. Other cells are opened;
+/// bodies of opened leaves act one by one. Acceleration of all bodies costs O(n log n); typical opening angles
+/// of 0.3 - 0.5 give mean relative errors of about 0.3 - 1%.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+class BarnesHutTree3
+{
+public:
+
+	using ValueType		= TValueType;
+	using VectorType	= Vector3<ValueType>;
+	using TreeType		= Octree3<ValueType>;
+	using SettingsType	= GravitySettings<ValueType>;
+
+	static_assert(std::is_floating_point_v<ValueType>, "Barnes-Hut tree requires floating point type");
+
+	/// <summary>
+	/// Initializes a new, empty instance of the <see cref="BarnesHutTree3"/> class.
+	/// </summary>
+	BarnesHutTree3() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="BarnesHutTree3"/> class.
+	/// </summary>
+	/// <param name="positions_">Positions of the bodies.</param>
+	/// <param name="masses_">Masses of the bodies.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	BarnesHutTree3(std::vector<VectorType> positions_, std::vector<ValueType> const & masses_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Rebuilds the tree over the bodies.
+	/// </summary>
+	/// <param name="positions_">Positions of the bodies.</param>
+	/// <param name="masses_">Masses of the bodies.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <remarks>
+	/// <para>
+	/// Throws std::invalid_argument when mass count differs from body count.
+	/// </para>
+	/// </remarks>
+	void build(std::vector<VectorType> positions_, std::vector<ValueType> const & masses_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Returns number of bodies.
+	/// </summary>
+	/// <returns>Number of bodies.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Returns the octree; its points are the bodies in Morton order.
+	/// </summary>
+	/// <returns>The octree.</returns>
+	TreeType const & getTree() const;
+
+	/// <summary>
+	/// Computes acceleration caused by the bodies at the point. Bodies at the point do not act on it.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	/// <param name="settings_">The settings.</param>
+	/// <returns>The acceleration.</returns>
+	VectorType computeAcceleration(VectorType const & point_, SettingsType const & settings_ = SettingsType{}) const;
+
+	/// <summary>
+	/// Computes acceleration of every body caused by all the others, in parallel.
+	/// </summary>
+	/// <param name="settings_">The settings.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <returns>Acceleration of every body, in the order the bodies were passed to <c>build</c>.</returns>
+	std::vector<VectorType> computeAccelerations(SettingsType const & settings_ = SettingsType{}, std::size_t const threadCount_ = 0) const;
+
+private:
+	struct Cell
+	{
+		VectorType	centerOfMass;
+		ValueType	mass;
+		ValueType	size;			// Longest side of the tight bounds.
+	};
+
+	TreeType					m_tree;
+	std::vector<ValueType>		m_masses;		// Masses in Morton order.
+	std::vector<Cell>			m_cells;		// Mass distribution of every node of the tree.
+};
+
+using BarnesHutTree3f	= BarnesHutTree3<float>;
+using BarnesHutTree3d	= BarnesHutTree3<double>;
+
+}
+
+#include "Private/NBody.inl"
\ No newline at end of file
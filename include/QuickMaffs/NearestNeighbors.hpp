@@ -0,0 +1,60 @@
+// File description:
+// Implements brute force nearest neighbor search over structure-of-arrays point sets.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "ShapeArrays.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Point found by a nearest neighbor search.
+/// </summary>
+template <typename TValueType>
+struct Neighbor
+{
+	std::size_t	index;				// Index of the point.
+	TValueType	distanceSquared;	// Squared distance from the query point.
+};
+
+/// <summary>
+/// Finds the k nearest points of the query point by computing distances to all of them.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="query_">The query point.</param>
+/// <param name="k_">Number of points to find.</param>
+/// <returns>min(k_, points_.size()) nearest points, nearest first.</returns>
+template <template <typename> typename T, typename V>
+std::vector< Neighbor<V> > findNearestNeighbors(PointArray<T, V> const & points_, T<V> const & query_, std::size_t const k_);
+
+/// <summary>
+/// Finds the k nearest points of every query point by computing distances to all of them.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="queries_">The query points.</param>
+/// <param name="k_">Number of points to find per query.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>
+/// k_ neighbors per query, nearest first: neighbors of query i start at i * k_.
+/// When there are fewer points than k_, the rest has index <c>std::numeric_limits&lt;std::size_t&gt;::max()</c> and maximum distance.
+/// </returns>
+/// <remarks>
+/// <para>
+/// Queries are processed in tiles against blocks of points, so a block stays in cache while all the queries
+/// of the tile use it. Distances of a block are computed component by component over the contiguous arrays,
+/// in a loop the compiler vectorizes; only distances below the current k-th one reach the per-query heap.
+/// Below some tens of thousands of points this is faster than building and querying a <see cref="KdTree"/>.
+/// </para>
+/// </remarks>
+template <template <typename> typename T, typename V>
+std::vector< Neighbor<V> > findNearestNeighbors(PointArray<T, V> const & points_, std::vector< T<V> > const & queries_,
+												std::size_t const k_, std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/NearestNeighbors.inl"
\ No newline at end of file
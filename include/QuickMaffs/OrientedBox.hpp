@@ -0,0 +1,171 @@
+// File description:
+// Implements oriented box (box with arbitrary orthonormal axes), its fitting to point sets and separating axis tests.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Ball.hpp"
+#include "Box.hpp"
+#include "Aabb.hpp"
+#include "ShapeAlgorithms.hpp"
+#include "BoundingVolumes.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// A box with arbitrary orientation: center, orthonormal axes and half extent along every axis.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Point `center + sum(t_k * axes[k])` is inside when `|t_k| <= halfExtent[k]` for every k.
+/// Axes must be unit length and perpendicular to each other; tests do not normalize them.
+/// </para>
+/// </remarks>
+template <template <typename> typename TVectorType, typename TValueType>
+struct OrientedBox
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using BoxType		= Box<TVectorType, ValueType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	static_assert(std::is_floating_point_v<ValueType>, "Oriented box requires floating point type");
+
+	// Methods:
+	/// <summary>
+	/// Initializes a new instance of the <see cref="OrientedBox"/> struct: zero box aligned with coordinate axes.
+	/// </summary>
+	constexpr OrientedBox();
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="OrientedBox"/> struct.
+	/// </summary>
+	/// <param name="center_">The center.</param>
+	/// <param name="axes_">The orthonormal axes.</param>
+	/// <param name="halfExtent_">Half extent along every axis.</param>
+	constexpr OrientedBox(VectorType const & center_, std::array<VectorType, Dimensions> const & axes_, VectorType const & halfExtent_);
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="OrientedBox"/> struct from an axis aligned box.
+	/// </summary>
+	/// <param name="box_">The box.</param>
+	constexpr explicit OrientedBox(BoxType const & box_);
+
+	VectorType							center;
+	std::array<VectorType, Dimensions>	axes;
+	VectorType							halfExtent;
+};
+
+/// <summary>
+/// Fits an oriented box to the points: axes are the principal components of the points.
+/// </summary>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Box along the principal axes containing all points; a zero box when there are no points.</returns>
+/// <remarks>
+/// <para>
+/// The covariance matrix is accumulated in a single parallel pass (sums of coordinates and their products,
+/// relative to the first point to limit cancellation). Its eigenvectors, found with Jacobi rotations,
+/// become the axes. A second parallel pass projects the points on the axes to find the extents.
+/// </para>
+/// <para>
+/// Principal axes give a good, but not the smallest, box. In 3D, axes form a right-handed basis.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V>
+OrientedBox<T, V> computeOrientedBoundingBox(T<V> const * points_, std::size_t const count_, std::size_t const threadCount_ = 0);
+
+/// <summary>
+/// Determines whether two oriented boxes intersect (separating axis test). Touching boxes intersect.
+/// </summary>
+/// <param name="lhs_">The first box.</param>
+/// <param name="rhs_">The second box.</param>
+/// <returns>
+///   <c>true</c> if boxes intersect; otherwise, <c>false</c>.
+/// </returns>
+/// <remarks>
+/// <para>
+/// Tests face normals of both boxes and, in 3D, the nine cross products of their axes.
+/// Cross products of nearly parallel axes are guarded by a small tolerance, which may report
+/// boxes within rounding distance as intersecting.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V>
+bool intersects(OrientedBox<T, V> const & lhs_, OrientedBox<T, V> const & rhs_);
+
+/// <summary>
+/// Determines whether an oriented box and a box intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="orientedBox_">The oriented box.</param>
+/// <param name="box_">The box.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersects(OrientedBox<T, V> const & orientedBox_, Box<T, V> const & box_);
+
+/// <summary>
+/// Determines whether a box and an oriented box intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <param name="orientedBox_">The oriented box.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersects(Box<T, V> const & box_, OrientedBox<T, V> const & orientedBox_);
+
+/// <summary>
+/// Determines whether an oriented box and a ball intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="orientedBox_">The oriented box.</param>
+/// <param name="ball_">The ball.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersects(OrientedBox<T, V> const & orientedBox_, Ball<T, V> const & ball_);
+
+/// <summary>
+/// Determines whether a ball and an oriented box intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="orientedBox_">The oriented box.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersects(Ball<T, V> const & ball_, OrientedBox<T, V> const & orientedBox_);
+
+/// <summary>
+/// Computes axis aligned bounds of the oriented box.
+/// </summary>
+/// <param name="orientedBox_">The oriented box.</param>
+/// <returns>The bounds.</returns>
+template <template<typename> typename T, typename V>
+Aabb<T, V> computeBounds(OrientedBox<T, V> const & orientedBox_);
+
+template <typename TValueType>
+using OrientedBox2 = OrientedBox<Vector2, TValueType>;
+
+template <typename TValueType>
+using OrientedBox3 = OrientedBox<Vector3, TValueType>;
+
+using OrientedBox2f		= OrientedBox2<float>;
+using OrientedBox2d		= OrientedBox2<double>;
+using OrientedBox2ld	= OrientedBox2<long double>;
+
+using OrientedBox3f		= OrientedBox3<float>;
+using OrientedBox3d		= OrientedBox3<double>;
+using OrientedBox3ld	= OrientedBox3<long double>;
+
+}
+
+#include "Private/OrientedBox.inl"
\ No newline at end of file
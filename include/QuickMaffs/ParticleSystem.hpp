@@ -0,0 +1,207 @@
+// File description:
+// Implements particle system stored as structure of arrays, with integration and collisions against balls and boxes.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Ball.hpp"
+#include "Box.hpp"
+#include "ShapeArrays.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Specifies how particle positions and velocities are advanced in time.
+/// </summary>
+enum class ParticleIntegrator
+{
+	SemiImplicitEuler,	// Velocity first, then position with the new velocity: v += a * dt, x += v * dt.
+	VelocityVerlet		// Position with the old velocity and the acceleration: x += v * dt + a * dt^2 / 2, v += a * dt.
+};
+
+/// <summary>
+/// Particles moving under constant acceleration and bouncing off obstacles.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Positions and velocities are stored as structure of arrays. A step processes the particles in blocks small enough
+/// to stay in the first level cache: a block is integrated and then collided with every obstacle and the container
+/// before the next one is loaded. All loops run over the components without branches, so the compiler vectorizes
+/// them, and chunks of particles are stepped on worker threads.
+/// </para>
+/// <para>
+/// A particle found inside an obstacle (or outside the container) is moved to the closest point of its surface
+/// and its velocity is reflected about the surface normal, as <c>reflect</c> of the vector types does, with the normal
+/// component scaled by the restitution. Collisions are detected at the end of the step only, so particles moving
+/// farther than the thickness of an obstacle during a step can pass through it.
+/// </para>
+/// </remarks>
+template <template <typename> class TVectorType, typename TValueType>
+class ParticleSystem
+{
+public:
+
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using BallType		= Ball<TVectorType, ValueType>;
+	using BoxType		= Box<TVectorType, ValueType>;
+	using ArrayType		= PointArray<TVectorType, ValueType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	static_assert(std::is_floating_point_v<ValueType>, "Particle system requires floating point type");
+
+	/// <summary>
+	/// Initializes a new, empty instance of the <see cref="ParticleSystem"/> class.
+	/// </summary>
+	ParticleSystem() = default;
+
+	/// <summary>
+	/// Returns number of particles.
+	/// </summary>
+	/// <returns>Number of particles.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Reserves memory for the specified number of particles.
+	/// </summary>
+	/// <param name="capacity_">The capacity.</param>
+	void reserve(std::size_t const capacity_);
+
+	/// <summary>
+	/// Removes all particles.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Appends the particle.
+	/// </summary>
+	/// <param name="position_">The position.</param>
+	/// <param name="velocity_">The velocity.</param>
+	void addParticle(VectorType const & position_, VectorType const & velocity_ = VectorType{});
+
+	/// <summary>
+	/// Returns positions of the particles.
+	/// </summary>
+	/// <returns>Positions of the particles.</returns>
+	ArrayType const & getPositions() const;
+
+	/// <summary>
+	/// Returns positions of the particles for modification; their count must not be changed.
+	/// </summary>
+	/// <returns>Positions of the particles.</returns>
+	ArrayType & getPositions();
+
+	/// <summary>
+	/// Returns velocities of the particles.
+	/// </summary>
+	/// <returns>Velocities of the particles.</returns>
+	ArrayType const & getVelocities() const;
+
+	/// <summary>
+	/// Returns velocities of the particles for modification; their count must not be changed.
+	/// </summary>
+	/// <returns>Velocities of the particles.</returns>
+	ArrayType & getVelocities();
+
+	/// <summary>
+	/// Sets acceleration acting on every particle, such as gravity.
+	/// </summary>
+	/// <param name="acceleration_">The acceleration.</param>
+	void setAcceleration(VectorType const & acceleration_);
+
+	/// <summary>
+	/// Returns acceleration acting on every particle.
+	/// </summary>
+	/// <returns>The acceleration.</returns>
+	VectorType const & getAcceleration() const;
+
+	/// <summary>
+	/// Sets the integrator.
+	/// </summary>
+	/// <param name="integrator_">The integrator.</param>
+	void setIntegrator(ParticleIntegrator const integrator_);
+
+	/// <summary>
+	/// Returns the integrator.
+	/// </summary>
+	/// <returns>The integrator.</returns>
+	ParticleIntegrator getIntegrator() const;
+
+	/// <summary>
+	/// Sets part of the normal velocity kept by bouncing particles: 1 is perfectly elastic, 0 stops them at the surface.
+	/// </summary>
+	/// <param name="restitution_">The restitution.</param>
+	void setRestitution(ValueType const restitution_);
+
+	/// <summary>
+	/// Returns part of the normal velocity kept by bouncing particles.
+	/// </summary>
+	/// <returns>The restitution.</returns>
+	ValueType getRestitution() const;
+
+	/// <summary>
+	/// Keeps the particles inside the box.
+	/// </summary>
+	/// <param name="container_">The container.</param>
+	void setContainer(BoxType const & container_);
+
+	/// <summary>
+	/// Lets the particles move without a container.
+	/// </summary>
+	void removeContainer();
+
+	/// <summary>
+	/// Adds ball obstacle the particles bounce off.
+	/// </summary>
+	/// <param name="ball_">The ball.</param>
+	void addObstacle(BallType const & ball_);
+
+	/// <summary>
+	/// Adds box obstacle the particles bounce off.
+	/// </summary>
+	/// <param name="box_">The box.</param>
+	void addObstacle(BoxType const & box_);
+
+	/// <summary>
+	/// Removes all obstacles.
+	/// </summary>
+	void clearObstacles();
+
+	/// <summary>
+	/// Advances the particles by the time step and resolves their collisions.
+	/// </summary>
+	/// <param name="timeStep_">The time step.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	void step(ValueType const timeStep_, std::size_t const threadCount_ = 0);
+
+private:
+	ArrayType				m_positions;
+	ArrayType				m_velocities;
+	VectorType				m_acceleration;
+	ParticleIntegrator		m_integrator	= ParticleIntegrator::SemiImplicitEuler;
+	ValueType				m_restitution	= ValueType(1);
+	BoxType					m_container;
+	bool					m_hasContainer	= false;
+	std::vector<BallType>	m_ballObstacles;
+	std::vector<BoxType>	m_boxObstacles;
+};
+
+template <typename TValueType>
+using ParticleSystem2	= ParticleSystem<Vector2, TValueType>;
+
+template <typename TValueType>
+using ParticleSystem3	= ParticleSystem<Vector3, TValueType>;
+
+using ParticleSystem2f	= ParticleSystem2<float>;
+using ParticleSystem2d	= ParticleSystem2<double>;
+using ParticleSystem3f	= ParticleSystem3<float>;
+using ParticleSystem3d	= ParticleSystem3<double>;
+
+}
+
+#include "Private/ParticleSystem.inl"
\ No newline at end of file
@@ -0,0 +1,72 @@
+// File description:
+// Implements adaptive exact geometric predicates (orientation, incircle).
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Result type of the geometric predicates. Float inputs are evaluated in double precision.
+/// </summary>
+template <typename TValueType>
+using PredicateType = std::conditional_t< std::is_same_v<TValueType, float>, double, TValueType >;
+
+/// <summary>
+/// Computes orientation of three points in the plane.
+/// </summary>
+/// <param name="a_">The first point.</param>
+/// <param name="b_">The second point.</param>
+/// <param name="c_">The third point.</param>
+/// <returns>
+///   Positive value if points are in counterclockwise order, negative if clockwise, zero if collinear.
+///   Value is an approximation of twice the signed area of the triangle, but its sign is always exact.
+/// </returns>
+/// <remarks>
+/// <para>
+/// Uses floating point filter first and falls back to exact arithmetic (Shewchuk's expansions)
+/// only when the result cannot be trusted. Do not compile with unsafe math optimizations (-ffast-math).
+/// </para>
+/// </remarks>
+template <typename TValueType>
+PredicateType<TValueType> orientation(Vector2<TValueType> const & a_, Vector2<TValueType> const & b_, Vector2<TValueType> const & c_);
+
+/// <summary>
+/// Computes orientation of the point `d_` relative to the plane through `a_`, `b_` and `c_`.
+/// </summary>
+/// <param name="a_">The first plane point.</param>
+/// <param name="b_">The second plane point.</param>
+/// <param name="c_">The third plane point.</param>
+/// <param name="d_">The tested point.</param>
+/// <returns>
+///   Positive value if `d_` lies below the plane (`a_`, `b_`, `c_` appear counterclockwise when viewed from above),
+///   negative if above, zero if coplanar. The sign is always exact.
+/// </returns>
+template <typename TValueType>
+PredicateType<TValueType> orientation(Vector3<TValueType> const & a_, Vector3<TValueType> const & b_,
+										Vector3<TValueType> const & c_, Vector3<TValueType> const & d_);
+
+/// <summary>
+/// Determines position of the point `d_` relative to the circle through `a_`, `b_` and `c_`.
+/// </summary>
+/// <param name="a_">The first circle point.</param>
+/// <param name="b_">The second circle point.</param>
+/// <param name="c_">The third circle point.</param>
+/// <param name="d_">The tested point.</param>
+/// <returns>
+///   Positive value if `d_` lies inside the circle, negative if outside, zero if cocircular.
+///   Points `a_`, `b_` and `c_` must be in counterclockwise order, otherwise the sign is reversed.
+///   The sign is always exact.
+/// </returns>
+template <typename TValueType>
+PredicateType<TValueType> inCircle(Vector2<TValueType> const & a_, Vector2<TValueType> const & b_,
+									Vector2<TValueType> const & c_, Vector2<TValueType> const & d_);
+
+} // namespace quickmaffs
+
+#include "Private/Predicates.inl"
\ No newline at end of file
@@ -0,0 +1,146 @@
+// Note: this file is not meant to be included on its own.
+// Include "Aabb.hpp" instead.
+
+namespace quickmaffs
+{
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr Aabb< TVectorType, TValueType >::Aabb(VectorType const& lower_, VectorType const& upper_)
+	:
+	lower{ lower_ },
+	upper{ upper_ }
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr Aabb< TVectorType, TValueType >::Aabb(BoxType const& box_)
+	:
+	lower{ box_.center - box_.getHalfExtent() },
+	upper{ box_.center + box_.getHalfExtent() }
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr Aabb< TVectorType, TValueType > Aabb< TVectorType, TValueType >::empty()
+{
+	Aabb result;
+	for (std::size_t d = 0; d < result.lower.size(); ++d)
+	{
+		result.lower[d] = std::numeric_limits<ValueType>::has_infinity ? std::numeric_limits<ValueType>::infinity() : std::numeric_limits<ValueType>::max();
+		result.upper[d] = std::numeric_limits<ValueType>::has_infinity ? -std::numeric_limits<ValueType>::infinity() : std::numeric_limits<ValueType>::lowest();
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr typename Aabb< TVectorType, TValueType >::BoxType Aabb< TVectorType, TValueType >::toBox() const
+{
+	return BoxType{ this->getCenter(), (upper - lower) / static_cast< ValueType >(2) };
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr typename Aabb< TVectorType, TValueType >::VectorType Aabb< TVectorType, TValueType >::getCenter() const
+{
+	// lower + half of the extent does not overflow for integers.
+	return lower + (upper - lower) / static_cast< ValueType >(2);
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr typename Aabb< TVectorType, TValueType >::VectorType Aabb< TVectorType, TValueType >::getExtent() const
+{
+	return upper - lower;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr bool Aabb< TVectorType, TValueType >::isEmpty() const
+{
+	bool result = false;
+	for (std::size_t d = 0; d < lower.size(); ++d)
+		result |= lower[d] > upper[d];
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr void Aabb< TVectorType, TValueType >::extend(VectorType const& point_)
+{
+	for (std::size_t d = 0; d < lower.size(); ++d)
+	{
+		lower[d] = std::min(lower[d], point_[d]);
+		upper[d] = std::max(upper[d], point_[d]);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr void Aabb< TVectorType, TValueType >::extend(Aabb const& other_)
+{
+	for (std::size_t d = 0; d < lower.size(); ++d)
+	{
+		lower[d] = std::min(lower[d], other_.lower[d]);
+		upper[d] = std::max(upper[d], other_.upper[d]);
+	}
+}
+
+namespace priv
+{
+
+////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Half of the surface area of the bounds (half of the perimeter in 2D), the cost metric of bounding volume hierarchies.
+/// Integer bounds are measured in double, so the products do not overflow.
+/// </summary>
+template <typename TAabbType>
+auto halfSurfaceArea(TAabbType const& bounds_)
+{
+	using ValueType = typename TAabbType::ValueType;
+	using CostType = std::conditional_t<std::is_floating_point_v<ValueType>, ValueType, double>;
+
+	auto const extent = bounds_.getExtent();
+	if constexpr (typename TAabbType::VectorType{}.size() == 2)
+		return static_cast<CostType>(extent[0]) + static_cast<CostType>(extent[1]);
+	else
+	{
+		CostType const x = static_cast<CostType>(extent[0]);
+		CostType const y = static_cast<CostType>(extent[1]);
+		CostType const z = static_cast<CostType>(extent[2]);
+		return x * y + y * z + z * x;
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Checks whether `outer_` contains `inner_`, boundaries included.
+/// </summary>
+template <typename TAabbType>
+constexpr bool containsBounds(TAabbType const& outer_, TAabbType const& inner_)
+{
+	bool result = true;
+	for (std::size_t d = 0; d < outer_.lower.size(); ++d)
+		result &= (outer_.lower[d] <= inner_.lower[d]) & (inner_.upper[d] <= outer_.upper[d]);
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Checks whether the bounds contain the point, boundaries included.
+/// </summary>
+template <typename TAabbType>
+constexpr bool containsPoint(TAabbType const& bounds_, typename TAabbType::VectorType const& point_)
+{
+	bool result = true;
+	for (std::size_t d = 0; d < point_.size(); ++d)
+		result &= (bounds_.lower[d] <= point_[d]) & (point_[d] <= bounds_.upper[d]);
+	return result;
+}
+
+} // namespace priv
+
+}
\ No newline at end of file
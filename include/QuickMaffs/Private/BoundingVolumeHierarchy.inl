@@ -0,0 +1,587 @@
+// Note: this file is not meant to be included on its own.
+// Include "BoundingVolumeHierarchy.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Number of centroid bins per axis evaluated by the surface area heuristic.
+constexpr std::size_t cxBvhBins = 16;
+// Nodes with at most this many shapes may become leaves.
+constexpr std::size_t cxBvhMaxLeafSize = 8;
+// Nodes at this depth are always leaves, so traversals can use a fixed size stack.
+constexpr std::size_t cxBvhMaxDepth = 64;
+// Nodes with at least this many shapes compute bounds and bins in parallel.
+constexpr std::size_t cxBvhParallelBinning = std::size_t(1) << 14;
+// Subtrees with at most this many shapes are never split into separate build tasks.
+constexpr std::size_t cxBvhMinTaskSize = 1024;
+
+/// <summary>
+/// Builds the flat node array of <see cref="BoundingVolumeHierarchy"/> from bounds of the shapes.
+/// </summary>
+/// <remarks>
+/// <para>
+/// The top of the tree is built on the calling thread, with bounds and bins of large nodes computed in parallel.
+/// Ranges small enough are deferred as tasks, built on worker threads into separate node arrays
+/// and finally appended to the main array.
+/// </para>
+/// </remarks>
+template <typename TAabbType>
+class BvhBuilder
+{
+public:
+	using ValueType		= typename TAabbType::ValueType;
+	using VectorType	= typename TAabbType::VectorType;
+	using Node			= BvhNode<TAabbType>;
+	using CostType		= std::conditional_t<std::is_floating_point_v<ValueType>, ValueType, double>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	BvhBuilder(std::vector<TAabbType> const & bounds_, std::size_t const threadCount_);
+
+	void run();
+
+	std::vector<Node> & getNodes()				{ return m_nodes; }
+	std::vector<std::uint32_t> & getOrder()		{ return m_order; }
+
+private:
+	struct Bin
+	{
+		TAabbType	bounds = TAabbType::empty();
+		std::size_t	count = 0;
+	};
+	using Bins = std::array<std::array<Bin, cxBvhBins>, Dimensions>;
+
+	struct Task
+	{
+		std::size_t node, begin, end, depth;
+	};
+
+	void buildNode(std::vector<Node> & nodes_, std::size_t const nodeIndex_,
+					std::size_t const begin_, std::size_t const end_, std::size_t const depth_, std::vector<Task> * tasks_);
+
+	void computeRangeBounds(std::size_t const begin_, std::size_t const end_, bool const parallel_,
+							TAabbType & bounds_, TAabbType & centroidBounds_) const;
+
+	void binRange(std::size_t const begin_, std::size_t const end_, bool const parallel_,
+					TAabbType const & centroidBounds_, Bins & bins_) const;
+
+	static std::size_t binIndex(ValueType const centroid_, ValueType const lower_, CostType const scale_);
+
+	std::vector<TAabbType> const &	m_bounds;
+	std::vector<VectorType>			m_centroids;
+	std::vector<std::uint32_t>		m_order;
+	std::vector<Node>				m_nodes;
+	std::size_t						m_threadCount;
+	std::size_t						m_taskSize = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TAabbType>
+BvhBuilder<TAabbType>::BvhBuilder(std::vector<TAabbType> const & bounds_, std::size_t const threadCount_)
+	:
+	m_bounds{ bounds_ },
+	m_threadCount{ resolveThreadCount(threadCount_) }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TAabbType>
+void BvhBuilder<TAabbType>::run()
+{
+	std::size_t const count = m_bounds.size();
+	m_nodes.clear();
+	m_order.resize(count);
+	m_centroids.resize(count);
+	if (count == 0)
+		return;
+
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		m_order[i] = static_cast<std::uint32_t>(i);
+		m_centroids[i] = m_bounds[i].getCenter();
+	}
+
+	m_nodes.reserve(2 * count);
+	m_nodes.push_back(Node{});
+
+	m_taskSize = std::max(cxBvhMinTaskSize, count / (m_threadCount * 8));
+	if (m_threadCount == 1 || count <= m_taskSize)
+	{
+		this->buildNode(m_nodes, 0, 0, count, 0, nullptr);
+		return;
+	}
+
+	std::vector<Task> tasks;
+	this->buildNode(m_nodes, 0, 0, count, 0, &tasks);
+
+	// Largest tasks first, handed out one by one to balance the threads:
+	std::sort(tasks.begin(), tasks.end(),
+		[](Task const & lhs_, Task const & rhs_) { return lhs_.end - lhs_.begin > rhs_.end - rhs_.begin; });
+
+	std::vector< std::vector<Node> > taskNodes(tasks.size());
+	std::atomic<std::size_t> nextTask{ 0 };
+	parallelFor(std::min(m_threadCount, tasks.size()), m_threadCount,
+		[&](std::size_t, std::size_t, std::size_t)
+		{
+			for (std::size_t t = nextTask++; t < tasks.size(); t = nextTask++)
+			{
+				auto & nodes = taskNodes[t];
+				nodes.reserve(2 * (tasks[t].end - tasks[t].begin));
+				nodes.push_back(Node{});
+				this->buildNode(nodes, 0, tasks[t].begin, tasks[t].end, tasks[t].depth, nullptr);
+			}
+		});
+
+	// The task root replaces its placeholder, the rest is appended with child offsets remapped:
+	for (std::size_t t = 0; t < tasks.size(); ++t)
+	{
+		auto const & nodes = taskNodes[t];
+		std::size_t const base = m_nodes.size();
+		auto remap = [base](Node node_) {
+				if (node_.count == 0)
+					node_.offset = static_cast<std::uint32_t>(base + node_.offset - 1);
+				return node_;
+			};
+
+		m_nodes[tasks[t].node] = remap(nodes[0]);
+		for (std::size_t i = 1; i < nodes.size(); ++i)
+			m_nodes.push_back(remap(nodes[i]));
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TAabbType>
+void BvhBuilder<TAabbType>::buildNode(std::vector<Node> & nodes_, std::size_t const nodeIndex_,
+										std::size_t const begin_, std::size_t const end_, std::size_t const depth_, std::vector<Task> * tasks_)
+{
+	std::size_t const count = end_ - begin_;
+	bool const parallel = tasks_ != nullptr && count >= cxBvhParallelBinning;
+
+	TAabbType bounds, centroidBounds;
+	this->computeRangeBounds(begin_, end_, parallel, bounds, centroidBounds);
+	nodes_[nodeIndex_] = Node{ bounds, static_cast<std::uint32_t>(begin_), static_cast<std::uint32_t>(count) };
+	if (count <= 1 || depth_ + 1 >= cxBvhMaxDepth)
+		return;
+
+	// Best split over all axes; the cost of a side is its surface area times its shape count.
+	VectorType const centroidExtent = centroidBounds.getExtent();
+	std::size_t bestAxis = 0, bestBin = 0;
+	CostType bestCost = std::numeric_limits<CostType>::infinity();
+	{
+		Bins bins;
+		this->binRange(begin_, end_, parallel, centroidBounds, bins);
+
+		for (std::size_t axis = 0; axis < Dimensions; ++axis)
+		{
+			if (!(centroidExtent[axis] > ValueType(0)))
+				continue;
+
+			std::array<CostType, cxBvhBins - 1> leftCosts;
+			TAabbType side = TAabbType::empty();
+			std::size_t sideCount = 0;
+			for (std::size_t b = 0; b + 1 < cxBvhBins; ++b)
+			{
+				side.extend(bins[axis][b].bounds);
+				sideCount += bins[axis][b].count;
+				leftCosts[b] = sideCount ? halfSurfaceArea(side) * static_cast<CostType>(sideCount) : CostType(0);
+			}
+
+			side = TAabbType::empty();
+			sideCount = 0;
+			for (std::size_t b = cxBvhBins - 1; b > 0; --b)
+			{
+				side.extend(bins[axis][b].bounds);
+				sideCount += bins[axis][b].count;
+				CostType const cost = leftCosts[b - 1] + (sideCount ? halfSurfaceArea(side) * static_cast<CostType>(sideCount) : CostType(0));
+				if (sideCount != 0 && sideCount != count && cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = b - 1;
+				}
+			}
+		}
+	}
+
+	auto const first = m_order.begin() + static_cast<std::ptrdiff_t>(begin_);
+	auto const last = m_order.begin() + static_cast<std::ptrdiff_t>(end_);
+	std::size_t middle = begin_ + count / 2;
+	if (bestCost < std::numeric_limits<CostType>::infinity())
+	{
+		// Leaf when it is cheaper than traversal step plus the children, relative to the node area:
+		CostType const area = halfSurfaceArea(bounds);
+		CostType const splitCost = area > CostType(0) ? CostType(1) + bestCost / area : static_cast<CostType>(count);
+		if (count <= cxBvhMaxLeafSize && static_cast<CostType>(count) <= splitCost)
+			return;
+
+		CostType const scale = static_cast<CostType>(cxBvhBins) / static_cast<CostType>(centroidExtent[bestAxis]);
+		ValueType const lower = centroidBounds.lower[bestAxis];
+		middle = static_cast<std::size_t>(std::partition(first, last,
+				[&](std::uint32_t const index_) { return binIndex(m_centroids[index_][bestAxis], lower, scale) <= bestBin; })
+			- m_order.begin());
+	}
+	else if (count <= cxBvhMaxLeafSize)
+		return;
+
+	// Coincident centroids or rounding: split in halves, so the depth stays logarithmic.
+	if (middle == begin_ || middle == end_)
+		middle = begin_ + count / 2;
+
+	std::size_t const children = nodes_.size();
+	nodes_.resize(children + 2);
+	nodes_[nodeIndex_].offset = static_cast<std::uint32_t>(children);
+	nodes_[nodeIndex_].count = 0;
+
+	std::size_t const ranges[2][2] = { { begin_, middle }, { middle, end_ } };
+	for (std::size_t c = 0; c < 2; ++c)
+	{
+		if (tasks_ != nullptr && ranges[c][1] - ranges[c][0] <= m_taskSize)
+			tasks_->push_back(Task{ children + c, ranges[c][0], ranges[c][1], depth_ + 1 });
+		else
+			this->buildNode(nodes_, children + c, ranges[c][0], ranges[c][1], depth_ + 1, tasks_);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TAabbType>
+void BvhBuilder<TAabbType>::computeRangeBounds(std::size_t const begin_, std::size_t const end_, bool const parallel_,
+												TAabbType & bounds_, TAabbType & centroidBounds_) const
+{
+	auto accumulate = [this](std::size_t const from_, std::size_t const to_, TAabbType & targetBounds_, TAabbType & targetCentroidBounds_) {
+			for (std::size_t i = from_; i < to_; ++i)
+			{
+				targetBounds_.extend(m_bounds[m_order[i]]);
+				targetCentroidBounds_.extend(m_centroids[m_order[i]]);
+			}
+		};
+
+	bounds_ = centroidBounds_ = TAabbType::empty();
+	if (!parallel_)
+	{
+		accumulate(begin_, end_, bounds_, centroidBounds_);
+		return;
+	}
+
+	std::size_t const count = end_ - begin_;
+	std::vector< std::array<TAabbType, 2> > partials(parallelChunkCount(count, m_threadCount),
+		std::array<TAabbType, 2>{ TAabbType::empty(), TAabbType::empty() });
+	parallelFor(count, m_threadCount,
+		[&](std::size_t const chunkBegin_, std::size_t const chunkEnd_, std::size_t const chunk_)
+		{
+			accumulate(begin_ + chunkBegin_, begin_ + chunkEnd_, partials[chunk_][0], partials[chunk_][1]);
+		});
+	for (auto const & partial : partials)
+	{
+		bounds_.extend(partial[0]);
+		centroidBounds_.extend(partial[1]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TAabbType>
+void BvhBuilder<TAabbType>::binRange(std::size_t const begin_, std::size_t const end_, bool const parallel_,
+										TAabbType const & centroidBounds_, Bins & bins_) const
+{
+	VectorType const extent = centroidBounds_.getExtent();
+	std::array<CostType, Dimensions> scales;
+	for (std::size_t axis = 0; axis < Dimensions; ++axis)
+		scales[axis] = extent[axis] > ValueType(0) ? static_cast<CostType>(cxBvhBins) / static_cast<CostType>(extent[axis]) : CostType(0);
+
+	auto accumulate = [&](std::size_t const from_, std::size_t const to_, Bins & targetBins_) {
+			for (std::size_t i = from_; i < to_; ++i)
+			{
+				std::uint32_t const index = m_order[i];
+				for (std::size_t axis = 0; axis < Dimensions; ++axis)
+				{
+					Bin & bin = targetBins_[axis][binIndex(m_centroids[index][axis], centroidBounds_.lower[axis], scales[axis])];
+					bin.bounds.extend(m_bounds[index]);
+					++bin.count;
+				}
+			}
+		};
+
+	bins_ = Bins{};
+	if (!parallel_)
+	{
+		accumulate(begin_, end_, bins_);
+		return;
+	}
+
+	std::size_t const count = end_ - begin_;
+	std::vector<Bins> partials(parallelChunkCount(count, m_threadCount));
+	parallelFor(count, m_threadCount,
+		[&](std::size_t const chunkBegin_, std::size_t const chunkEnd_, std::size_t const chunk_)
+		{
+			accumulate(begin_ + chunkBegin_, begin_ + chunkEnd_, partials[chunk_]);
+		});
+	for (auto const & partial : partials)
+	{
+		for (std::size_t axis = 0; axis < Dimensions; ++axis)
+		{
+			for (std::size_t b = 0; b < cxBvhBins; ++b)
+			{
+				bins_[axis][b].bounds.extend(partial[axis][b].bounds);
+				bins_[axis][b].count += partial[axis][b].count;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TAabbType>
+std::size_t BvhBuilder<TAabbType>::binIndex(ValueType const centroid_, ValueType const lower_, CostType const scale_)
+{
+	CostType const position = static_cast<CostType>(centroid_ - lower_) * scale_;
+	return std::min(cxBvhBins - 1, static_cast<std::size_t>(std::max(position, CostType(0))));
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+BoundingVolumeHierarchy<TShapeType>::BoundingVolumeHierarchy(std::vector<ShapeType> shapes_, std::size_t const threadCount_)
+{
+	this->build(std::move(shapes_), threadCount_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void BoundingVolumeHierarchy<TShapeType>::build(std::vector<ShapeType> shapes_, std::size_t const threadCount_)
+{
+	if (shapes_.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("Too many shapes for bounding volume hierarchy");
+
+	std::vector<AabbType> bounds(shapes_.size());
+	for (std::size_t i = 0; i < shapes_.size(); ++i)
+		bounds[i] = computeBounds(shapes_[i]);
+
+	priv::BvhBuilder<AabbType> builder{ bounds, threadCount_ };
+	builder.run();
+
+	auto const & order = builder.getOrder();
+	m_nodes = std::move(builder.getNodes());
+	m_shapes.resize(shapes_.size());
+	m_shapeIndices.resize(shapes_.size());
+	for (std::size_t i = 0; i < order.size(); ++i)
+	{
+		m_shapes[i] = shapes_[order[i]];
+		m_shapeIndices[i] = order[i];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t BoundingVolumeHierarchy<TShapeType>::size() const
+{
+	return m_shapes.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<typename BoundingVolumeHierarchy<TShapeType>::Node> const & BoundingVolumeHierarchy<TShapeType>::getNodes() const
+{
+	return m_nodes;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<TShapeType> const & BoundingVolumeHierarchy<TShapeType>::getShapes() const
+{
+	return m_shapes;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<std::size_t> const & BoundingVolumeHierarchy<TShapeType>::getShapeIndices() const
+{
+	return m_shapeIndices;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TFunction>
+void BoundingVolumeHierarchy<TShapeType>::forEachContaining(VectorType const & point_, TFunction && function_) const
+{
+	if (m_nodes.empty())
+		return;
+
+	std::uint32_t stack[priv::cxBvhMaxDepth + 1];
+	std::size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		Node const & node = m_nodes[stack[--top]];
+		if (!priv::containsPoint(node.bounds, point_))
+			continue;
+
+		if (node.count == 0)
+		{
+			stack[top++] = node.offset + 1;
+			stack[top++] = node.offset;
+			continue;
+		}
+		for (std::size_t i = node.offset; i < node.offset + node.count; ++i)
+		{
+			if (isPointInside(m_shapes[i], point_))
+				function_(m_shapeIndices[i]);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<std::size_t> BoundingVolumeHierarchy<TShapeType>::findContaining(VectorType const & point_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachContaining(point_, [&result](std::size_t const index_) { result.push_back(index_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TQueryShapeType, typename TFunction>
+void BoundingVolumeHierarchy<TShapeType>::forEachOverlapping(TQueryShapeType const & shape_, TFunction && function_) const
+{
+	if (m_nodes.empty())
+		return;
+
+	std::uint32_t stack[priv::cxBvhMaxDepth + 1];
+	std::size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		Node const & node = m_nodes[stack[--top]];
+		if (!intersects(shape_, node.bounds))
+			continue;
+
+		if (node.count == 0)
+		{
+			stack[top++] = node.offset + 1;
+			stack[top++] = node.offset;
+			continue;
+		}
+		for (std::size_t i = node.offset; i < node.offset + node.count; ++i)
+		{
+			if (intersects(shape_, m_shapes[i]))
+				function_(m_shapeIndices[i]);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TQueryShapeType>
+std::vector<std::size_t> BoundingVolumeHierarchy<TShapeType>::findOverlapping(TQueryShapeType const & shape_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachOverlapping(shape_, [&result](std::size_t const index_) { result.push_back(index_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TFunction>
+void BoundingVolumeHierarchy<TShapeType>::forEachIntersectingRay(VectorType const & origin_, VectorType const & direction_,
+																	TFunction && function_) const
+{
+	if (m_nodes.empty())
+		return;
+
+	ValueType const tMax = std::numeric_limits<ValueType>::infinity();
+	std::uint32_t stack[priv::cxBvhMaxDepth + 1];
+	std::size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		Node const & node = m_nodes[stack[--top]];
+		ValueType entry;
+		if (!priv::rayRangeEntryBounds(node.bounds.lower, node.bounds.upper, origin_, direction_, tMax, entry))
+			continue;
+
+		if (node.count == 0)
+		{
+			stack[top++] = node.offset + 1;
+			stack[top++] = node.offset;
+			continue;
+		}
+		for (std::size_t i = node.offset; i < node.offset + node.count; ++i)
+		{
+			if (intersectsRay(m_shapes[i], origin_, direction_))
+				function_(m_shapeIndices[i]);
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<std::size_t> BoundingVolumeHierarchy<TShapeType>::findIntersectingRay(VectorType const & origin_, VectorType const & direction_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachIntersectingRay(origin_, direction_, [&result](std::size_t const index_) { result.push_back(index_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+typename BoundingVolumeHierarchy<TShapeType>::RayHit BoundingVolumeHierarchy<TShapeType>::castRay(VectorType const & origin_,
+																	VectorType const & direction_, ValueType const maxDistance_) const
+{
+	RayHit hit;
+	hit.distance = maxDistance_;
+
+	ValueType entry;
+	if (m_nodes.empty() || !priv::rayRangeEntryBounds(m_nodes[0].bounds.lower, m_nodes[0].bounds.upper, origin_, direction_, maxDistance_, entry))
+		return hit;
+
+	// Nodes are pushed with their entry distance, so the ones behind the closest hit are skipped on pop.
+	std::pair<std::uint32_t, ValueType> stack[priv::cxBvhMaxDepth + 1];
+	std::size_t top = 0;
+	stack[top++] = { 0, entry };
+	while (top > 0)
+	{
+		auto const [nodeIndex, nodeEntry] = stack[--top];
+		if (nodeEntry > hit.distance)
+			continue;
+
+		Node const & node = m_nodes[nodeIndex];
+		if (node.count != 0)
+		{
+			for (std::size_t i = node.offset; i < node.offset + node.count; ++i)
+			{
+				if (priv::rayRangeEntry(m_shapes[i], origin_, direction_, hit.distance, entry)
+					&& (hit.index == npos || entry < hit.distance))
+				{
+					hit.index = m_shapeIndices[i];
+					hit.distance = entry;
+				}
+			}
+			continue;
+		}
+
+		// Near child is pushed last, so it is visited first:
+		ValueType entries[2];
+		bool hits[2];
+		for (std::size_t c = 0; c < 2; ++c)
+		{
+			auto const & bounds = m_nodes[node.offset + c].bounds;
+			hits[c] = priv::rayRangeEntryBounds(bounds.lower, bounds.upper, origin_, direction_, hit.distance, entries[c]);
+		}
+		std::size_t const near = (hits[1] && (!hits[0] || entries[1] < entries[0])) ? 1 : 0;
+		std::size_t const far = 1 - near;
+		if (hits[far])
+			stack[top++] = { node.offset + static_cast<std::uint32_t>(far), entries[far] };
+		if (hits[near])
+			stack[top++] = { node.offset + static_cast<std::uint32_t>(near), entries[near] };
+	}
+
+	if (hit.index == npos)
+		hit.distance = 0;
+	return hit;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,275 @@
+// Note: this file is not meant to be included on its own.
+// Include "BoundingVolumes.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Seed of the shuffle of computeEnclosingBall.
+constexpr std::uint32_t cxEnclosingBallSeed = 0x9E3779B9u;
+
+// Relative tolerance of squared radius when testing points against a candidate ball, in machine epsilons.
+constexpr int cxEnclosingBallTolerance = 64;
+
+// Independent minimum and maximum lanes per component used by computeBoundingBox.
+constexpr std::size_t cxPointBoundsLanes = 8;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns components of the vector as an array.
+/// </summary>
+template <typename TVectorType>
+constexpr auto vectorComponents(TVectorType const & vector_)
+{
+	using V = typename TVectorType::ValueType;
+	if constexpr (TVectorType{}.size() == 2)
+		return std::array<V, 2>{ vector_.x, vector_.y };
+	else
+		return std::array<V, 3>{ vector_.x, vector_.y, vector_.z };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Computes the smallest ball with all support points on its boundary, as center and squared radius.
+/// No support points give a ball containing nothing (negative squared radius).
+/// </summary>
+/// <remarks>
+/// <para>
+/// The center lies in the affine hull of the support: `support[0] + sum(lambda_j * a_j)` with `a_j = support[j] - support[0]`.
+/// Equal distances to all support points give the linear system `sum_k (a_j . a_k) * lambda_k = (a_j . a_j) / 2`,
+/// solved by Gaussian elimination. Affinely dependent support (only possible through rounding) falls back to
+/// the ball spanned by the farthest pair of support points.
+/// </para>
+/// </remarks>
+template <typename TVectorType, typename TValueType>
+void computeCircumball(TVectorType const * support_, std::size_t const count_, TVectorType & center_, TValueType & radiusSquared_)
+{
+	using V = TValueType;
+	constexpr std::size_t dimensions = TVectorType{}.size();
+
+	if (count_ == 0)
+	{
+		center_ = TVectorType{};
+		radiusSquared_ = V(-1);
+		return;
+	}
+	if (count_ == 1)
+	{
+		center_ = support_[0];
+		radiusSquared_ = V(0);
+		return;
+	}
+
+	std::size_t const size = count_ - 1;
+	TVectorType axes[dimensions];
+	V system[dimensions][dimensions + 1];
+	V scale = V(0);
+	for (std::size_t j = 0; j < size; ++j)
+	{
+		axes[j] = support_[j + 1] - support_[0];
+		scale = std::max(scale, axes[j].lengthSquared());
+	}
+	for (std::size_t j = 0; j < size; ++j)
+	{
+		for (std::size_t k = 0; k < size; ++k)
+			system[j][k] = axes[j].dot(axes[k]);
+		system[j][size] = axes[j].lengthSquared() / V(2);
+	}
+
+	bool singular = false;
+	for (std::size_t column = 0; column < size && !singular; ++column)
+	{
+		std::size_t pivot = column;
+		for (std::size_t row = column + 1; row < size; ++row)
+		{
+			if (std::abs(system[row][column]) > std::abs(system[pivot][column]))
+				pivot = row;
+		}
+		if (std::abs(system[pivot][column]) <= scale * std::numeric_limits<V>::epsilon() * V(cxEnclosingBallTolerance))
+		{
+			singular = true;
+			break;
+		}
+		std::swap(system[pivot], system[column]);
+
+		for (std::size_t row = column + 1; row < size; ++row)
+		{
+			V const factor = system[row][column] / system[column][column];
+			for (std::size_t k = column; k <= size; ++k)
+				system[row][k] -= factor * system[column][k];
+		}
+	}
+
+	if (singular)
+	{
+		std::size_t first = 0, second = 0;
+		V farthest = V(-1);
+		for (std::size_t i = 0; i < count_; ++i)
+		{
+			for (std::size_t j = i + 1; j < count_; ++j)
+			{
+				V const distanceSquared = support_[i].distanceSquared(support_[j]);
+				if (distanceSquared > farthest)
+				{
+					farthest = distanceSquared;
+					first = i;
+					second = j;
+				}
+			}
+		}
+		center_ = (support_[first] + support_[second]) / V(2);
+		radiusSquared_ = std::max(center_.distanceSquared(support_[first]), center_.distanceSquared(support_[second]));
+		return;
+	}
+
+	V lambdas[dimensions];
+	for (std::size_t j = size; j-- > 0;)
+	{
+		V sum = system[j][size];
+		for (std::size_t k = j + 1; k < size; ++k)
+			sum -= system[j][k] * lambdas[k];
+		lambdas[j] = sum / system[j][j];
+	}
+
+	TVectorType offset;
+	for (std::size_t j = 0; j < size; ++j)
+		offset += axes[j] * lambdas[j];
+	center_ = support_[0] + offset;
+	radiusSquared_ = offset.lengthSquared();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Smallest ball containing points [0, end_) with the support points on its boundary.
+/// </summary>
+template <typename TVectorType, typename TValueType, std::size_t TSupportSize>
+void computeEnclosingBall(TVectorType const * points_, std::size_t const end_,
+						std::array<TVectorType, TSupportSize> & support_, std::size_t const supportCount_,
+						TVectorType & center_, TValueType & radiusSquared_)
+{
+	computeCircumball(support_.data(), supportCount_, center_, radiusSquared_);
+	if (supportCount_ == TSupportSize)
+		return;
+
+	TValueType const tolerance = std::numeric_limits<TValueType>::epsilon() * TValueType(cxEnclosingBallTolerance);
+	for (std::size_t i = 0; i < end_; ++i)
+	{
+		if (points_[i].distanceSquared(center_) <= radiusSquared_ + radiusSquared_ * tolerance)
+			continue;
+
+		support_[supportCount_] = points_[i];
+		computeEnclosingBall(points_, i, support_, supportCount_ + 1, center_, radiusSquared_);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Computes minimum and maximum corner of the points (at least one).
+/// </summary>
+template <typename TVectorType>
+std::pair<TVectorType, TVectorType> computePointBounds(TVectorType const * points_, std::size_t const count_)
+{
+	using V = typename TVectorType::ValueType;
+	constexpr std::size_t dimensions = TVectorType{}.size();
+	constexpr std::size_t lanes = cxPointBoundsLanes;
+
+	auto const first = vectorComponents(points_[0]);
+	V lower[dimensions][lanes];
+	V upper[dimensions][lanes];
+	for (std::size_t d = 0; d < dimensions; ++d)
+	{
+		std::fill_n(lower[d], lanes, first[d]);
+		std::fill_n(upper[d], lanes, first[d]);
+	}
+
+	// Every lane reduces its own subsequence, so the loop needs no horizontal operations.
+	std::size_t i = 0;
+	for (; i + lanes <= count_; i += lanes)
+	{
+		for (std::size_t lane = 0; lane < lanes; ++lane)
+		{
+			auto const components = vectorComponents(points_[i + lane]);
+			for (std::size_t d = 0; d < dimensions; ++d)
+			{
+				lower[d][lane] = std::min(lower[d][lane], components[d]);
+				upper[d][lane] = std::max(upper[d][lane], components[d]);
+			}
+		}
+	}
+
+	TVectorType lowerBounds = points_[0];
+	TVectorType upperBounds = points_[0];
+	for (; i < count_; ++i)
+	{
+		lowerBounds = TVectorType::lowerBounds(lowerBounds, points_[i]);
+		upperBounds = TVectorType::upperBounds(upperBounds, points_[i]);
+	}
+	for (std::size_t lane = 0; lane < lanes; ++lane)
+	{
+		TVectorType laneLower, laneUpper;
+		for (std::size_t d = 0; d < dimensions; ++d)
+		{
+			laneLower[d] = lower[d][lane];
+			laneUpper[d] = upper[d][lane];
+		}
+		lowerBounds = TVectorType::lowerBounds(lowerBounds, laneLower);
+		upperBounds = TVectorType::upperBounds(upperBounds, laneUpper);
+	}
+	return { lowerBounds, upperBounds };
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+Ball<T, V> computeEnclosingBall(T<V> const * points_, std::size_t const count_)
+{
+	static_assert(std::is_floating_point_v<V>, "Enclosing ball requires floating point type");
+
+	using VectorType = T<V>;
+	constexpr std::size_t dimensions = VectorType{}.size();
+
+	if (count_ == 0)
+		return Ball<T, V>{ VectorType{}, V(0) };
+
+	std::vector<VectorType> points(points_, points_ + count_);
+	std::shuffle(points.begin(), points.end(), std::mt19937{ priv::cxEnclosingBallSeed });
+
+	std::array<VectorType, dimensions + 1> support;
+	VectorType center;
+	V radiusSquared;
+	priv::computeEnclosingBall(points.data(), points.size(), support, 0, center, radiusSquared);
+
+	for (VectorType const & point : points)
+		radiusSquared = std::max(radiusSquared, point.distanceSquared(center));
+	return Ball<T, V>{ center, std::sqrt(radiusSquared) };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+Box<T, V> computeBoundingBox(T<V> const * points_, std::size_t const count_, std::size_t const threadCount_)
+{
+	using VectorType = T<V>;
+
+	if (count_ == 0)
+		return Box<T, V>{};
+
+	std::vector< std::pair<VectorType, VectorType> > chunkBounds(priv::parallelChunkCount(count_, threadCount_));
+	priv::parallelFor(count_, threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_) {
+			chunkBounds[chunk_] = priv::computePointBounds(points_ + begin_, end_ - begin_);
+		});
+
+	auto [lower, upper] = chunkBounds[0];
+	for (auto const & bounds : chunkBounds)
+	{
+		lower = VectorType::lowerBounds(lower, bounds.first);
+		upper = VectorType::upperBounds(upper, bounds.second);
+	}
+	return Aabb<T, V>{ lower, upper }.toBox();
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,284 @@
+// Note: this file is not meant to be included on its own.
+// Include "ContinuousCollision.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Finds first t in [0, 1] at which the point `origin_ + t * direction_` is within `radius_` from the bounds.
+/// Returns infinity when there is none.
+/// </summary>
+template <typename TVectorType, typename TValueType>
+TValueType sweepBallBounds(TVectorType const & origin_, TVectorType const & direction_, TValueType const radius_,
+						   TVectorType const & lower_, TVectorType const & upper_)
+{
+	using V = TValueType;
+	constexpr std::size_t Dimensions = TVectorType{}.size();
+	static_assert(std::is_floating_point_v<V>, "Time of impact requires floating point type");
+
+	// The grown box contains the rounded one, so its entry is a lower bound of the time of impact.
+	V entry;
+	if (!rayRangeEntryBounds(lower_ - radius_, upper_ + radius_, origin_, direction_, V(1), entry))
+		return std::numeric_limits<V>::infinity();
+
+	// Times the point crosses planes of the box faces split the step into intervals with a fixed closest feature.
+	std::array<V, 2 * Dimensions + 2> times;
+	std::size_t timeCount = 0;
+	times[timeCount++] = entry;
+	times[timeCount++] = V(1);
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		if (direction_[d] == V(0))
+			continue;
+		for (V const bound : { lower_[d], upper_[d] })
+		{
+			V const t = (bound - origin_[d]) / direction_[d];
+			if (t > entry && t < V(1))
+				times[timeCount++] = t;
+		}
+	}
+	for (std::size_t k = 1; k < timeCount; ++k)
+	{
+		for (std::size_t j = k; j > 0 && times[j] < times[j - 1]; --j)
+			std::swap(times[j], times[j - 1]);
+	}
+
+	for (std::size_t k = 0; k + 1 < timeCount; ++k)
+	{
+		V const begin = times[k];
+		V const end = times[k + 1];
+		V const middle = (begin + end) / V(2);
+
+		// Squared distance a * t^2 + 2 * b * t + c over the axes the point is outside of.
+		V a = V(0), b = V(0), c = -radius_ * radius_;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			V const position = origin_[d] + direction_[d] * middle;
+			if (position >= lower_[d] && position <= upper_[d])
+				continue;
+
+			V const offset = origin_[d] - (position < lower_[d] ? lower_[d] : upper_[d]);
+			a += direction_[d] * direction_[d];
+			b += offset * direction_[d];
+			c += offset * offset;
+		}
+
+		if ((a * begin + V(2) * b) * begin + c <= V(0))
+			return begin;
+
+		// Distance is above the radius at the beginning, so the first root is in the interval when the parabola
+		// still descends there (testing the vertex instead of the root itself keeps a rounded root slightly
+		// before the beginning, which happens when the interval starts right at the touch).
+		V const discriminant = b * b - a * c;
+		if (a > V(0) && discriminant >= V(0) && b <= -a * begin)
+		{
+			V const t = (-b - std::sqrt(discriminant)) / a;
+			if (t <= end)
+				return std::max(t, begin);
+		}
+	}
+	return std::numeric_limits<V>::infinity();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Gathers pointers to component arrays of balls and displacements, checking that their sizes match.
+/// </summary>
+template <template<typename> typename T, typename V>
+struct SweptBallArrays
+{
+	static constexpr std::size_t Dimensions = BallArray<T, V>::Dimensions;
+
+	SweptBallArrays(BallArray<T, V> const & balls_, PointArray<T, V> const & displacements_)
+	{
+		if (displacements_.size() != balls_.size())
+			throw std::invalid_argument("Displacement count must match ball count");
+
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			centers[d] = balls_.centers[d].data();
+			displacements[d] = displacements_.coordinates[d].data();
+		}
+		radii = balls_.radii.data();
+	}
+
+	V const *	centers[Dimensions];
+	V const *	displacements[Dimensions];
+	V const *	radii;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Computes time of impact of a block of at most cxShapeBatchBlock moving balls against the static ball.
+/// </summary>
+template <template<typename> typename T, typename V>
+void sweepBallsBall(SweptBallArrays<T, V> const & balls_, std::size_t const begin_, std::size_t const count_,
+					Ball<T, V> const & obstacle_, V * times_)
+{
+	constexpr std::size_t Dimensions = BallArray<T, V>::Dimensions;
+	constexpr V infinity = std::numeric_limits<V>::infinity();
+
+	V a[cxShapeBatchBlock];
+	V b[cxShapeBatchBlock];
+	V c[cxShapeBatchBlock];
+	std::fill_n(a, count_, V(0));
+	std::fill_n(b, count_, V(0));
+	std::fill_n(c, count_, V(0));
+
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		V const * centers = balls_.centers[d] + begin_;
+		V const * displacements = balls_.displacements[d] + begin_;
+		V const center = obstacle_.center[d];
+		for (std::size_t i = 0; i < count_; ++i)
+		{
+			V const offset = centers[i] - center;
+			a[i] += displacements[i] * displacements[i];
+			b[i] += offset * displacements[i];
+			c[i] += offset * offset;
+		}
+	}
+
+	V const * radii = balls_.radii + begin_;
+	V const obstacleRadius = obstacle_.getRadius();
+	for (std::size_t i = 0; i < count_; ++i)
+	{
+		V const radius = radii[i] + obstacleRadius;
+		V const excess = c[i] - radius * radius;
+		V const discriminant = b[i] * b[i] - a[i] * excess;
+		V const root = std::sqrt(std::max(discriminant, V(0)));
+		V const t = (-b[i] - root) / a[i];
+
+		// Misses are added up from single-condition selects, so the loop stays free of branches.
+		// Receding balls (b >= 0) include the not moving ones, whose t is NaN and loses to infinity.
+		V const miss = (b[i] < V(0) ? V(0) : infinity) + (discriminant >= V(0) ? V(0) : infinity);
+		V const hit = std::max(miss, t);
+		V const inStep = hit <= V(1) ? hit : infinity;
+		times_[begin_ + i] = excess <= V(0) ? V(0) : inStep;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Computes time of impact of a block of at most cxShapeBatchBlock moving balls against the static bounds:
+/// slab test against the bounds grown by every radius, then exact solution for the balls that reach them.
+/// </summary>
+template <template<typename> typename T, typename V>
+void sweepBallsBounds(SweptBallArrays<T, V> const & balls_, std::size_t const begin_, std::size_t const count_,
+					  T<V> const & lower_, T<V> const & upper_, V * times_)
+{
+	constexpr std::size_t Dimensions = BallArray<T, V>::Dimensions;
+	constexpr V infinity = std::numeric_limits<V>::infinity();
+
+	V tNear[cxShapeBatchBlock];
+	V tFar[cxShapeBatchBlock];
+	std::fill_n(tNear, count_, V(0));
+	std::fill_n(tFar, count_, V(1));
+
+	V const * radii = balls_.radii + begin_;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		V const * origins = balls_.centers[d] + begin_;
+		V const * directions = balls_.displacements[d] + begin_;
+		V const lower = lower_[d];
+		V const upper = upper_[d];
+		for (std::size_t i = 0; i < count_; ++i)
+		{
+			V const grownLower = lower - radii[i];
+			V const grownUpper = upper + radii[i];
+			V const inverse = V(1) / directions[i];
+			V const t1 = (grownLower - origins[i]) * inverse;
+			V const t2 = (grownUpper - origins[i]) * inverse;
+			V const slabNear = std::min(t1, t2);
+			V const slabFar = std::max(t1, t2);
+
+			// Single-condition selects of precomputed values keep the loop free of branches.
+			V parallelNear = grownLower <= origins[i] ? -infinity : infinity;
+			parallelNear = origins[i] <= grownUpper ? parallelNear : infinity;
+			bool const parallel = directions[i] == V(0);
+			tNear[i] = std::max(tNear[i], parallel ? parallelNear : slabNear);
+			tFar[i] = std::min(tFar[i], parallel ? -parallelNear : slabFar);
+		}
+	}
+
+	for (std::size_t i = 0; i < count_; ++i)
+	{
+		if (tNear[i] > tFar[i])
+		{
+			times_[begin_ + i] = infinity;
+			continue;
+		}
+
+		T<V> origin, direction;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			origin[d] = balls_.centers[d][begin_ + i];
+			direction[d] = balls_.displacements[d][begin_ + i];
+		}
+		times_[begin_ + i] = sweepBallBounds(origin, direction, radii[i], lower_, upper_);
+	}
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+V computeTimeOfImpact(Ball<T, V> const & first_, T<V> const & firstDisplacement_, Ball<T, V> const & second_, T<V> const & secondDisplacement_)
+{
+	V entry;
+	if (priv::rayRangeEntryBall(second_.center, first_.getRadius() + second_.getRadius(),
+								first_.center, firstDisplacement_ - secondDisplacement_, V(1), entry))
+		return entry;
+	return std::numeric_limits<V>::infinity();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+V computeTimeOfImpact(Ball<T, V> const & ball_, T<V> const & ballDisplacement_, Box<T, V> const & box_, T<V> const & boxDisplacement_)
+{
+	T<V> const halfExtent = box_.getHalfExtent();
+	return priv::sweepBallBounds(ball_.center, ballDisplacement_ - boxDisplacement_, ball_.getRadius(),
+								 box_.center - halfExtent, box_.center + halfExtent);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+V computeTimeOfImpact(Box<T, V> const & box_, T<V> const & boxDisplacement_, Ball<T, V> const & ball_, T<V> const & ballDisplacement_)
+{
+	return computeTimeOfImpact(ball_, ballDisplacement_, box_, boxDisplacement_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+void computeTimesOfImpact(BallArray<T, V> const & balls_, PointArray<T, V> const & displacements_, Ball<T, V> const & obstacle_,
+						  V * times_, std::size_t const threadCount_)
+{
+	priv::SweptBallArrays<T, V> const balls{ balls_, displacements_ };
+	priv::parallelFor(balls_.size(), threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t) {
+			for (std::size_t block = begin_; block < end_; block += priv::cxShapeBatchBlock)
+				priv::sweepBallsBall(balls, block, std::min(priv::cxShapeBatchBlock, end_ - block), obstacle_, times_);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+void computeTimesOfImpact(BallArray<T, V> const & balls_, PointArray<T, V> const & displacements_, Box<T, V> const & obstacle_,
+						  V * times_, std::size_t const threadCount_)
+{
+	priv::SweptBallArrays<T, V> const balls{ balls_, displacements_ };
+	T<V> const halfExtent = obstacle_.getHalfExtent();
+	T<V> const lower = obstacle_.center - halfExtent;
+	T<V> const upper = obstacle_.center + halfExtent;
+	priv::parallelFor(balls_.size(), threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t) {
+			for (std::size_t block = begin_; block < end_; block += priv::cxShapeBatchBlock)
+				priv::sweepBallsBounds(balls, block, std::min(priv::cxShapeBatchBlock, end_ - block), lower, upper, times_);
+		});
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,366 @@
+// Note: this file is not meant to be included on its own.
+// Include "Contours.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Cell edges, counterclockwise. Edge k starts at corner k:
+// corners: 0 - (x, y), 1 - (x + 1, y), 2 - (x + 1, y + 1), 3 - (x, y + 1).
+constexpr std::uint8_t cxContourBottom	= 0;
+constexpr std::uint8_t cxContourRight	= 1;
+constexpr std::uint8_t cxContourTop		= 2;
+constexpr std::uint8_t cxContourLeft	= 3;
+
+// Cell code layout: bits 0-3 - inside corners, bit 4 - cell center inside, bits 5-6 - visited segments.
+constexpr std::uint8_t cxContourCenterBit	= 1 << 4;
+constexpr std::uint8_t cxContourVisitedBit	= 1 << 5;
+constexpr std::uint8_t cxContourCaseMask	= 0x1F;
+
+/// <summary>
+/// Directed segments of a single marching squares cell (area above iso value on the left).
+/// </summary>
+struct ContourCellSegments
+{
+	std::uint8_t count = 0;
+	std::uint8_t from[2] = {};
+	std::uint8_t to[2] = {};
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+constexpr std::array<ContourCellSegments, 32> makeContourCases()
+{
+	std::array<ContourCellSegments, 32> cases{};
+	for (std::uint8_t code = 0; code < 32; ++code)
+	{
+		auto inside = [code](int const corner_) { return (code >> (corner_ % 4) & 1) != 0; };
+		bool const centerInside = (code & cxContourCenterBit) != 0;
+
+		int crossingCount = 0;
+		for (int edge = 0; edge < 4; ++edge)
+			crossingCount += inside(edge) != inside(edge + 1);
+
+		ContourCellSegments & segments = cases[code];
+		for (int edge = 0; edge < 4; ++edge)
+		{
+			// Segment starts where the counterclockwise walk leaves the inside area...
+			if (!inside(edge) || inside(edge + 1))
+				continue;
+
+			// ... and ends where it enters it again. Saddles keep the center connected to its side.
+			int target = (edge + 1) % 4;
+			if (crossingCount == 4 && !centerInside)
+				target = (edge + 3) % 4;
+			else
+			{
+				while (inside(target) || !inside(target + 1))
+					target = (target + 1) % 4;
+			}
+
+			segments.from[segments.count]	= static_cast<std::uint8_t>(edge);
+			segments.to[segments.count]		= static_cast<std::uint8_t>(target);
+			++segments.count;
+		}
+	}
+	return cases;
+}
+
+constexpr std::array<ContourCellSegments, 32> cxContourCases = makeContourCases();
+
+/// <summary>
+/// Piece of a ring traced within a single band.
+/// </summary>
+struct ContourChain
+{
+	static constexpr std::size_t noSeam = std::numeric_limits<std::size_t>::max();
+
+	std::size_t band;
+	std::size_t pointBegin, pointEnd;	// Range within point buffer of the band.
+	std::size_t startSeam = noSeam;		// Lattice edge the chain enters the band through.
+	std::size_t endSeam = noSeam;		// Lattice edge the chain leaves the band through.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType signedArea(std::vector< Vector2<TValueType> > const & points_)
+{
+	TValueType area = 0;
+	for (std::size_t i = 0, j = points_.size() - 1; i < points_.size(); j = i++)
+		area += points_[j].x * points_[i].y - points_[i].x * points_[j].y;
+	return area / TValueType(2);
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::vector< Contour2<TValueType> > extractContours(ScalarGrid2<TValueType> const & grid_, TValueType const isoValue_,
+													std::size_t const threadCount_)
+{
+	using VectorType = Vector2<TValueType>;
+
+	std::vector< Contour2<TValueType> > contours;
+
+	std::size_t const width		= grid_.getResolution().x;
+	std::size_t const height	= grid_.getResolution().y;
+	if (width == 0 || height == 0)
+		return contours;
+
+	// Lattice is padded with a ring of virtual samples that are always outside, so every contour is closed.
+	std::size_t const latticeWidth	= width + 2;
+	std::size_t const latticeHeight	= height + 2;
+	std::size_t const cellsWidth	= latticeWidth - 1;
+	std::size_t const cellsHeight	= latticeHeight - 1;
+
+	VectorType const cellSize	= grid_.getCellSize();
+	VectorType const origin		= grid_.getRegion().center - grid_.getRegion().getHalfExtent();
+
+	auto isVirtual = [&](std::size_t const x_, std::size_t const y_) {
+			return x_ == 0 || y_ == 0 || x_ == latticeWidth - 1 || y_ == latticeHeight - 1;
+		};
+	auto isInside = [&](std::size_t const x_, std::size_t const y_) {
+			return !isVirtual(x_, y_) && grid_.at(x_ - 1, y_ - 1) > isoValue_;
+		};
+	auto latticePosition = [&](std::size_t const x_, std::size_t const y_) {
+			return origin + VectorType{
+					(static_cast<TValueType>(x_) - TValueType(0.5)) * cellSize.x,
+					(static_cast<TValueType>(y_) - TValueType(0.5)) * cellSize.y
+				};
+		};
+
+	// Offsets of the corners of every edge, in edge direction.
+	constexpr std::size_t cxEdgeCorners[4][2][2] = {
+			{ { 0, 0 }, { 1, 0 } },
+			{ { 1, 0 }, { 1, 1 } },
+			{ { 1, 1 }, { 0, 1 } },
+			{ { 0, 1 }, { 0, 0 } }
+		};
+
+	auto crossing = [&](std::size_t const cellX_, std::size_t const cellY_, std::uint8_t const edge_) {
+			// Interpolate in canonical direction, so both cells sharing an edge compute the same point.
+			std::size_t ax = cellX_ + cxEdgeCorners[edge_][0][0], ay = cellY_ + cxEdgeCorners[edge_][0][1];
+			std::size_t bx = cellX_ + cxEdgeCorners[edge_][1][0], by = cellY_ + cxEdgeCorners[edge_][1][1];
+			if (ax > bx || ay > by)
+			{
+				std::swap(ax, bx);
+				std::swap(ay, by);
+			}
+
+			VectorType const a = latticePosition(ax, ay), b = latticePosition(bx, by);
+			if (isVirtual(ax, ay) || isVirtual(bx, by))
+				return (a + b) / TValueType(2);
+
+			TValueType const va = grid_.at(ax - 1, ay - 1), vb = grid_.at(bx - 1, by - 1);
+			return a + (b - a) * ((isoValue_ - va) / (vb - va));
+		};
+
+	std::vector<std::uint8_t> codes(cellsWidth * cellsHeight);
+
+	std::size_t const bandCount = priv::parallelChunkCount(cellsHeight, threadCount_);
+	std::vector< std::vector<VectorType> >		bandPoints(bandCount);
+	std::vector< std::vector<priv::ContourChain> >	bandChains(bandCount);
+
+	priv::parallelFor(cellsHeight, threadCount_,
+		[&](std::size_t const rowBegin_, std::size_t const rowEnd_, std::size_t const band_)
+		{
+			// Classify cells of the band:
+			for (std::size_t y = rowBegin_; y < rowEnd_; ++y)
+			{
+				for (std::size_t x = 0; x < cellsWidth; ++x)
+				{
+					std::uint8_t code =
+						(isInside(x, y)			? 1 : 0) |
+						(isInside(x + 1, y)		? 2 : 0) |
+						(isInside(x + 1, y + 1)	? 4 : 0) |
+						(isInside(x, y + 1)		? 8 : 0);
+
+					if (code == 5 || code == 10)
+					{
+						TValueType const center = (grid_.at(x - 1, y - 1) + grid_.at(x, y - 1) + grid_.at(x, y) + grid_.at(x - 1, y)) / TValueType(4);
+						if (center > isoValue_)
+							code |= priv::cxContourCenterBit;
+					}
+					codes[y * cellsWidth + x] = code;
+				}
+			}
+
+			auto & points = bandPoints[band_];
+			auto & chains = bandChains[band_];
+
+			auto segmentsOf = [&](std::size_t const cell_) -> priv::ContourCellSegments const & {
+					return priv::cxContourCases[codes[cell_] & priv::cxContourCaseMask];
+				};
+
+			// Moves across the edge; returns false when the neighbour is outside of the band.
+			auto step = [&](std::size_t & x_, std::size_t & y_, std::uint8_t const edge_) {
+					switch (edge_)
+					{
+					case priv::cxContourBottom:	{ if (y_ == rowBegin_) return false; --y_; break; }
+					case priv::cxContourRight:	{ ++x_; break; }
+					case priv::cxContourTop:	{ if (y_ + 1 == rowEnd_) return false; ++y_; break; }
+					default:					{ --x_; break; }
+					}
+					return true;
+				};
+			auto seamId = [&](std::size_t const x_, std::size_t const y_, std::uint8_t const edge_) {
+					// Horizontal lattice edge id.
+					return (edge_ == priv::cxContourTop ? y_ + 1 : y_) * cellsWidth + x_;
+				};
+
+			for (std::size_t y = rowBegin_; y < rowEnd_; ++y)
+			{
+				for (std::size_t x = 0; x < cellsWidth; ++x)
+				{
+					for (std::uint8_t s = 0; s < segmentsOf(y * cellsWidth + x).count; ++s)
+					{
+						if (codes[y * cellsWidth + x] & (priv::cxContourVisitedBit << s))
+							continue;
+
+						priv::ContourChain chain;
+						chain.band = band_;
+
+						// Walk backwards to the beginning of the chain (band seam) or around the whole ring.
+						std::size_t cx = x, cy = y;
+						std::uint8_t cs = s;
+						for (;;)
+						{
+							std::uint8_t const fromEdge = segmentsOf(cy * cellsWidth + cx).from[cs];
+							std::size_t nx = cx, ny = cy;
+							if (!step(nx, ny, fromEdge))
+							{
+								chain.startSeam = seamId(cx, cy, fromEdge);
+								break;
+							}
+
+							std::uint8_t const entry = static_cast<std::uint8_t>((fromEdge + 2) % 4);
+							auto const & neighbour = segmentsOf(ny * cellsWidth + nx);
+							std::uint8_t ns = 0;
+							while (neighbour.to[ns] != entry)
+								++ns;
+
+							if (nx == x && ny == y && ns == s)
+								break;
+							cx = nx; cy = ny; cs = ns;
+						}
+
+						// Walk forward, emitting start point of every segment.
+						std::size_t const startX = cx, startY = cy;
+						std::uint8_t const startS = cs;
+						chain.pointBegin = points.size();
+						for (;;)
+						{
+							std::size_t const cell = cy * cellsWidth + cx;
+							codes[cell] |= static_cast<std::uint8_t>(priv::cxContourVisitedBit << cs);
+							points.push_back(crossing(cx, cy, segmentsOf(cell).from[cs]));
+
+							std::uint8_t const toEdge = segmentsOf(cell).to[cs];
+							if (!step(cx, cy, toEdge))
+							{
+								chain.endSeam = seamId(cx, cy, toEdge);
+								break;
+							}
+
+							std::uint8_t const entry = static_cast<std::uint8_t>((toEdge + 2) % 4);
+							auto const & neighbour = segmentsOf(cy * cellsWidth + cx);
+							cs = 0;
+							while (neighbour.from[cs] != entry)
+								++cs;
+
+							if (cx == startX && cy == startY && cs == startS)
+								break;
+						}
+						chain.pointEnd = points.size();
+						chains.push_back(chain);
+					}
+				}
+			}
+		});
+
+	// Stitch chains across band seams:
+	std::vector< std::pair<std::size_t, priv::ContourChain const *> > openChains;
+	for (auto const & chains : bandChains)
+	{
+		for (auto const & chain : chains)
+		{
+			if (chain.startSeam != priv::ContourChain::noSeam)
+				openChains.emplace_back(chain.startSeam, &chain);
+		}
+	}
+	std::sort(openChains.begin(), openChains.end(), [](auto const & lhs_, auto const & rhs_) { return lhs_.first < rhs_.first; });
+
+	auto appendPoints = [&](std::vector<VectorType> & ring_, priv::ContourChain const & chain_) {
+			auto const & points = bandPoints[chain_.band];
+			ring_.insert(ring_.end(), points.begin() + chain_.pointBegin, points.begin() + chain_.pointEnd);
+		};
+
+	std::vector<bool> usedOpenChains(openChains.size(), false);
+	for (auto const & chains : bandChains)
+	{
+		for (auto const & chain : chains)
+		{
+			std::vector<VectorType> ring;
+			if (chain.startSeam == priv::ContourChain::noSeam)
+				appendPoints(ring, chain);
+			else
+			{
+				auto next = std::lower_bound(openChains.begin(), openChains.end(), chain.startSeam,
+					[](auto const & entry_, std::size_t const seam_) { return entry_.first < seam_; });
+				if (usedOpenChains[next - openChains.begin()])
+					continue;
+
+				while (!usedOpenChains[next - openChains.begin()])
+				{
+					usedOpenChains[next - openChains.begin()] = true;
+					appendPoints(ring, *next->second);
+					next = std::lower_bound(openChains.begin(), openChains.end(), next->second->endSeam,
+						[](auto const & entry_, std::size_t const seam_) { return entry_.first < seam_; });
+				}
+			}
+
+			Contour2<TValueType> contour;
+			contour.hole = priv::signedArea(ring) < TValueType(0);
+			contour.ring = Polygon2<TValueType>{ std::move(ring) };
+			contours.push_back(std::move(contour));
+		}
+	}
+
+	// Find innermost enclosing ring of every ring. Rings never cross, so testing a single point is enough.
+	std::vector<TValueType> areas(contours.size());
+	std::vector< std::pair<VectorType, VectorType> > bounds(contours.size());
+	for (std::size_t i = 0; i < contours.size(); ++i)
+	{
+		auto const & points = contours[i].ring.getPoints();
+		areas[i] = std::abs(priv::signedArea(points));
+		bounds[i] = { points.front(), points.front() };
+		for (auto const & point : points)
+		{
+			bounds[i].first = VectorType::lowerBounds(bounds[i].first, point);
+			bounds[i].second = VectorType::upperBounds(bounds[i].second, point);
+		}
+	}
+
+	for (std::size_t i = 0; i < contours.size(); ++i)
+	{
+		VectorType const & point = contours[i].ring.getPoints().front();
+		for (std::size_t j = 0; j < contours.size(); ++j)
+		{
+			if (j == i || areas[j] <= areas[i] ||
+				point.x < bounds[j].first.x || point.y < bounds[j].first.y ||
+				point.x > bounds[j].second.x || point.y > bounds[j].second.y)
+			{
+				continue;
+			}
+
+			std::size_t const parent = contours[i].parent;
+			if ((parent == Contour2<TValueType>::noParent || areas[j] < areas[parent]) && isPointInside(contours[j].ring, point))
+				contours[i].parent = j;
+		}
+	}
+	return contours;
+}
+
+}
\ No newline at end of file
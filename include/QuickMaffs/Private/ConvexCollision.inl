@@ -0,0 +1,635 @@
+// Note: this file is not meant to be included on its own.
+// Include "ConvexCollision.hpp" instead.
+
+namespace quickmaffs
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> typename TVectorType, typename TValueType>
+ConvexHull< TVectorType, TValueType >::ConvexHull(std::vector<VectorType> vertices_)
+	:
+	vertices{ std::move(vertices_) }
+{
+}
+
+namespace priv
+{
+
+// Maximum number of GJK iterations; reached only by nearly touching shapes, which are then reported as touching.
+constexpr int cxGjkMaxIterations = 64;
+
+// Maximum number of EPA expansions.
+constexpr int cxEpaMaxIterations = 128;
+
+// Polygons with at most this many vertices are tested with separating axis test instead of GJK.
+constexpr std::size_t cxSatVertexLimit = 8;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns relative tolerance of EPA convergence and degeneracy tests.
+/// </summary>
+template <typename TValueType>
+TValueType convexTolerance()
+{
+	return std::sqrt(std::numeric_limits<TValueType>::epsilon());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns the vertex farthest along the direction.
+/// </summary>
+template <typename TVectorType>
+TVectorType supportVertex(std::vector<TVectorType> const & vertices_, TVectorType const & direction_)
+{
+	std::size_t best = 0;
+	auto bestDistance = vertices_[0].dot(direction_);
+	for (std::size_t i = 1; i < vertices_.size(); ++i)
+	{
+		auto const distance = vertices_[i].dot(direction_);
+		if (distance > bestDistance)
+		{
+			bestDistance = distance;
+			best = i;
+		}
+	}
+	return vertices_[best];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns the component of `vector_` perpendicular to `edge_`.
+/// </summary>
+template <typename TVectorType>
+TVectorType perpendicularComponent(TVectorType const & edge_, TVectorType const & vector_)
+{
+	auto const lengthSquared = edge_.lengthSquared();
+	if (lengthSquared == 0)
+		return vector_;
+	return vector_ - edge_ * (edge_.dot(vector_) / lengthSquared);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Simplex of GJK: up to dimensions + 1 points of the Minkowski difference, the newest last.
+/// </summary>
+template <typename TVectorType>
+struct GjkSimplex
+{
+	static constexpr std::size_t Dimensions = TVectorType{}.size();
+
+	void push(TVectorType const & point_)
+	{
+		points[size++] = point_;
+	}
+
+	void assign(std::initializer_list<TVectorType> points_)
+	{
+		size = 0;
+		for (auto const & point : points_)
+			push(point);
+	}
+
+	std::array<TVectorType, Dimensions + 1>	points;
+	std::size_t								size = 0;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Reduces the segment simplex (a newest) to its feature closest to the origin and points the direction at the origin.
+/// </summary>
+template <typename TVectorType>
+void reduceSegment(GjkSimplex<TVectorType> & simplex_, TVectorType const & a_, TVectorType const & b_, TVectorType & direction_)
+{
+	TVectorType const ab = b_ - a_;
+	TVectorType const ao = -a_;
+	if (ab.dot(ao) > 0)
+	{
+		simplex_.assign({ b_, a_ });
+		direction_ = perpendicularComponent(ab, ao);
+	}
+	else
+	{
+		simplex_.assign({ a_ });
+		direction_ = ao;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Reduces the triangle simplex (a newest) in 3D, see <see cref="reduceSegment"/>.
+/// </summary>
+template <typename V>
+void reduceTriangle(GjkSimplex< Vector3<V> > & simplex_, Vector3<V> const & a_, Vector3<V> const & b_, Vector3<V> const & c_,
+					Vector3<V> & direction_)
+{
+	Vector3<V> const ab = b_ - a_;
+	Vector3<V> const ac = c_ - a_;
+	Vector3<V> const ao = -a_;
+	Vector3<V> const normal = ab.cross(ac);
+
+	if (normal.cross(ac).dot(ao) > 0)
+	{
+		if (ac.dot(ao) > 0)
+		{
+			simplex_.assign({ c_, a_ });
+			direction_ = perpendicularComponent(ac, ao);
+		}
+		else
+			reduceSegment(simplex_, a_, b_, direction_);
+	}
+	else if (ab.cross(normal).dot(ao) > 0)
+		reduceSegment(simplex_, a_, b_, direction_);
+	else if (normal.dot(ao) >= 0)
+	{
+		simplex_.assign({ c_, b_, a_ });
+		direction_ = normal;
+	}
+	else
+	{
+		simplex_.assign({ b_, c_, a_ });
+		direction_ = -normal;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Reduces the simplex after a point was added. Returns whether the simplex contains the origin.
+/// </summary>
+template <typename TVectorType>
+bool evolveSimplex(GjkSimplex<TVectorType> & simplex_, TVectorType & direction_)
+{
+	constexpr std::size_t Dimensions = TVectorType{}.size();
+	auto const & points = simplex_.points;
+
+	if (simplex_.size == 2)
+		reduceSegment(simplex_, points[1], points[0], direction_);
+	else if constexpr (Dimensions == 2)
+	{
+		// Triangle: the origin is outside one of the edges at the newest point, or inside.
+		TVectorType const a = points[2], b = points[1], c = points[0];
+		TVectorType const ao = -a;
+		TVectorType const abOutside = -perpendicularComponent(b - a, c - a);
+		TVectorType const acOutside = -perpendicularComponent(c - a, b - a);
+		if (abOutside.dot(ao) > 0)
+		{
+			simplex_.assign({ b, a });
+			direction_ = abOutside;
+		}
+		else if (acOutside.dot(ao) > 0)
+		{
+			simplex_.assign({ c, a });
+			direction_ = acOutside;
+		}
+		else
+			return true;
+	}
+	else if (simplex_.size == 3)
+		reduceTriangle(simplex_, points[2], points[1], points[0], direction_);
+	else
+	{
+		// Tetrahedron: the origin is outside one of the faces at the newest point, or inside.
+		TVectorType const a = points[3], b = points[2], c = points[1], d = points[0];
+		TVectorType const ao = -a;
+		std::array<TVectorType, 3> const faces[] = { { b, c, d }, { c, d, b }, { d, b, c } };
+		for (auto const & [first, second, opposite] : faces)
+		{
+			TVectorType normal = (first - a).cross(second - a);
+			if (normal.dot(opposite - a) > 0)
+				normal = -normal;
+			if (normal.dot(ao) > 0)
+			{
+				reduceTriangle(simplex_, a, first, second, direction_);
+				return direction_.lengthSquared() == 0;
+			}
+		}
+		return true;
+	}
+	// The origin lies on the remaining feature.
+	return direction_.lengthSquared() == 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Runs GJK on the Minkowski difference given by its support function.
+/// Returns whether it contains the origin; `simplex_` then holds the final simplex, otherwise
+/// `direction_` receives the separating axis.
+/// </summary>
+template <typename TVectorType, typename TSupportFunction>
+bool runGjk(TSupportFunction const & support_, TVectorType & direction_, GjkSimplex<TVectorType> & simplex_)
+{
+	if (direction_.lengthSquared() == 0)
+		direction_[0] = 1;
+
+	simplex_.assign({ support_(direction_) });
+	if (simplex_.points[0].dot(direction_) < 0)
+		return false;
+
+	direction_ = -simplex_.points[0];
+	for (int iteration = 0; iteration < cxGjkMaxIterations; ++iteration)
+	{
+		if (direction_.lengthSquared() == 0)
+			return true;
+
+		TVectorType const point = support_(direction_);
+		if (point.dot(direction_) < 0)
+			return false;
+
+		simplex_.push(point);
+		if (evolveSimplex(simplex_, direction_))
+			return true;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Adds support points until the simplex has dimensions + 1 points not lying in a hyperplane.
+/// Returns false when the Minkowski difference has no volume (area in 2D) near the simplex.
+/// </summary>
+template <typename TVectorType, typename TSupportFunction>
+bool completeSimplex(TSupportFunction const & support_, GjkSimplex<TVectorType> & simplex_, typename TVectorType::ValueType const tolerance_)
+{
+	using V = typename TVectorType::ValueType;
+	constexpr std::size_t Dimensions = TVectorType{}.size();
+
+	// Adds the farthest of the support points along the directions and their opposites, if it leaves the current feature.
+	auto extend = [&](std::initializer_list<TVectorType> directions_, auto && distance_) {
+			for (TVectorType const & direction : directions_)
+			{
+				for (TVectorType const & signedDirection : { direction, -direction })
+				{
+					TVectorType const point = support_(signedDirection);
+					if (distance_(point) > tolerance_)
+					{
+						simplex_.push(point);
+						return true;
+					}
+				}
+			}
+			return false;
+		};
+
+	auto const & points = simplex_.points;
+	while (simplex_.size <= Dimensions)
+	{
+		bool extended = false;
+		if (simplex_.size == 1)
+		{
+			std::array<TVectorType, Dimensions> axes;
+			for (std::size_t d = 0; d < Dimensions; ++d)
+				axes[d][d] = V(1);
+			auto const distance = [&](TVectorType const & point_) { return (point_ - points[0]).length(); };
+			if constexpr (Dimensions == 2)
+				extended = extend({ axes[0], axes[1] }, distance);
+			else
+				extended = extend({ axes[0], axes[1], axes[2] }, distance);
+		}
+		else if (simplex_.size == 2)
+		{
+			TVectorType const edge = (points[1] - points[0]).normalize();
+			auto const distance = [&](TVectorType const & point_) { return perpendicularComponent(edge, point_ - points[0]).length(); };
+			if constexpr (Dimensions == 2)
+				extended = extend({ TVectorType{ -edge.y, edge.x } }, distance);
+			else
+			{
+				// Two directions perpendicular to the edge, built from the axis least aligned with it.
+				TVectorType axis;
+				std::size_t const least = std::abs(edge.x) <= std::abs(edge.y)
+										? (std::abs(edge.x) <= std::abs(edge.z) ? 0 : 2)
+										: (std::abs(edge.y) <= std::abs(edge.z) ? 1 : 2);
+				axis[least] = V(1);
+				TVectorType const first = edge.cross(axis).normalize();
+				extended = extend({ first, edge.cross(first) }, distance);
+			}
+		}
+		else
+		{
+			if constexpr (Dimensions == 3)
+			{
+				TVectorType const normal = (points[1] - points[0]).cross(points[2] - points[0]).normalize();
+				extended = extend({ normal }, [&](TVectorType const & point_) { return std::abs(normal.dot(point_ - points[0])); });
+			}
+		}
+		if (!extended)
+			return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Expands the triangle containing the origin towards the closest edge of the Minkowski difference (EPA in 2D).
+/// </summary>
+template <typename V, typename TSupportFunction>
+void expandPolytope(TSupportFunction const & support_, GjkSimplex< Vector2<V> > const & simplex_, V const tolerance_,
+					Penetration<Vector2, V> & result_)
+{
+	std::vector< Vector2<V> > polygon(simplex_.points.begin(), simplex_.points.end());
+	if ((polygon[1] - polygon[0]).cross(polygon[2] - polygon[0]) < 0)
+		std::swap(polygon[1], polygon[2]);
+
+	for (int iteration = 0; iteration < cxEpaMaxIterations; ++iteration)
+	{
+		// Counterclockwise polygon: outward normal of edge (x, y) is (y, -x).
+		std::size_t closest = 0;
+		V closestDistance = std::numeric_limits<V>::infinity();
+		Vector2<V> closestNormal;
+		for (std::size_t i = 0; i < polygon.size(); ++i)
+		{
+			Vector2<V> const edge = polygon[(i + 1) % polygon.size()] - polygon[i];
+			V const length = edge.length();
+			if (length == 0)
+				continue;
+			Vector2<V> const normal{ edge.y / length, -edge.x / length };
+			V const distance = normal.dot(polygon[i]);
+			if (distance < closestDistance)
+			{
+				closestDistance = distance;
+				closestNormal = normal;
+				closest = i;
+			}
+		}
+
+		result_.depth = std::max(closestDistance, V(0));
+		result_.normal = closestNormal;
+
+		Vector2<V> const point = support_(closestNormal);
+		if (point.dot(closestNormal) - closestDistance <= tolerance_)
+			return;
+		polygon.insert(polygon.begin() + static_cast<std::ptrdiff_t>(closest + 1), point);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Expands the tetrahedron containing the origin towards the closest face of the Minkowski difference (EPA in 3D).
+/// </summary>
+template <typename V, typename TSupportFunction>
+void expandPolytope(TSupportFunction const & support_, GjkSimplex< Vector3<V> > const & simplex_, V const tolerance_,
+					Penetration<Vector3, V> & result_)
+{
+	struct Face
+	{
+		std::array<std::size_t, 3>	vertices;
+		Vector3<V>					normal;
+		V							distance;
+	};
+
+	std::vector< Vector3<V> > vertices(simplex_.points.begin(), simplex_.points.end());
+	std::vector<Face> faces;
+
+	// Faces are wound counterclockwise seen from outside; degenerate ones are never the closest.
+	auto addFace = [&](std::size_t const a_, std::size_t const b_, std::size_t const c_) {
+			Vector3<V> normal = (vertices[b_] - vertices[a_]).cross(vertices[c_] - vertices[a_]);
+			V const length = normal.length();
+			V distance = std::numeric_limits<V>::infinity();
+			if (length > 0)
+			{
+				normal /= length;
+				distance = normal.dot(vertices[a_]);
+			}
+			faces.push_back(Face{ { a_, b_, c_ }, normal, distance });
+		};
+
+	Vector3<V> const centroid = (vertices[0] + vertices[1] + vertices[2] + vertices[3]) / V(4);
+	std::array<std::size_t, 3> const tetrahedron[] = { { 0, 1, 2 }, { 0, 3, 1 }, { 0, 2, 3 }, { 1, 3, 2 } };
+	for (auto const & [a, b, c] : tetrahedron)
+	{
+		bool const inward = (vertices[b] - vertices[a]).cross(vertices[c] - vertices[a]).dot(vertices[a] - centroid) < 0;
+		addFace(a, inward ? c : b, inward ? b : c);
+	}
+
+	std::vector< std::pair<std::size_t, std::size_t> > horizon;
+	for (int iteration = 0; iteration < cxEpaMaxIterations; ++iteration)
+	{
+		auto const closest = std::min_element(faces.begin(), faces.end(),
+			[](Face const & lhs_, Face const & rhs_) { return lhs_.distance < rhs_.distance; });
+
+		result_.depth = std::max(closest->distance, V(0));
+		result_.normal = closest->normal;
+
+		Vector3<V> const point = support_(closest->normal);
+		if (point.dot(closest->normal) - closest->distance <= tolerance_)
+			return;
+
+		// Remove the faces the point sees; their edges not shared with another removed face form the horizon.
+		horizon.clear();
+		for (std::size_t f = 0; f < faces.size();)
+		{
+			Face const & face = faces[f];
+			if (face.normal.dot(point - vertices[face.vertices[0]]) <= 0)
+			{
+				++f;
+				continue;
+			}
+			for (std::size_t k = 0; k < 3; ++k)
+			{
+				std::pair<std::size_t, std::size_t> const edge{ face.vertices[k], face.vertices[(k + 1) % 3] };
+				auto const reverse = std::find(horizon.begin(), horizon.end(), std::make_pair(edge.second, edge.first));
+				if (reverse != horizon.end())
+					horizon.erase(reverse);
+				else
+					horizon.push_back(edge);
+			}
+			faces[f] = faces.back();
+			faces.pop_back();
+		}
+		if (horizon.empty())
+			return;
+
+		vertices.push_back(point);
+		for (auto const & [first, second] : horizon)
+			addFace(first, second, vertices.size() - 1);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Runs GJK, and EPA when `computeDepth_` is set, on the vertex sets.
+/// </summary>
+template <template<typename> typename T, typename V>
+Penetration<T, V> penetrateVertices(std::vector< T<V> > const & first_, std::vector< T<V> > const & second_,
+									SeparatingAxisCache<T, V> * cache_, bool const computeDepth_)
+{
+	Penetration<T, V> result;
+	if (first_.empty() || second_.empty())
+		return result;
+
+	auto const support = [&](T<V> const & direction_) {
+			return supportVertex(first_, direction_) - supportVertex(second_, -direction_);
+		};
+
+	T<V> direction = (cache_ && cache_->axis.lengthSquared() > 0) ? cache_->axis : second_[0] - first_[0];
+	GjkSimplex< T<V> > simplex;
+	if (!runGjk(support, direction, simplex))
+	{
+		result.normal = direction.normalize();
+		if (cache_)
+			cache_->axis = result.normal;
+		return result;
+	}
+
+	result.intersecting = true;
+	if (!computeDepth_)
+		return result;
+
+	V scale = V(1);
+	for (std::size_t i = 0; i < simplex.size; ++i)
+		scale = std::max(scale, simplex.points[i].length());
+	V const tolerance = convexTolerance<V>() * scale;
+
+	if (completeSimplex(support, simplex, tolerance))
+		expandPolytope(support, simplex, tolerance, result);
+	else
+	{
+		// Touching flat shapes: zero depth along any normal.
+		result.normal = direction.lengthSquared() > 0 ? direction.normalize() : T<V>{};
+		if (result.normal.lengthSquared() == 0)
+			result.normal[0] = V(1);
+	}
+
+	if (cache_)
+		cache_->axis = result.normal;
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Projects the polygon on the axis.
+/// </summary>
+template <typename V>
+std::pair<V, V> projectPolygon(std::vector< Vector2<V> > const & points_, Vector2<V> const & axis_)
+{
+	V lower = points_[0].dot(axis_);
+	V upper = lower;
+	for (std::size_t i = 1; i < points_.size(); ++i)
+	{
+		V const distance = points_[i].dot(axis_);
+		lower = std::min(lower, distance);
+		upper = std::max(upper, distance);
+	}
+	return { lower, upper };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Separating axis test of two convex polygons on the edge normals of both.
+/// </summary>
+template <typename V>
+Penetration<Vector2, V> penetratePolygonsSat(std::vector< Vector2<V> > const & first_, std::vector< Vector2<V> > const & second_,
+											 SeparatingAxisCache<Vector2, V> * cache_)
+{
+	Penetration<Vector2, V> result;
+
+	// Overlaps along the axis when moving the second polygon forward or backward; negative when separated.
+	auto overlaps = [&](Vector2<V> const & axis_) {
+			auto const [firstLower, firstUpper] = projectPolygon(first_, axis_);
+			auto const [secondLower, secondUpper] = projectPolygon(second_, axis_);
+			return std::pair<V, V>{ firstUpper - secondLower, secondUpper - firstLower };
+		};
+
+	auto separate = [&](Vector2<V> const & axis_, V const forward_) {
+			result.normal = forward_ < 0 ? axis_ : -axis_;
+			if (cache_)
+				cache_->axis = result.normal;
+			return result;
+		};
+
+	if (cache_ && cache_->axis.lengthSquared() > 0)
+	{
+		Vector2<V> const axis = cache_->axis.normalize();
+		auto const [forward, backward] = overlaps(axis);
+		if (forward < 0 || backward < 0)
+			return separate(axis, forward);
+	}
+
+	result.depth = std::numeric_limits<V>::infinity();
+	for (auto const * polygon : { &first_, &second_ })
+	{
+		for (std::size_t i = 0; i < polygon->size(); ++i)
+		{
+			Vector2<V> const edge = (*polygon)[(i + 1) % polygon->size()] - (*polygon)[i];
+			V const length = edge.length();
+			if (length == 0)
+				continue;
+
+			Vector2<V> const axis{ -edge.y / length, edge.x / length };
+			auto const [forward, backward] = overlaps(axis);
+			if (forward < 0 || backward < 0)
+				return separate(axis, forward);
+
+			V const overlap = std::min(forward, backward);
+			if (overlap < result.depth)
+			{
+				result.depth = overlap;
+				result.normal = forward <= backward ? axis : -axis;
+			}
+		}
+	}
+
+	// Polygons without edges (single points) overlap only when equal.
+	if (result.depth == std::numeric_limits<V>::infinity())
+	{
+		result.depth = V(0);
+		result.normal = Vector2<V>{ V(1), V(0) };
+		if (first_[0] != second_[0])
+			return separate((second_[0] - first_[0]).normalize(), V(-1));
+	}
+
+	result.intersecting = true;
+	if (cache_)
+		cache_->axis = result.normal;
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Tests the polygons with separating axis test when small, with GJK and EPA otherwise.
+/// </summary>
+template <typename V>
+Penetration<Vector2, V> penetratePolygons(Polygon2<V> const & first_, Polygon2<V> const & second_,
+										  SeparatingAxisCache<Vector2, V> * cache_, bool const computeDepth_)
+{
+	static_assert(std::is_floating_point_v<V>, "Convex tests require floating point type");
+
+	auto const & first = first_.getPoints();
+	auto const & second = second_.getPoints();
+	if (first.empty() || second.empty())
+		return Penetration<Vector2, V>{};
+
+	if (first.size() <= cxSatVertexLimit && second.size() <= cxSatVertexLimit)
+		return penetratePolygonsSat(first, second, cache_);
+	return penetrateVertices<Vector2, V>(first, second, cache_, computeDepth_);
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+bool intersects(Polygon2<V> const & first_, Polygon2<V> const & second_, SeparatingAxisCache<Vector2, V> * cache_)
+{
+	return priv::penetratePolygons(first_, second_, cache_, false).intersecting;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+bool intersects(ConvexHull<T, V> const & first_, ConvexHull<T, V> const & second_, SeparatingAxisCache<T, V> * cache_)
+{
+	return priv::penetrateVertices(first_.vertices, second_.vertices, cache_, false).intersecting;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+Penetration<Vector2, V> computePenetration(Polygon2<V> const & first_, Polygon2<V> const & second_, SeparatingAxisCache<Vector2, V> * cache_)
+{
+	return priv::penetratePolygons(first_, second_, cache_, true);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+Penetration<T, V> computePenetration(ConvexHull<T, V> const & first_, ConvexHull<T, V> const & second_, SeparatingAxisCache<T, V> * cache_)
+{
+	return priv::penetrateVertices(first_.vertices, second_.vertices, cache_, true);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,733 @@
+// Note: this file is not meant to be included on its own.
+// Include "Delaunay.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns next half-edge of the same triangle.
+/// </summary>
+inline std::size_t nextHalfEdge(std::size_t const edge_)
+{
+	return (edge_ % 3 == 2) ? edge_ - 2 : edge_ + 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns previous half-edge of the same triangle.
+/// </summary>
+inline std::size_t prevHalfEdge(std::size_t const edge_)
+{
+	return (edge_ % 3 == 0) ? edge_ + 2 : edge_ - 1;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Checks whether the two points are exactly equal.
+/// </summary>
+template <typename TValueType>
+bool isSamePoint(Vector2<TValueType> const & lhs_, Vector2<TValueType> const & rhs_)
+{
+	return lhs_.x == rhs_.x && lhs_.y == rhs_.y;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns monotonic substitute of the angle of the direction, in range [0, 1).
+/// </summary>
+template <typename TValueType>
+TValueType pseudoAngle(Vector2<TValueType> const & direction_)
+{
+	TValueType const sum = std::abs(direction_.x) + std::abs(direction_.y);
+	if (sum == TValueType(0))
+		return TValueType(0);
+
+	TValueType const p = direction_.x / sum;
+	return (direction_.y > TValueType(0) ? TValueType(3) - p : TValueType(1) + p) / TValueType(4);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns offset of the circumcenter of the triangle from its first vertex.
+/// </summary>
+template <typename TValueType>
+Vector2<TValueType> circumcenterOffset(Vector2<TValueType> const & a_, Vector2<TValueType> const & b_, Vector2<TValueType> const & c_)
+{
+	Vector2<TValueType> const ab = b_ - a_;
+	Vector2<TValueType> const ac = c_ - a_;
+	TValueType const abLength = ab.lengthSquared();
+	TValueType const acLength = ac.lengthSquared();
+	TValueType const scale = TValueType(0.5) / (ab.x * ac.y - ab.y * ac.x);
+
+	return { (ac.y * abLength - ab.y * acLength) * scale, (ab.x * acLength - ac.x * abLength) * scale };
+}
+
+/// <summary>
+/// Radial sweep state. Works on points copied in sweep order, indices are positions in that order.
+/// </summary>
+template <typename TValueType>
+class DelaunaySweep
+{
+public:
+	using VectorType = Vector2<TValueType>;
+
+	static constexpr std::size_t npos = DelaunayTriangulation::noEdge;
+
+	DelaunaySweep(std::vector<VectorType> const & points_, VectorType const & center_)
+		: m_points(points_),
+		m_center(center_),
+		m_hashSize(std::max<std::size_t>(1, static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(points_.size())))))),
+		m_hullNext(points_.size(), npos),
+		m_hullPrev(points_.size(), npos),
+		m_hullTri(points_.size(), npos),
+		m_hullHash(m_hashSize, npos)
+	{
+		std::size_t const maxTriangles = points_.size() > 2 ? 2 * points_.size() - 5 : 0;
+		m_triangles.reserve(maxTriangles * 3);
+		m_halfEdges.reserve(maxTriangles * 3);
+	}
+
+	/// <summary>
+	/// Sweeps the points. Points 0, 1 and 2 form the counterclockwise seed triangle, the rest is sorted by distance from the center.
+	/// </summary>
+	void run()
+	{
+		std::size_t const count = m_points.size();
+
+		this->addTriangle(0, 1, 2, npos, npos, npos);
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			m_hullNext[i] = (i + 1) % 3;
+			m_hullPrev[i] = (i + 2) % 3;
+			m_hullTri[i] = i;
+			m_hullHash[this->hashKey(m_points[i])] = i;
+		}
+		m_hullStart = 0;
+
+		for (std::size_t i = 3; i < count; ++i)
+		{
+			VectorType const & point = m_points[i];
+			if (isSamePoint(point, m_points[i - 1]))
+				continue;
+
+			// Find a visible hull edge, starting near the point's angle:
+			std::size_t start = 0;
+			for (std::size_t j = 0, key = this->hashKey(point); j < m_hashSize; ++j)
+			{
+				start = m_hullHash[(key + j) % m_hashSize];
+				if (start != npos && m_hullNext[start] != start)
+					break;
+			}
+			start = m_hullPrev[start];
+
+			std::size_t e = start;
+			while (!this->isVisible(point, e, m_hullNext[e]))
+			{
+				e = m_hullNext[e];
+				if (e == start)
+				{
+					e = npos;
+					break;
+				}
+			}
+			if (e == npos)
+			{
+				// Rounding of the sweep order can put the point inside the hull; it splits the triangle it lies in.
+				this->insertInside(i, m_hullTri[start]);
+				continue;
+			}
+
+			// First triangle, then walk forward and backward along the hull:
+			std::size_t t = this->addTriangle(e, i, m_hullNext[e], npos, npos, m_hullTri[e]);
+			m_hullTri[e] = t;
+			m_hullTri[i] = t + 1;
+			this->legalize(t + 2);
+
+			std::size_t n = m_hullNext[e];
+			while (this->isVisible(point, n, m_hullNext[n]))
+			{
+				std::size_t const q = m_hullNext[n];
+				t = this->addTriangle(n, i, q, m_hullTri[i], npos, m_hullTri[n]);
+				m_hullTri[i] = t + 1;
+				this->legalize(t + 2);
+				m_hullNext[n] = n; // Removed from the hull.
+				n = q;
+			}
+
+			if (e == start)
+			{
+				while (this->isVisible(point, m_hullPrev[e], e))
+				{
+					std::size_t const q = m_hullPrev[e];
+					t = this->addTriangle(q, i, e, npos, m_hullTri[e], m_hullTri[q]);
+					m_hullTri[q] = t;
+					this->legalize(t + 2);
+					m_hullNext[e] = e;
+					e = q;
+				}
+			}
+
+			m_hullStart = e;
+			m_hullPrev[i] = e;
+			m_hullNext[e] = i;
+			m_hullPrev[n] = i;
+			m_hullNext[i] = n;
+
+			m_hullHash[this->hashKey(point)] = i;
+			m_hullHash[this->hashKey(m_points[e])] = e;
+		}
+	}
+
+	std::vector<std::size_t> & triangles() { return m_triangles; }
+	std::vector<std::size_t> & halfEdges() { return m_halfEdges; }
+
+	/// <summary>
+	/// Returns the hull, counterclockwise.
+	/// </summary>
+	std::vector<std::size_t> hull() const
+	{
+		std::vector<std::size_t> result;
+		std::size_t e = m_hullStart;
+		do
+		{
+			result.push_back(e);
+			e = m_hullNext[e];
+		} while (e != m_hullStart);
+		return result;
+	}
+
+private:
+	bool isVisible(VectorType const & point_, std::size_t const from_, std::size_t const to_) const
+	{
+		return orientation(m_points[from_], m_points[to_], point_) < 0;
+	}
+
+	/// <summary>
+	/// Returns half-edge of the triangle containing the point, walking from the triangle of the half-edge.
+	/// When the point lies on an edge, that edge is returned. Returns npos when the point coincides with a vertex.
+	/// </summary>
+	std::size_t locate(VectorType const & point_, std::size_t const start_) const
+	{
+		auto test = [&](std::size_t const triangle_, std::size_t & next_) {
+				std::size_t onEdge = npos;
+				std::size_t zeros = 0;
+				for (std::size_t e = 3 * triangle_; e < 3 * triangle_ + 3; ++e)
+				{
+					auto const side = orientation(m_points[m_triangles[e]], m_points[m_triangles[nextHalfEdge(e)]], point_);
+					if (side < 0)
+					{
+						next_ = m_halfEdges[e];
+						return false;
+					}
+					if (side == 0)
+					{
+						onEdge = e;
+						++zeros;
+					}
+				}
+				next_ = zeros > 1 ? npos : (onEdge != npos ? onEdge : 3 * triangle_);
+				return true;
+			};
+
+		// Visibility walk; it ends in a Delaunay triangulation, the step limit only guards against rounding.
+		std::size_t const triangleCount = m_triangles.size() / 3;
+		std::size_t triangle = start_ / 3;
+		for (std::size_t step = 0; step < triangleCount; ++step)
+		{
+			std::size_t next = npos;
+			if (test(triangle, next))
+				return next;
+			if (next == npos)
+				break;
+			triangle = next / 3;
+		}
+
+		for (triangle = 0; triangle < triangleCount; ++triangle)
+		{
+			std::size_t next = npos;
+			if (test(triangle, next))
+				return next;
+		}
+		return npos;
+	}
+
+	/// <summary>
+	/// Inserts the point lying inside the hull: splits the triangle containing it into three,
+	/// or the two triangles sharing the edge it lies on into two each.
+	/// </summary>
+	void insertInside(std::size_t const point_, std::size_t const start_)
+	{
+		std::size_t const edge = this->locate(m_points[point_], start_);
+		if (edge == npos)
+			return; // Duplicate of a vertex.
+
+		std::size_t const base = edge - edge % 3;
+		if (edge == base && orientation(m_points[m_triangles[edge]], m_points[m_triangles[edge + 1]], m_points[point_]) != 0)
+		{
+			// Inside: (a, b, c) becomes (a, b, p), (b, c, p) and (c, a, p).
+			std::size_t const a = m_triangles[base], b = m_triangles[base + 1], c = m_triangles[base + 2];
+			std::size_t const hbc = m_halfEdges[base + 1], hca = m_halfEdges[base + 2];
+
+			m_triangles[base + 2] = point_;
+			std::size_t const s = this->addTriangle(b, c, point_, hbc, npos, base + 1);
+			std::size_t const v = this->addTriangle(c, a, point_, hca, base + 2, s + 1);
+			if (hbc == npos)
+				m_hullTri[b] = s;
+			if (hca == npos)
+				m_hullTri[c] = v;
+
+			this->legalize(base);
+			this->legalize(s);
+			this->legalize(v);
+			return;
+		}
+
+		// On edge (a, b) of triangle (a, b, c) and of its neighbour (b, a, d), if any:
+		// they become (a, p, c), (p, b, c) and (b, p, d), (p, a, d).
+		std::size_t const a = m_triangles[edge], b = m_triangles[nextHalfEdge(edge)], c = m_triangles[prevHalfEdge(edge)];
+		std::size_t const hbc = m_halfEdges[nextHalfEdge(edge)], hca = m_halfEdges[prevHalfEdge(edge)];
+		std::size_t const twin = m_halfEdges[edge];
+
+		m_triangles[base] = a;
+		m_triangles[base + 1] = point_;
+		m_triangles[base + 2] = c;
+		this->link(base + 2, hca);
+		if (hca == npos)
+			m_hullTri[c] = base + 2;
+		std::size_t const s = this->addTriangle(point_, b, c, npos, hbc, base + 1);
+		if (hbc == npos)
+			m_hullTri[b] = s + 1;
+
+		if (twin == npos)
+		{
+			// Hull edge: the point joins the hull between a and b.
+			m_halfEdges[base] = npos;
+			m_hullTri[a] = base;
+			m_hullTri[point_] = s;
+			m_hullNext[a] = point_;
+			m_hullPrev[point_] = a;
+			m_hullNext[point_] = b;
+			m_hullPrev[b] = point_;
+			m_hullHash[this->hashKey(m_points[point_])] = point_;
+
+			this->legalize(base + 2);
+			this->legalize(s + 1);
+			return;
+		}
+
+		std::size_t const twinBase = twin - twin % 3;
+		std::size_t const d = m_triangles[prevHalfEdge(twin)];
+		std::size_t const had = m_halfEdges[nextHalfEdge(twin)], hdb = m_halfEdges[prevHalfEdge(twin)];
+
+		m_triangles[twinBase] = b;
+		m_triangles[twinBase + 1] = point_;
+		m_triangles[twinBase + 2] = d;
+		this->link(twinBase, s);
+		this->link(twinBase + 2, hdb);
+		if (hdb == npos)
+			m_hullTri[d] = twinBase + 2;
+		std::size_t const w = this->addTriangle(point_, a, d, base, had, twinBase + 1);
+		if (had == npos)
+			m_hullTri[a] = w + 1;
+
+		this->legalize(base + 2);
+		this->legalize(s + 1);
+		this->legalize(twinBase + 2);
+		this->legalize(w + 1);
+	}
+
+	std::size_t hashKey(VectorType const & point_) const
+	{
+		auto const key = static_cast<std::size_t>(std::floor(pseudoAngle(point_ - m_center) * static_cast<TValueType>(m_hashSize)));
+		return key % m_hashSize;
+	}
+
+	void link(std::size_t const a_, std::size_t const b_)
+	{
+		m_halfEdges[a_] = b_;
+		if (b_ != npos)
+			m_halfEdges[b_] = a_;
+	}
+
+	std::size_t addTriangle(std::size_t const i0_, std::size_t const i1_, std::size_t const i2_,
+							std::size_t const a_, std::size_t const b_, std::size_t const c_)
+	{
+		std::size_t const t = m_triangles.size();
+		m_triangles.insert(m_triangles.end(), { i0_, i1_, i2_ });
+		m_halfEdges.insert(m_halfEdges.end(), 3, npos);
+		this->link(t, a_);
+		this->link(t + 1, b_);
+		this->link(t + 2, c_);
+		return t;
+	}
+
+	/// <summary>
+	/// Flips edges until the triangles around the edge satisfy the Delaunay condition.
+	/// </summary>
+	/// <remarks>
+	/// <para>
+	/// Triangle (pr, pl, p0) owns half-edge `a` (pr to pl), its neighbour (pl, pr, p1) owns the twin `b`.
+	/// If p1 lies inside the circumcircle of the first one, the shared edge is flipped to p0-p1
+	/// and the two outer edges of the neighbour are checked next.
+	/// </para>
+	/// </remarks>
+	void legalize(std::size_t a_)
+	{
+		m_edgeStack.clear();
+		while (true)
+		{
+			std::size_t const b = m_halfEdges[a_];
+			if (b != npos)
+			{
+				std::size_t const ar = prevHalfEdge(a_);
+				std::size_t const bl = prevHalfEdge(b);
+
+				std::size_t const p0 = m_triangles[ar];
+				std::size_t const pr = m_triangles[a_];
+				std::size_t const pl = m_triangles[nextHalfEdge(a_)];
+				std::size_t const p1 = m_triangles[bl];
+
+				if (inCircle(m_points[p0], m_points[pr], m_points[pl], m_points[p1]) > 0)
+				{
+					std::size_t const hbl = m_halfEdges[bl];
+					std::size_t const har = m_halfEdges[ar];
+
+					m_triangles[a_] = p1;
+					m_triangles[b] = p0;
+
+					// Hull edges that moved to another slot have to be tracked:
+					this->link(a_, hbl);
+					if (hbl == npos)
+						m_hullTri[p1] = a_;
+					this->link(b, har);
+					if (har == npos)
+						m_hullTri[p0] = b;
+					this->link(ar, bl);
+
+					m_edgeStack.push_back(nextHalfEdge(b));
+					continue;
+				}
+			}
+
+			if (m_edgeStack.empty())
+				break;
+			a_ = m_edgeStack.back();
+			m_edgeStack.pop_back();
+		}
+	}
+
+	std::vector<VectorType> const &	m_points;
+	VectorType						m_center;
+	std::size_t						m_hashSize;
+	std::size_t						m_hullStart = 0;
+
+	std::vector<std::size_t>		m_triangles;
+	std::vector<std::size_t>		m_halfEdges;
+	std::vector<std::size_t>		m_hullNext;
+	std::vector<std::size_t>		m_hullPrev;
+	std::vector<std::size_t>		m_hullTri;		// Half-edge of the hull edge starting at every hull point.
+	std::vector<std::size_t>		m_hullHash;
+	std::vector<std::size_t>		m_edgeStack;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Calls the function with index of every Delaunay neighbour of the point.
+/// </summary>
+template <typename TFunction>
+void forEachDelaunayNeighbour(DelaunayTriangulation const & triangulation_, std::size_t const point_, TFunction && function_)
+{
+	if (triangulation_.triangles.empty())
+	{
+		// Collinear input, the hull is the sorted line.
+		auto const & hull = triangulation_.hull;
+		std::size_t const position = triangulation_.hullPositions[point_];
+		if (position == DelaunayTriangulation::noEdge)
+			return;
+		if (position != 0)
+			function_(hull[position - 1]);
+		if (position + 1 != hull.size())
+			function_(hull[position + 1]);
+		return;
+	}
+
+	std::size_t const first = triangulation_.inEdges[point_];
+	if (first == DelaunayTriangulation::noEdge)
+		return;
+
+	std::size_t edge = first;
+	do
+	{
+		function_(triangulation_.triangles[edge]);
+		std::size_t const outgoing = nextHalfEdge(edge);
+		edge = triangulation_.halfEdges[outgoing];
+		if (edge == DelaunayTriangulation::noEdge)
+		{
+			function_(triangulation_.triangles[nextHalfEdge(outgoing)]);
+			break;
+		}
+	} while (edge != first);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Clips convex polygon to the half-plane where `normal_.dot(x - point_) <= 0`.
+/// </summary>
+template <typename TValueType>
+void clipConvexPolygon(std::vector< Vector2<TValueType> > & polygon_, std::vector< Vector2<TValueType> > & scratch_,
+						Vector2<TValueType> const & normal_, Vector2<TValueType> const & point_)
+{
+	scratch_.clear();
+	if (polygon_.empty())
+		return;
+
+	Vector2<TValueType> from = polygon_.back();
+	TValueType fromSide = normal_.dot(from - point_);
+	for (auto const & to : polygon_)
+	{
+		TValueType const toSide = normal_.dot(to - point_);
+		if ((fromSide <= TValueType(0)) != (toSide <= TValueType(0)))
+			scratch_.push_back(from + (to - from) * (fromSide / (fromSide - toSide)));
+		if (toSide <= TValueType(0))
+			scratch_.push_back(to);
+
+		from = to;
+		fromSide = toSide;
+	}
+	polygon_.swap(scratch_);
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+DelaunayTriangulation triangulateDelaunay(std::vector< Vector2<TValueType> > const & points_)
+{
+	static_assert(std::is_floating_point_v<TValueType>, "Delaunay triangulation requires floating point type");
+
+	using VectorType = Vector2<TValueType>;
+	constexpr std::size_t npos = DelaunayTriangulation::noEdge;
+
+	DelaunayTriangulation result;
+	std::size_t const count = points_.size();
+	if (count == 0)
+		return result;
+
+	// Seed triangle: point nearest to the center of bounds, its nearest neighbour, and the point with smallest circumcircle.
+	VectorType lower = points_[0], upper = points_[0];
+	for (auto const & point : points_)
+	{
+		lower = VectorType::lowerBounds(lower, point);
+		upper = VectorType::upperBounds(upper, point);
+	}
+	VectorType const boundsCenter = (lower + upper) / TValueType(2);
+
+	auto nearestTo = [&](VectorType const & target_, std::size_t const except_) {
+			std::size_t best = npos;
+			TValueType bestDistance = std::numeric_limits<TValueType>::infinity();
+			for (std::size_t i = 0; i < count; ++i)
+			{
+				TValueType const distance = target_.distanceSquared(points_[i]);
+				if (i != except_ && distance < bestDistance && !(except_ != npos && priv::isSamePoint(points_[i], points_[except_])))
+				{
+					best = i;
+					bestDistance = distance;
+				}
+			}
+			return best;
+		};
+
+	std::size_t const i0 = nearestTo(boundsCenter, npos);
+	std::size_t i1 = nearestTo(points_[i0], i0);
+	std::size_t i2 = npos;
+	if (i1 != npos)
+	{
+		TValueType minRadius = std::numeric_limits<TValueType>::infinity();
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (orientation(points_[i0], points_[i1], points_[i]) == 0)
+				continue;
+
+			TValueType const radius = priv::circumcenterOffset(points_[i0], points_[i1], points_[i]).lengthSquared();
+			if (radius < minRadius)
+			{
+				i2 = i;
+				minRadius = radius;
+			}
+		}
+	}
+
+	if (i2 == npos)
+	{
+		// All points are collinear (or coincide): no triangles, the hull is the sorted line without duplicates.
+		VectorType const axis = (i1 != npos) ? points_[i1] - points_[i0] : VectorType{ 1, 0 };
+		std::vector< std::pair<TValueType, std::size_t> > order(count);
+		for (std::size_t i = 0; i < count; ++i)
+			order[i] = { axis.dot(points_[i] - points_[i0]), i };
+		std::sort(order.begin(), order.end());
+
+		for (std::size_t i = 0; i < count; ++i)
+		{
+			if (i == 0 || !priv::isSamePoint(points_[order[i].second], points_[order[i - 1].second]))
+				result.hull.push_back(order[i].second);
+		}
+		result.inEdges.assign(count, npos);
+		result.hullPositions.assign(count, npos);
+		for (std::size_t i = 0; i < result.hull.size(); ++i)
+			result.hullPositions[result.hull[i]] = i;
+		return result;
+	}
+
+	if (orientation(points_[i0], points_[i1], points_[i2]) < 0)
+		std::swap(i1, i2);
+
+	// Sweep order: the seed first, then the rest by distance from the seed circumcenter.
+	VectorType const center = points_[i0] + priv::circumcenterOffset(points_[i0], points_[i1], points_[i2]);
+
+	std::vector< std::pair<TValueType, std::size_t> > order;
+	order.reserve(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		if (i != i0 && i != i1 && i != i2)
+			order.push_back({ center.distanceSquared(points_[i]), i });
+	}
+	std::sort(order.begin(), order.end(),
+		[&](auto const & lhs_, auto const & rhs_) {
+			// Equal points must end up adjacent so the sweep can skip them.
+			if (lhs_.first != rhs_.first)
+				return lhs_.first < rhs_.first;
+			auto const & lhsPoint = points_[lhs_.second];
+			auto const & rhsPoint = points_[rhs_.second];
+			return lhsPoint.x < rhsPoint.x || (lhsPoint.x == rhsPoint.x && lhsPoint.y < rhsPoint.y);
+		});
+
+	std::vector<std::size_t> ids;
+	ids.reserve(count);
+	ids.insert(ids.end(), { i0, i1, i2 });
+	for (auto const & entry : order)
+		ids.push_back(entry.second);
+
+	std::vector<VectorType> sorted(count);
+	for (std::size_t i = 0; i < count; ++i)
+		sorted[i] = points_[ids[i]];
+
+	priv::DelaunaySweep<TValueType> sweep(sorted, center);
+	sweep.run();
+
+	// Back to input indices:
+	result.triangles = std::move(sweep.triangles());
+	result.halfEdges = std::move(sweep.halfEdges());
+	for (auto & point : result.triangles)
+		point = ids[point];
+
+	result.hull = sweep.hull();
+	result.hullPositions.assign(count, npos);
+	for (std::size_t i = 0; i < result.hull.size(); ++i)
+	{
+		result.hull[i] = ids[result.hull[i]];
+		result.hullPositions[result.hull[i]] = i;
+	}
+
+	result.inEdges.assign(count, npos);
+	for (std::size_t e = 0; e < result.triangles.size(); ++e)
+	{
+		std::size_t const point = result.triangles[priv::nextHalfEdge(e)];
+		if (result.inEdges[point] == npos || result.halfEdges[e] == npos)
+			result.inEdges[point] = e;
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::size_t findNearestSite(std::vector< Vector2<TValueType> > const & points_, DelaunayTriangulation const & triangulation_,
+							Vector2<TValueType> const & query_, std::size_t startPoint_)
+{
+	if (points_.empty())
+		return DelaunayTriangulation::noEdge;
+
+	// Skipped duplicates have no neighbours to walk from.
+	bool const isTriangulated = !triangulation_.triangles.empty();
+	if (startPoint_ >= points_.size()
+		|| (isTriangulated ? triangulation_.inEdges[startPoint_] : triangulation_.hullPositions[startPoint_]) == DelaunayTriangulation::noEdge)
+		startPoint_ = isTriangulated ? triangulation_.triangles[0] : triangulation_.hull[0];
+
+	// Greedy walk on the Delaunay graph always ends at the nearest point.
+	std::size_t current = startPoint_;
+	TValueType currentDistance = query_.distanceSquared(points_[current]);
+	while (true)
+	{
+		std::size_t next = current;
+		priv::forEachDelaunayNeighbour(triangulation_, current,
+			[&](std::size_t const neighbour_)
+			{
+				TValueType const distance = query_.distanceSquared(points_[neighbour_]);
+				if (distance < currentDistance)
+				{
+					next = neighbour_;
+					currentDistance = distance;
+				}
+			});
+		if (next == current)
+			return current;
+		current = next;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::vector< Polygon2<TValueType> > computeVoronoiCells(std::vector< Vector2<TValueType> > const & points_,
+														DelaunayTriangulation const & triangulation_,
+														Rect2<TValueType> const & bounds_, std::size_t const threadCount_)
+{
+	using VectorType = Vector2<TValueType>;
+
+	std::vector< Polygon2<TValueType> > cells(points_.size());
+	if (triangulation_.triangles.empty() && triangulation_.hull.size() < 2)
+	{
+		// Single site owns the whole bounds.
+		if (!triangulation_.hull.empty())
+		{
+			VectorType const lower = bounds_.center - bounds_.getHalfExtent();
+			VectorType const upper = bounds_.center + bounds_.getHalfExtent();
+			cells[triangulation_.hull[0]] = Polygon2<TValueType>({ lower, { upper.x, lower.y }, upper, { lower.x, upper.y } });
+		}
+		return cells;
+	}
+
+	// Every cell is the bounds clipped by bisectors with Delaunay neighbours.
+	priv::parallelFor(points_.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			VectorType const lower = bounds_.center - bounds_.getHalfExtent();
+			VectorType const upper = bounds_.center + bounds_.getHalfExtent();
+
+			std::vector<VectorType> cell, scratch;
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				cell.assign({ lower, { upper.x, lower.y }, upper, { lower.x, upper.y } });
+
+				bool hasNeighbours = false;
+				VectorType const & site = points_[i];
+				priv::forEachDelaunayNeighbour(triangulation_, i,
+					[&](std::size_t const neighbour_)
+					{
+						VectorType const & other = points_[neighbour_];
+						priv::clipConvexPolygon(cell, scratch, other - site, (site + other) / TValueType(2));
+						hasNeighbours = true;
+					});
+
+				if (hasNeighbours)
+					cells[i] = Polygon2<TValueType>(cell);
+			}
+		});
+	return cells;
+}
+
+}
\ No newline at end of file
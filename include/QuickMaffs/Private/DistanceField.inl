@@ -0,0 +1,339 @@
+// Note: this file is not meant to be included on its own.
+// Include "DistanceField.hpp" instead.
+
+#include "Parallel.hpp"
+#include "PolygonEdges.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Number of columns transposed and transformed together in the column pass.
+constexpr std::size_t cxDistanceFieldColumnBlock = 16;
+
+// Number of edges on each side of a candidate one, along its ring, that are also measured.
+constexpr std::size_t cxDistanceFieldEdgeNeighbours = 2;
+// Seeds within this many cells of the selected one add their edges to the candidates.
+constexpr std::size_t cxDistanceFieldSeedRadius = 1;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType distanceSquaredToSegment(Vector2<TValueType> const & point_, PolygonEdge2<TValueType> const & edge_)
+{
+	Vector2<TValueType> const direction = edge_.to - edge_.from;
+	Vector2<TValueType> const offset = point_ - edge_.from;
+
+	TValueType const t = std::clamp(offset.dot(direction) / direction.lengthSquared(), TValueType(0), TValueType(1));
+	return (offset - direction * t).lengthSquared();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Computes one dimensional squared distance transform: d(p) = min over q of (spacing * (p - q))^2 + f(q).
+/// Index of the minimizing q is written to `nearest_`. Infinite samples of `f_` are treated as empty.
+/// </summary>
+template <typename TValueType>
+void distanceTransform1D(TValueType const * f_, TValueType * d_, std::size_t * nearest_, std::size_t const count_,
+						TValueType const spacingSquared_, std::size_t * vertices_, TValueType * boundaries_)
+{
+	constexpr TValueType cxInfinity = std::numeric_limits<TValueType>::infinity();
+
+	auto intersection = [&](std::size_t const q_, std::size_t const r_) {
+			TValueType const fq = f_[q_] + spacingSquared_ * static_cast<TValueType>(q_) * static_cast<TValueType>(q_);
+			TValueType const fr = f_[r_] + spacingSquared_ * static_cast<TValueType>(r_) * static_cast<TValueType>(r_);
+			return (fq - fr) / (TValueType(2) * spacingSquared_ * (static_cast<TValueType>(q_) - static_cast<TValueType>(r_)));
+		};
+
+	std::size_t first = 0;
+	while (first < count_ && f_[first] == cxInfinity)
+		++first;
+
+	if (first == count_)
+	{
+		std::fill_n(d_, count_, cxInfinity);
+		std::fill_n(nearest_, count_, count_);
+		return;
+	}
+
+	// Build lower envelope of parabolas rooted at finite samples.
+	std::size_t k = 0;
+	vertices_[0] = first;
+	boundaries_[0] = -cxInfinity;
+	boundaries_[1] = cxInfinity;
+	for (std::size_t q = first + 1; q < count_; ++q)
+	{
+		if (f_[q] == cxInfinity)
+			continue;
+
+		TValueType s = intersection(q, vertices_[k]);
+		while (s <= boundaries_[k])
+		{
+			--k;
+			s = intersection(q, vertices_[k]);
+		}
+		++k;
+		vertices_[k] = q;
+		boundaries_[k] = s;
+		boundaries_[k + 1] = cxInfinity;
+	}
+
+	// Sample the envelope.
+	k = 0;
+	for (std::size_t q = 0; q < count_; ++q)
+	{
+		while (boundaries_[k + 1] < static_cast<TValueType>(q))
+			++k;
+
+		TValueType const offset = static_cast<TValueType>(q) - static_cast<TValueType>(vertices_[k]);
+		d_[q] = spacingSquared_ * offset * offset + f_[vertices_[k]];
+		nearest_[q] = vertices_[k];
+	}
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+ScalarGrid2<TValueType> computeSignedDistanceField(std::vector< Polygon2<TValueType> > const & polygons_,
+													Rect2<TValueType> const & region_, Vector2size const & resolution_,
+													std::size_t const threadCount_)
+{
+	using VectorType = Vector2<TValueType>;
+
+	constexpr TValueType cxInfinity = std::numeric_limits<TValueType>::infinity();
+
+	ScalarGrid2<TValueType> grid{ region_, resolution_, cxInfinity };
+
+	std::size_t const width		= resolution_.x;
+	std::size_t const height	= resolution_.y;
+	if (width == 0 || height == 0)
+		return grid;
+
+	std::vector<std::size_t> ringStarts;
+	auto const edges = priv::collectPolygonEdges(polygons_, &ringStarts);
+	if (edges.empty())
+		return grid;
+
+	// Ring of every edge, so that neighbours wrap around it:
+	std::vector<std::size_t> edgeRings(edges.size());
+	for (std::size_t ring = 0; ring + 1 < ringStarts.size(); ++ring)
+		std::fill(edgeRings.begin() + static_cast<std::ptrdiff_t>(ringStarts[ring]), edgeRings.begin() + static_cast<std::ptrdiff_t>(ringStarts[ring + 1]), ring);
+
+	VectorType const cellSize	= grid.getCellSize();
+	VectorType const origin		= region_.center - region_.getHalfExtent();
+
+	auto sampleX = [&](std::size_t const x_) { return origin.x + (static_cast<TValueType>(x_) + TValueType(0.5)) * cellSize.x; };
+	auto sampleY = [&](std::size_t const y_) { return origin.y + (static_cast<TValueType>(y_) + TValueType(0.5)) * cellSize.y; };
+	auto firstRow = [&](TValueType const y_) { return priv::firstSampleNotBelow(y_, origin.y, cellSize.y, height); };
+	auto firstColumn = [&](TValueType const x_) { return priv::firstSampleNotBelow(x_, origin.x, cellSize.x, width); };
+
+	std::vector<std::uint8_t>	inside(width * height, 0);
+	std::vector<TValueType>		distancesSquared(width * height, cxInfinity);
+	std::size_t const noEdge = edges.size();
+	std::vector<std::size_t>	seedEdges(width * height, noEdge);	// Nearest edge of every seed cell.
+	std::vector<std::size_t>	nearestRows(width * height);	// Row of the nearest seed within the same column.
+
+	TValueType const band = std::max(cellSize.x, cellSize.y);
+	TValueType const bandSquared = band * band;
+
+	// 1. Row bands: rasterize inside mask (even-odd) and seed exact distances around edges.
+	priv::parallelFor(height, threadCount_,
+		[&](std::size_t const rowBegin_, std::size_t const rowEnd_, std::size_t)
+		{
+			RasterTile<TValueType> bandTile;
+			bandTile.region = Rect2<TValueType>{
+					VectorType{ region_.center.x, origin.y + static_cast<TValueType>(rowBegin_ + rowEnd_) / TValueType(2) * cellSize.y },
+					VectorType{ region_.getHalfExtent().x, static_cast<TValueType>(rowEnd_ - rowBegin_) / TValueType(2) * cellSize.y }
+				};
+			bandTile.resolution	= Vector2size{ width, rowEnd_ - rowBegin_ };
+			bandTile.pixels		= inside.data() + rowBegin_ * width;
+			bandTile.stride		= static_cast<std::ptrdiff_t>(width);
+			priv::rasterizeEdges(edges, bandTile, RasterMode::Binary, FillRule::EvenOdd);
+
+			for (std::size_t edgeIndex = 0; edgeIndex < edges.size(); ++edgeIndex)
+			{
+				auto const & edge = edges[edgeIndex];
+				auto const [minY, maxY] = std::minmax(edge.from.y, edge.to.y);
+
+				// Seeds in a one cell wide band:
+				std::size_t const seedBegin = std::max(rowBegin_, firstRow(minY - band));
+				std::size_t const seedEnd = std::min(rowEnd_, firstRow(maxY + band));
+				for (std::size_t y = seedBegin; y < seedEnd; ++y)
+				{
+					TValueType const rowY = sampleY(y);
+
+					// Part of the edge within the vertical band around the row:
+					TValueType tFrom = 0, tTo = 1;
+					if (edge.to.y != edge.from.y)
+					{
+						tFrom = (rowY - band - edge.from.y) / (edge.to.y - edge.from.y);
+						tTo = (rowY + band - edge.from.y) / (edge.to.y - edge.from.y);
+						minMaxRef(tFrom, tTo);
+						tFrom = std::max(tFrom, TValueType(0));
+						tTo = std::min(tTo, TValueType(1));
+					}
+
+					auto const [minX, maxX] = std::minmax({ edge.from.x + tFrom * (edge.to.x - edge.from.x), edge.from.x + tTo * (edge.to.x - edge.from.x) });
+					std::size_t const columnEnd = firstColumn(maxX + band);
+
+					TValueType * rowDistances = distancesSquared.data() + y * width;
+					std::size_t * rowEdges = seedEdges.data() + y * width;
+					for (std::size_t x = firstColumn(minX - band); x < columnEnd; ++x)
+					{
+						TValueType const distance = priv::distanceSquaredToSegment(VectorType{ sampleX(x), rowY }, edge);
+						if (distance < bandSquared && distance < rowDistances[x])
+						{
+							rowDistances[x] = distance;
+							rowEdges[x] = edgeIndex;
+						}
+					}
+				}
+			}
+		});
+
+	// Squared distance to the edge and to its neighbours along the ring:
+	auto measureEdge = [&](VectorType const & sample_, std::size_t const edgeIndex_, TValueType & distanceSquared_) {
+			std::size_t const ringBegin = ringStarts[edgeRings[edgeIndex_]];
+			std::size_t const ringSize = ringStarts[edgeRings[edgeIndex_] + 1] - ringBegin;
+			std::size_t const position = edgeIndex_ - ringBegin;
+			std::size_t const neighbours = std::min(priv::cxDistanceFieldEdgeNeighbours, (ringSize - 1) / 2);
+			for (std::size_t n = ringSize - neighbours; n <= ringSize + neighbours; ++n)
+			{
+				auto const & edge = edges[ringBegin + (position + n) % ringSize];
+				distanceSquared_ = std::min(distanceSquared_, priv::distanceSquaredToSegment(sample_, edge));
+			}
+		};
+
+	// No edge passes through the region: the transform has nothing to spread, so every cell measures every edge.
+	if (std::find_if(seedEdges.begin(), seedEdges.end(), [noEdge](std::size_t const edge_) { return edge_ != noEdge; }) == seedEdges.end())
+	{
+		priv::parallelFor(height, threadCount_,
+			[&](std::size_t const rowBegin_, std::size_t const rowEnd_, std::size_t)
+			{
+				for (std::size_t y = rowBegin_; y < rowEnd_; ++y)
+				{
+					TValueType * rowValues = grid.row(y);
+					std::uint8_t const * rowInside = inside.data() + y * width;
+					for (std::size_t x = 0; x < width; ++x)
+					{
+						VectorType const sample{ sampleX(x), sampleY(y) };
+						TValueType distanceSquared = cxInfinity;
+						for (auto const & edge : edges)
+							distanceSquared = std::min(distanceSquared, priv::distanceSquaredToSegment(sample, edge));
+
+						TValueType const distance = std::sqrt(distanceSquared);
+						rowValues[x] = rowInside[x] != 0 ? -distance : distance;
+					}
+				}
+			});
+		return grid;
+	}
+
+	// 2. Column pass, blocks of columns are transposed so the transform runs on contiguous memory.
+	//    The transform only selects the nearest seed, final distance is measured to the edge of that seed.
+	std::size_t const blockCount = (width + priv::cxDistanceFieldColumnBlock - 1) / priv::cxDistanceFieldColumnBlock;
+	priv::parallelFor(blockCount, threadCount_,
+		[&](std::size_t const blockBegin_, std::size_t const blockEnd_, std::size_t)
+		{
+			std::vector<TValueType>		columns(priv::cxDistanceFieldColumnBlock * height);
+			std::vector<std::size_t>	columnsNearest(priv::cxDistanceFieldColumnBlock * height);
+			std::vector<TValueType>		transformed(height);
+			std::vector<std::size_t>	vertices(height);
+			std::vector<TValueType>		boundaries(height + 1);
+
+			for (std::size_t block = blockBegin_; block < blockEnd_; ++block)
+			{
+				std::size_t const columnBegin = block * priv::cxDistanceFieldColumnBlock;
+				std::size_t const blockWidth = std::min(priv::cxDistanceFieldColumnBlock, width - columnBegin);
+
+				for (std::size_t y = 0; y < height; ++y)
+				{
+					TValueType const * rowDistances = distancesSquared.data() + y * width + columnBegin;
+					for (std::size_t c = 0; c < blockWidth; ++c)
+						columns[c * height + y] = rowDistances[c];
+				}
+
+				for (std::size_t c = 0; c < blockWidth; ++c)
+				{
+					priv::distanceTransform1D(columns.data() + c * height, transformed.data(), columnsNearest.data() + c * height,
+						height, cellSize.y * cellSize.y, vertices.data(), boundaries.data());
+					std::copy(transformed.begin(), transformed.end(), columns.begin() + c * height);
+				}
+
+				for (std::size_t y = 0; y < height; ++y)
+				{
+					TValueType * rowDistances = distancesSquared.data() + y * width + columnBegin;
+					std::size_t * rowNearest = nearestRows.data() + y * width + columnBegin;
+					for (std::size_t c = 0; c < blockWidth; ++c)
+					{
+						rowDistances[c] = columns[c * height + y];
+						rowNearest[c] = columnsNearest[c * height + y];
+					}
+				}
+			}
+		});
+
+	// 3. Row pass, then apply sign.
+	priv::parallelFor(height, threadCount_,
+		[&](std::size_t const rowBegin_, std::size_t const rowEnd_, std::size_t)
+		{
+			std::vector<TValueType>		transformed(width);
+			std::vector<std::size_t>	nearestColumns(width);
+			std::vector<std::size_t>	vertices(width);
+			std::vector<TValueType>		boundaries(width + 1);
+			std::vector<std::size_t>	candidates;
+
+			for (std::size_t y = rowBegin_; y < rowEnd_; ++y)
+			{
+				priv::distanceTransform1D(distancesSquared.data() + y * width, transformed.data(), nearestColumns.data(),
+					width, cellSize.x * cellSize.x, vertices.data(), boundaries.data());
+
+				TValueType * rowValues = grid.row(y);
+				std::uint8_t const * rowInside = inside.data() + y * width;
+				for (std::size_t x = 0; x < width; ++x)
+				{
+					std::size_t const seedColumn = nearestColumns[x];
+					std::size_t const seedRow = nearestRows[y * width + seedColumn];
+
+					// Selected seed may belong to an edge near the nearest one, so the edges of the seeds around it
+					// and their neighbours along the ring are measured as well.
+					// Any edge gives an upper bound of the distance, so the minimum stays valid.
+					candidates.clear();
+					std::size_t const rowLast = std::min(height - 1, seedRow + priv::cxDistanceFieldSeedRadius);
+					std::size_t const columnLast = std::min(width - 1, seedColumn + priv::cxDistanceFieldSeedRadius);
+					for (std::size_t r = seedRow - std::min(seedRow, priv::cxDistanceFieldSeedRadius); r <= rowLast; ++r)
+					{
+						for (std::size_t c = seedColumn - std::min(seedColumn, priv::cxDistanceFieldSeedRadius); c <= columnLast; ++c)
+						{
+							std::size_t const edgeIndex = seedEdges[r * width + c];
+							if (edgeIndex != noEdge && std::find(candidates.begin(), candidates.end(), edgeIndex) == candidates.end())
+								candidates.push_back(edgeIndex);
+						}
+					}
+
+					VectorType const sample{ sampleX(x), sampleY(y) };
+					TValueType distanceSquared = cxInfinity;
+					for (std::size_t const edgeIndex : candidates)
+						measureEdge(sample, edgeIndex, distanceSquared);
+
+					TValueType const distance = std::sqrt(distanceSquared);
+					rowValues[x] = rowInside[x] != 0 ? -distance : distance;
+				}
+			}
+		});
+
+	return grid;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+ScalarGrid2<TValueType> computeSignedDistanceField(Polygon2<TValueType> const & polygon_,
+													Rect2<TValueType> const & region_, Vector2size const & resolution_,
+													std::size_t const threadCount_)
+{
+	return computeSignedDistanceField(std::vector< Polygon2<TValueType> >{ polygon_ }, region_, resolution_, threadCount_);
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,504 @@
+// Note: this file is not meant to be included on its own.
+// Include "DynamicAabbTree.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Expected displacement is scaled by this factor when enlarging bounds of a moved shape.
+constexpr int cxAabbTreeDisplacementScale = 4;
+// Fattened bounds exceeding the tight ones by more than this many margins are shrunk on move.
+constexpr int cxAabbTreeMaxFatMargins = 4;
+// Traversals keep the stack on the call stack up to this depth.
+constexpr std::size_t cxAabbTreeFixedStack = 64;
+// Refit splits the tree into about this many subtrees per thread.
+constexpr std::size_t cxAabbTreeSubtreesPerThread = 4;
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+DynamicAabbTree<TShapeType>::DynamicAabbTree(ValueType const margin_)
+	:
+	m_margin{ margin_ }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t DynamicAabbTree<TShapeType>::insert(ShapeType const & shape_)
+{
+	std::size_t const leaf = this->allocateNode();
+	m_nodes[leaf].bounds = this->fatten(computeBounds(shape_), VectorType{});
+	m_nodes[leaf].height = 0;
+	m_shapes[leaf] = shape_;
+
+	this->insertLeaf(leaf);
+	++m_size;
+	return leaf;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::remove(std::size_t const proxy_)
+{
+	this->removeLeaf(proxy_);
+	this->freeNode(proxy_);
+	--m_size;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+bool DynamicAabbTree<TShapeType>::move(std::size_t const proxy_, ShapeType const & shape_, VectorType const & displacement_)
+{
+	AabbType const bounds = computeBounds(shape_);
+	m_shapes[proxy_] = shape_;
+
+	AabbType const & fatBounds = m_nodes[proxy_].bounds;
+	if (priv::containsBounds(fatBounds, bounds))
+	{
+		// Bounds left much larger than needed (e.g. by a fast move) would slow the queries down:
+		AabbType largest = this->fatten(bounds, displacement_);
+		largest.lower -= m_margin * ValueType(priv::cxAabbTreeMaxFatMargins);
+		largest.upper += m_margin * ValueType(priv::cxAabbTreeMaxFatMargins);
+		if (priv::containsBounds(largest, fatBounds))
+			return false;
+	}
+
+	this->removeLeaf(proxy_);
+	m_nodes[proxy_].bounds = this->fatten(bounds, displacement_);
+	this->insertLeaf(proxy_);
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::setShape(std::size_t const proxy_, ShapeType const & shape_)
+{
+	m_shapes[proxy_] = shape_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::refit(std::size_t const threadCount_)
+{
+	if (m_root == npos)
+		return;
+
+	// Split the top of the tree into subtrees, breadth first:
+	std::size_t const subtreeCount = priv::resolveThreadCount(threadCount_) * priv::cxAabbTreeSubtreesPerThread;
+	std::vector<std::size_t> top, subtrees{ m_root };
+	while (subtrees.size() < subtreeCount)
+	{
+		std::vector<std::size_t> next;
+		for (std::size_t const index : subtrees)
+		{
+			if (m_nodes[index].height == 0)
+				next.push_back(index);
+			else
+			{
+				top.push_back(index);
+				next.push_back(m_nodes[index].children[0]);
+				next.push_back(m_nodes[index].children[1]);
+			}
+		}
+		if (next.size() == subtrees.size())
+			break;
+		subtrees = std::move(next);
+	}
+
+	// Subtrees in parallel, children before their parents:
+	auto refitSubtree = [this](std::size_t const root_, auto const & self_) -> void {
+			Node & node = m_nodes[root_];
+			if (node.height == 0)
+			{
+				AabbType const bounds = computeBounds(m_shapes[root_]);
+				if (!priv::containsBounds(node.bounds, bounds))
+					node.bounds = this->fatten(bounds, VectorType{});
+				return;
+			}
+			self_(node.children[0], self_);
+			self_(node.children[1], self_);
+			node.bounds = m_nodes[node.children[0]].bounds;
+			node.bounds.extend(m_nodes[node.children[1]].bounds);
+		};
+	priv::parallelFor(subtrees.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+				refitSubtree(subtrees[i], refitSubtree);
+		});
+
+	// Then the top, deepest levels first:
+	for (auto it = top.rbegin(); it != top.rend(); ++it)
+	{
+		Node & node = m_nodes[*it];
+		node.bounds = m_nodes[node.children[0]].bounds;
+		node.bounds.extend(m_nodes[node.children[1]].bounds);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::clear()
+{
+	m_nodes.clear();
+	m_shapes.clear();
+	m_root = npos;
+	m_freeList = npos;
+	m_size = 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+TShapeType const & DynamicAabbTree<TShapeType>::getShape(std::size_t const proxy_) const
+{
+	return m_shapes[proxy_];
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+typename DynamicAabbTree<TShapeType>::AabbType const & DynamicAabbTree<TShapeType>::getFatBounds(std::size_t const proxy_) const
+{
+	return m_nodes[proxy_].bounds;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t DynamicAabbTree<TShapeType>::size() const
+{
+	return m_size;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+int DynamicAabbTree<TShapeType>::getHeight() const
+{
+	return m_root == npos ? -1 : m_nodes[m_root].height;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TFunction>
+void DynamicAabbTree<TShapeType>::forEachContaining(VectorType const & point_, TFunction && function_) const
+{
+	this->traverse(
+		[&point_](AabbType const & bounds_) { return priv::containsPoint(bounds_, point_); },
+		[&](std::size_t const leaf_)
+		{
+			if (isPointInside(m_shapes[leaf_], point_))
+				function_(leaf_);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<std::size_t> DynamicAabbTree<TShapeType>::findContaining(VectorType const & point_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachContaining(point_, [&result](std::size_t const proxy_) { result.push_back(proxy_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TQueryShapeType, typename TFunction>
+void DynamicAabbTree<TShapeType>::forEachOverlapping(TQueryShapeType const & shape_, TFunction && function_) const
+{
+	this->traverse(
+		[&shape_](AabbType const & bounds_) { return intersects(shape_, bounds_); },
+		[&](std::size_t const leaf_)
+		{
+			if (intersects(shape_, m_shapes[leaf_]))
+				function_(leaf_);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TQueryShapeType>
+std::vector<std::size_t> DynamicAabbTree<TShapeType>::findOverlapping(TQueryShapeType const & shape_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachOverlapping(shape_, [&result](std::size_t const proxy_) { result.push_back(proxy_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TFunction>
+void DynamicAabbTree<TShapeType>::forEachIntersectingRay(VectorType const & origin_, VectorType const & direction_,
+															TFunction && function_) const
+{
+	this->traverse(
+		[&](AabbType const & bounds_) {
+			return priv::rayRangeHitsBounds(bounds_.lower, bounds_.upper, origin_, direction_, std::numeric_limits<ValueType>::infinity());
+		},
+		[&](std::size_t const leaf_)
+		{
+			if (intersectsRay(m_shapes[leaf_], origin_, direction_))
+				function_(leaf_);
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<std::size_t> DynamicAabbTree<TShapeType>::findIntersectingRay(VectorType const & origin_, VectorType const & direction_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachIntersectingRay(origin_, direction_, [&result](std::size_t const proxy_) { result.push_back(proxy_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t DynamicAabbTree<TShapeType>::allocateNode()
+{
+	if (m_freeList == npos)
+	{
+		m_nodes.push_back(Node{});
+		m_shapes.push_back(ShapeType{});
+		m_freeList = m_nodes.size() - 1;
+		m_nodes[m_freeList].parent = npos;
+	}
+
+	std::size_t const index = m_freeList;
+	m_freeList = m_nodes[index].parent;
+
+	Node & node = m_nodes[index];
+	node.parent = npos;
+	node.children[0] = node.children[1] = npos;
+	node.height = 0;
+	return index;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::freeNode(std::size_t const index_)
+{
+	m_nodes[index_].parent = m_freeList;
+	m_nodes[index_].height = -1;
+	m_freeList = index_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+typename DynamicAabbTree<TShapeType>::AabbType DynamicAabbTree<TShapeType>::fatten(AabbType const & bounds_,
+																					VectorType const & displacement_) const
+{
+	AabbType result{ bounds_.lower - m_margin, bounds_.upper + m_margin };
+	for (std::size_t d = 0; d < displacement_.size(); ++d)
+	{
+		ValueType const offset = displacement_[d] * ValueType(priv::cxAabbTreeDisplacementScale);
+		if (offset < ValueType(0))
+			result.lower[d] += offset;
+		else
+			result.upper[d] += offset;
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::insertLeaf(std::size_t const leaf_)
+{
+	if (m_root == npos)
+	{
+		m_root = leaf_;
+		m_nodes[leaf_].parent = npos;
+		return;
+	}
+
+	// Descend to the sibling minimizing the area added to the tree. Going down a child costs
+	// the growth of the current node, which the new parent would not pay by stopping here.
+	using CostType = decltype(priv::halfSurfaceArea(std::declval<AabbType>()));
+
+	AabbType const leafBounds = m_nodes[leaf_].bounds;
+	std::size_t sibling = m_root;
+	while (m_nodes[sibling].height > 0)
+	{
+		Node const & node = m_nodes[sibling];
+
+		AabbType combined = node.bounds;
+		combined.extend(leafBounds);
+		CostType const area = priv::halfSurfaceArea(node.bounds);
+		CostType const combinedArea = priv::halfSurfaceArea(combined);
+
+		CostType const cost = 2 * combinedArea;
+		CostType const inheritedCost = 2 * (combinedArea - area);
+
+		CostType childCosts[2];
+		for (std::size_t c = 0; c < 2; ++c)
+		{
+			Node const & child = m_nodes[node.children[c]];
+			AabbType childCombined = child.bounds;
+			childCombined.extend(leafBounds);
+			childCosts[c] = priv::halfSurfaceArea(childCombined) + inheritedCost;
+			if (child.height > 0)
+				childCosts[c] -= priv::halfSurfaceArea(child.bounds);
+		}
+
+		if (cost < childCosts[0] && cost < childCosts[1])
+			break;
+		sibling = node.children[childCosts[0] < childCosts[1] ? 0 : 1];
+	}
+
+	// New parent takes the place of the sibling:
+	std::size_t const oldParent = m_nodes[sibling].parent;
+	std::size_t const newParent = this->allocateNode();
+	m_nodes[newParent].parent = oldParent;
+	m_nodes[newParent].bounds = m_nodes[sibling].bounds;
+	m_nodes[newParent].bounds.extend(leafBounds);
+	m_nodes[newParent].height = m_nodes[sibling].height + 1;
+	m_nodes[newParent].children[0] = sibling;
+	m_nodes[newParent].children[1] = leaf_;
+	m_nodes[sibling].parent = newParent;
+	m_nodes[leaf_].parent = newParent;
+
+	if (oldParent == npos)
+		m_root = newParent;
+	else
+	{
+		Node & parent = m_nodes[oldParent];
+		parent.children[parent.children[0] == sibling ? 0 : 1] = newParent;
+	}
+
+	this->updateAncestors(m_nodes[leaf_].parent);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::removeLeaf(std::size_t const leaf_)
+{
+	if (leaf_ == m_root)
+	{
+		m_root = npos;
+		return;
+	}
+
+	std::size_t const parent = m_nodes[leaf_].parent;
+	std::size_t const grandParent = m_nodes[parent].parent;
+	std::size_t const sibling = m_nodes[parent].children[m_nodes[parent].children[0] == leaf_ ? 1 : 0];
+
+	// The sibling takes the place of the parent:
+	m_nodes[sibling].parent = grandParent;
+	this->freeNode(parent);
+	if (grandParent == npos)
+	{
+		m_root = sibling;
+		return;
+	}
+
+	Node & node = m_nodes[grandParent];
+	node.children[node.children[0] == parent ? 0 : 1] = sibling;
+	this->updateAncestors(grandParent);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void DynamicAabbTree<TShapeType>::updateAncestors(std::size_t index_)
+{
+	while (index_ != npos)
+	{
+		index_ = this->balance(index_);
+
+		Node & node = m_nodes[index_];
+		Node const & first = m_nodes[node.children[0]];
+		Node const & second = m_nodes[node.children[1]];
+		node.height = 1 + std::max(first.height, second.height);
+		node.bounds = first.bounds;
+		node.bounds.extend(second.bounds);
+
+		index_ = node.parent;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t DynamicAabbTree<TShapeType>::balance(std::size_t const index_)
+{
+	Node & a = m_nodes[index_];
+	if (a.height < 2)
+		return index_;
+
+	// The higher child is rotated up when heights of the children differ by more than 1:
+	int const difference = m_nodes[a.children[1]].height - m_nodes[a.children[0]].height;
+	if (difference >= -1 && difference <= 1)
+		return index_;
+
+	std::size_t const high = difference > 0 ? 1 : 0;
+	std::size_t const low = 1 - high;
+	std::size_t const b = a.children[high];
+	Node & up = m_nodes[b];
+
+	// B replaces A under A's parent, A becomes a child of B:
+	up.parent = a.parent;
+	a.parent = b;
+	if (up.parent == npos)
+		m_root = b;
+	else
+	{
+		Node & parent = m_nodes[up.parent];
+		parent.children[parent.children[0] == index_ ? 0 : 1] = b;
+	}
+
+	// B keeps its higher child, the lower one moves to A in place of B:
+	std::size_t const keepSlot = m_nodes[up.children[0]].height > m_nodes[up.children[1]].height ? 0 : 1;
+	std::size_t const kept = up.children[keepSlot];
+	std::size_t const moved = up.children[1 - keepSlot];
+	up.children[1 - keepSlot] = index_;
+	a.children[high] = moved;
+	m_nodes[moved].parent = index_;
+
+	a.bounds = m_nodes[a.children[low]].bounds;
+	a.bounds.extend(m_nodes[moved].bounds);
+	a.height = 1 + std::max(m_nodes[a.children[low]].height, m_nodes[moved].height);
+	up.bounds = a.bounds;
+	up.bounds.extend(m_nodes[kept].bounds);
+	up.height = 1 + std::max(a.height, m_nodes[kept].height);
+	return b;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TPredicate, typename TFunction>
+void DynamicAabbTree<TShapeType>::traverse(TPredicate && predicate_, TFunction && function_) const
+{
+	if (m_root == npos)
+		return;
+
+	// Stack never holds more than height + 1 nodes:
+	std::size_t fixedStack[priv::cxAabbTreeFixedStack];
+	std::vector<std::size_t> largeStack;
+	std::size_t * stack = fixedStack;
+	std::size_t const capacity = static_cast<std::size_t>(m_nodes[m_root].height) + 2;
+	if (capacity > priv::cxAabbTreeFixedStack)
+	{
+		largeStack.resize(capacity);
+		stack = largeStack.data();
+	}
+
+	std::size_t top = 0;
+	stack[top++] = m_root;
+	while (top > 0)
+	{
+		std::size_t const index = stack[--top];
+		Node const & node = m_nodes[index];
+		if (!predicate_(node.bounds))
+			continue;
+
+		if (node.height == 0)
+			function_(index);
+		else
+		{
+			stack[top++] = node.children[1];
+			stack[top++] = node.children[0];
+		}
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,253 @@
+// Note: this file is not meant to be included on its own.
+// Include "Frustum.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+constexpr Plane3< TValueType >::Plane3()
+	:
+	normal{ ValueType(0), ValueType(0), ValueType(1) },
+	distance{ ValueType(0) }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+constexpr Plane3< TValueType >::Plane3(VectorType const & normal_, ValueType const distance_)
+	:
+	normal{ normal_ },
+	distance{ distance_ }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+constexpr Plane3< TValueType > Plane3< TValueType >::fromPointNormal(VectorType const & point_, VectorType const & normal_)
+{
+	return Plane3{ normal_, -normal_.dot(point_) };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+Plane3< TValueType > Plane3< TValueType >::fromPoints(VectorType const & first_, VectorType const & second_, VectorType const & third_)
+{
+	return fromPointNormal(first_, (second_ - first_).cross(third_ - first_)).normalize();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+constexpr TValueType Plane3< TValueType >::signedDistance(VectorType const & point_) const
+{
+	return normal.dot(point_) + distance;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+Plane3< TValueType > Plane3< TValueType >::normalize() const
+{
+	ValueType const length = normal.length();
+	return Plane3{ normal / length, distance / length };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+constexpr Frustum3< TValueType >::Frustum3(std::array<PlaneType, PlaneCount> const & planes_)
+	:
+	planes{ planes_ }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+Frustum3< TValueType > Frustum3< TValueType >::fromPerspective(VectorType const & eye_, VectorType const & forward_, VectorType const & up_,
+															   ValueType const verticalFieldOfView_, ValueType const aspectRatio_,
+															   ValueType const nearDistance_, ValueType const farDistance_)
+{
+	VectorType const forward = forward_.normalize();
+	VectorType const right = forward.cross(up_).normalize();
+	VectorType const up = right.cross(forward);
+
+	ValueType const halfHeight = std::tan(verticalFieldOfView_ / ValueType(2));
+	ValueType const halfWidth = halfHeight * aspectRatio_;
+
+	// Side plane normals are perpendicular to the edge directions `forward +- right * halfWidth` (or up) and point inside.
+	Frustum3 result;
+	result.planes[0] = PlaneType::fromPointNormal(eye_, right + forward * halfWidth).normalize();
+	result.planes[1] = PlaneType::fromPointNormal(eye_, forward * halfWidth - right).normalize();
+	result.planes[2] = PlaneType::fromPointNormal(eye_, up + forward * halfHeight).normalize();
+	result.planes[3] = PlaneType::fromPointNormal(eye_, forward * halfHeight - up).normalize();
+	result.planes[4] = PlaneType::fromPointNormal(eye_ + forward * nearDistance_, forward);
+	result.planes[5] = PlaneType::fromPointNormal(eye_ + forward * farDistance_, -forward);
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+Frustum3< TValueType > Frustum3< TValueType >::normalize() const
+{
+	Frustum3 result;
+	for (std::size_t p = 0; p < PlaneCount; ++p)
+		result.planes[p] = planes[p].normalize();
+	return result;
+}
+
+namespace priv
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Culls a block of at most cxShapeBatchBlock shapes against the planes.
+/// `reach_(absoluteNormal, i)` returns how far shape i extends towards the plane with the given absolute normal.
+/// Indices (offset by `begin_`) of the remaining shapes are written to `indices_`; returns their number.
+/// </summary>
+template <typename V, typename TReachFunction>
+std::size_t cullBlock(Frustum3<V> const & frustum_, V const * const * centers_, std::size_t const begin_, std::size_t const count_,
+					  TReachFunction const & reach_, std::uint32_t * indices_)
+{
+	std::uint8_t visible[cxShapeBatchBlock];
+	std::fill(visible, visible + count_, std::uint8_t(1));
+
+	V const * const x = centers_[0] + begin_;
+	V const * const y = centers_[1] + begin_;
+	V const * const z = centers_[2] + begin_;
+
+	for (auto const & plane : frustum_.planes)
+	{
+		V const nx = plane.normal.x, ny = plane.normal.y, nz = plane.normal.z;
+		Vector3<V> const absoluteNormal{ std::abs(nx), std::abs(ny), std::abs(nz) };
+		V const offset = plane.distance;
+
+		std::uint8_t remaining = 0;
+		for (std::size_t i = 0; i < count_; ++i)
+		{
+			V const distance = nx * x[i] + ny * y[i] + nz * z[i] + offset;
+			std::uint8_t const inFront = static_cast<std::uint8_t>(distance >= -reach_(absoluteNormal, begin_ + i));
+			visible[i] &= inFront;
+			remaining |= visible[i];
+		}
+		// Early out: the whole block is behind this plane.
+		if (remaining == 0)
+			return 0;
+	}
+
+	std::size_t result = 0;
+	for (std::size_t i = 0; i < count_; ++i)
+	{
+		indices_[result] = static_cast<std::uint32_t>(begin_ + i);
+		result += visible[i];
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Culls the shapes in parallel chunks and joins indices of the remaining ones.
+/// </summary>
+template <typename V, typename TReachFunction>
+std::vector<std::uint32_t> findVisibleShapes(Frustum3<V> const & frustum_, std::array<std::vector<V>, 3> const & centers_,
+											 TReachFunction const & reach_, std::size_t const threadCount_)
+{
+	std::size_t const count = centers_[0].size();
+	if (count > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("Too many shapes for frustum culling");
+
+	V const * const centers[3] = { centers_[0].data(), centers_[1].data(), centers_[2].data() };
+
+	// Every chunk writes its indices to the front of its own range, which has room for all of them.
+	std::vector<std::uint32_t> result(count);
+	std::size_t const chunkCount = parallelChunkCount(count, threadCount_);
+	std::vector<std::size_t> chunkBegins(chunkCount), chunkSizes(chunkCount);
+	parallelFor(count, threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_) {
+			std::size_t visibleCount = 0;
+			for (std::size_t block = begin_; block < end_; block += cxShapeBatchBlock)
+			{
+				std::size_t const blockSize = std::min(cxShapeBatchBlock, end_ - block);
+				visibleCount += cullBlock(frustum_, centers, block, blockSize, reach_, result.data() + begin_ + visibleCount);
+			}
+			chunkBegins[chunk_] = begin_;
+			chunkSizes[chunk_] = visibleCount;
+		});
+
+	// Chunks move towards the front in order, so they never overwrite indices not moved yet.
+	// Chunks already in place are skipped: std::copy must not start writing inside its source.
+	std::size_t size = 0;
+	for (std::size_t c = 0; c < chunkCount; ++c)
+	{
+		if (size != chunkBegins[c])
+		{
+			auto const source = result.begin() + static_cast<std::ptrdiff_t>(chunkBegins[c]);
+			std::copy(source, source + static_cast<std::ptrdiff_t>(chunkSizes[c]), result.begin() + static_cast<std::ptrdiff_t>(size));
+		}
+		size += chunkSizes[c];
+	}
+	result.resize(size);
+	return result;
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+bool contains(Frustum3<V> const & frustum_, Vector3<V> const & point_)
+{
+	bool result = true;
+	for (auto const & plane : frustum_.planes)
+		result &= plane.signedDistance(point_) >= V(0);
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+bool intersects(Frustum3<V> const & frustum_, Sphere3<V> const & ball_)
+{
+	for (auto const & plane : frustum_.planes)
+	{
+		if (plane.signedDistance(ball_.center) < -ball_.getRadius())
+			return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+bool intersects(Frustum3<V> const & frustum_, Cuboid3<V> const & box_)
+{
+	Vector3<V> const halfExtent = box_.getHalfExtent();
+	for (auto const & plane : frustum_.planes)
+	{
+		V const reach = std::abs(plane.normal.x) * halfExtent.x + std::abs(plane.normal.y) * halfExtent.y + std::abs(plane.normal.z) * halfExtent.z;
+		if (plane.signedDistance(box_.center) < -reach)
+			return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+std::vector<std::uint32_t> findVisible(Frustum3<V> const & frustum_, Sphere3Array<V> const & balls_, std::size_t const threadCount_)
+{
+	V const * const radii = balls_.radii.data();
+	return priv::findVisibleShapes(frustum_, balls_.centers,
+		[radii](Vector3<V> const &, std::size_t const index_) { return radii[index_]; },
+		threadCount_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+std::vector<std::uint32_t> findVisible(Frustum3<V> const & frustum_, Cuboid3Array<V> const & boxes_, std::size_t const threadCount_)
+{
+	V const * const x = boxes_.halfExtents[0].data();
+	V const * const y = boxes_.halfExtents[1].data();
+	V const * const z = boxes_.halfExtents[2].data();
+	return priv::findVisibleShapes(frustum_, boxes_.centers,
+		[x, y, z](Vector3<V> const & absoluteNormal_, std::size_t const index_) {
+			return absoluteNormal_.x * x[index_] + absoluteNormal_.y * y[index_] + absoluteNormal_.z * z[index_];
+		},
+		threadCount_);
+}
+
+}
\ No newline at end of file
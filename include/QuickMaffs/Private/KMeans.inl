@@ -0,0 +1,443 @@
+// Note: this file is not meant to be included on its own.
+// Include "KMeans.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Number of points assigned together; their coordinates, distances and clusters fit into the first level cache.
+constexpr std::size_t cxKMeansBlock = 256;
+
+/// <summary>
+/// Per point distance bounds and per centroid data of Hamerly's pruning.
+/// </summary>
+template <typename V>
+struct KMeansBounds
+{
+	std::vector<V>	upper;				// Upper bound of distance of every point to its centroid.
+	std::vector<V>	lower;				// Lower bound of distance of every point to any other centroid.
+	std::vector<V>	shifts;				// Distance every centroid moved by in the last update.
+	std::vector<V>	halfSeparations;	// Half distance of every centroid to the nearest other one.
+	std::size_t		farthest = 0;		// Centroid that moved the most.
+	V				maxShift = 0;
+	V				secondShift = 0;	// Largest shift of the other centroids.
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Throws unless the cluster count suits the point count.
+/// </summary>
+template <template <typename> typename T, typename V>
+void checkKMeansInput(PointArray<T, V> const & points_, std::size_t const k_)
+{
+	if (points_.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("Too many points for k-means");
+	if (k_ == 0 || k_ > points_.size())
+		throw std::invalid_argument("Cluster count must be between 1 and point count");
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns squared distance between point `a_` of the first array and point `b_` of the second one.
+/// </summary>
+template <template <typename> typename T, typename V>
+V distanceSquared(PointArray<T, V> const & first_, std::size_t const a_, PointArray<T, V> const & second_, std::size_t const b_)
+{
+	V result = 0;
+	for (std::size_t d = 0; d < PointArray<T, V>::Dimensions; ++d)
+	{
+		V const difference = first_.coordinates[d][a_] - second_.coordinates[d][b_];
+		result += difference * difference;
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Finds the nearest centroid of the points [begin_, end_) and, when `TSecond` is set, the distance to the second nearest.
+/// Calls function_(point, centroid, distanceSquared, secondDistanceSquared) for every point in order.
+/// </summary>
+template <bool TSecond, template <typename> typename T, typename V, typename TFunction>
+void findNearestCentroids(PointArray<T, V> const & points_, PointArray<T, V> const & centroids_,
+						  std::size_t const begin_, std::size_t const end_, TFunction && function_)
+{
+	constexpr std::size_t Dimensions = PointArray<T, V>::Dimensions;
+
+	// The block is copied, so that the compiler sees no aliasing between the arrays of the distance loop.
+	V coordinates[Dimensions][cxKMeansBlock];
+	V nearest[cxKMeansBlock];
+	V second[cxKMeansBlock];
+	std::uint32_t clusters[cxKMeansBlock];
+
+	std::size_t const k = centroids_.size();
+	for (std::size_t blockBegin = begin_; blockBegin < end_; blockBegin += cxKMeansBlock)
+	{
+		std::size_t const blockSize = std::min(cxKMeansBlock, end_ - blockBegin);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			std::copy_n(points_.coordinates[d].data() + blockBegin, blockSize, coordinates[d]);
+		std::fill_n(nearest, blockSize, std::numeric_limits<V>::infinity());
+		std::fill_n(second, blockSize, std::numeric_limits<V>::infinity());
+		std::fill_n(clusters, blockSize, std::uint32_t(0));
+
+		for (std::size_t c = 0; c < k; ++c)
+		{
+			V centroid[Dimensions];
+			for (std::size_t d = 0; d < Dimensions; ++d)
+				centroid[d] = centroids_.coordinates[d][c];
+			std::uint32_t const cluster = static_cast<std::uint32_t>(c);
+
+			for (std::size_t i = 0; i < blockSize; ++i)
+			{
+				V distance = 0;
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					V const difference = coordinates[d][i] - centroid[d];
+					distance += difference * difference;
+				}
+
+				bool const closer = distance < nearest[i];
+				if constexpr (TSecond)
+				{
+					V const runnerUp = distance < second[i] ? distance : second[i];
+					second[i] = closer ? nearest[i] : runnerUp;
+				}
+				clusters[i] = closer ? cluster : clusters[i];
+				nearest[i] = closer ? distance : nearest[i];
+			}
+		}
+
+		for (std::size_t i = 0; i < blockSize; ++i)
+			function_(blockBegin + i, clusters[i], nearest[i], second[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Assigns the points [begin_, end_) to their nearest centroids, skipping the ones the bounds prove unchanged.
+/// Calls function_(point, centroid) for every point in order.
+/// </summary>
+template <template <typename> typename T, typename V, typename TFunction>
+void assignKMeansHamerly(PointArray<T, V> const & points_, PointArray<T, V> const & centroids_, KMeansBounds<V> & bounds_,
+						 std::uint32_t const * assignments_, std::size_t const begin_, std::size_t const end_, TFunction && function_)
+{
+	std::size_t const k = centroids_.size();
+	for (std::size_t i = begin_; i < end_; ++i)
+	{
+		// Bounds follow the centroids moved by the last update:
+		std::uint32_t cluster = assignments_[i];
+		V upper = bounds_.upper[i] + bounds_.shifts[cluster];
+		V lower = bounds_.lower[i] - (cluster == bounds_.farthest ? bounds_.secondShift : bounds_.maxShift);
+
+		V const threshold = std::max(bounds_.halfSeparations[cluster], lower);
+		if (upper > threshold)
+		{
+			upper = std::sqrt(distanceSquared(points_, i, centroids_, cluster));
+			if (upper > threshold)
+			{
+				V nearest = std::numeric_limits<V>::infinity();
+				V second = std::numeric_limits<V>::infinity();
+				for (std::size_t c = 0; c < k; ++c)
+				{
+					V const distance = distanceSquared(points_, i, centroids_, c);
+					if (distance < nearest)
+					{
+						second = nearest;
+						nearest = distance;
+						cluster = static_cast<std::uint32_t>(c);
+					}
+					else if (distance < second)
+						second = distance;
+				}
+				upper = std::sqrt(nearest);
+				lower = std::sqrt(second);
+			}
+		}
+
+		bounds_.upper[i] = upper;
+		bounds_.lower[i] = lower;
+		function_(i, cluster);
+	}
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> typename T, typename V>
+std::vector< T<V> > seedKMeans(PointArray<T, V> const & points_, std::size_t const k_, std::size_t const threadCount_)
+{
+	constexpr std::size_t Dimensions = PointArray<T, V>::Dimensions;
+	priv::checkKMeansInput(points_, k_);
+
+	std::size_t const count = points_.size();
+	std::size_t const chunkCount = priv::parallelChunkCount(count, threadCount_);
+	std::vector<V> nearest(count, std::numeric_limits<V>::infinity());
+	std::vector<double> chunkWeights(chunkCount);
+	std::vector<std::size_t> chunkBegins(chunkCount), chunkEnds(chunkCount);
+
+	std::vector< T<V> > result;
+	result.reserve(k_);
+	result.push_back(points_.get(random::generate<std::size_t>(0, count - 1)));
+	while (result.size() < k_)
+	{
+		// Squared distance of every point to the nearest centroid, and their sums per chunk:
+		T<V> const & centroid = result.back();
+		priv::parallelFor(count, threadCount_,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+			{
+				V * const distances = nearest.data();
+				V block[priv::cxKMeansBlock];
+				double weight = 0;
+				for (std::size_t blockBegin = begin_; blockBegin < end_; blockBegin += priv::cxKMeansBlock)
+				{
+					std::size_t const blockSize = std::min(priv::cxKMeansBlock, end_ - blockBegin);
+					std::fill_n(block, blockSize, V(0));
+					for (std::size_t d = 0; d < Dimensions; ++d)
+					{
+						V const * const coordinates = points_.coordinates[d].data() + blockBegin;
+						V const coordinate = centroid[d];
+						for (std::size_t i = 0; i < blockSize; ++i)
+						{
+							V const difference = coordinates[i] - coordinate;
+							block[i] += difference * difference;
+						}
+					}
+					for (std::size_t i = 0; i < blockSize; ++i)
+					{
+						V const distance = block[i] < distances[blockBegin + i] ? block[i] : distances[blockBegin + i];
+						distances[blockBegin + i] = distance;
+						weight += static_cast<double>(distance);
+					}
+				}
+				chunkWeights[chunk_] = weight;
+				chunkBegins[chunk_] = begin_;
+				chunkEnds[chunk_] = end_;
+			});
+
+		double totalWeight = 0;
+		for (double const weight : chunkWeights)
+			totalWeight += weight;
+
+		// All the points lie on centroids already; any of them will do.
+		if (!(totalWeight > 0))
+		{
+			result.push_back(points_.get(random::generate<std::size_t>(0, count - 1)));
+			continue;
+		}
+
+		// Walks the chunks, then the points of the chunk, until the drawn weight is used up.
+		// Rounding may leave a little of it: the last chunk with nonzero weight is never skipped,
+		// and within a chunk the last point with nonzero weight takes the rest.
+		std::size_t lastChunk = chunkCount - 1;
+		while (!(chunkWeights[lastChunk] > 0))
+			--lastChunk;
+
+		double remaining = random::generate<double>(0, totalWeight);
+		std::size_t chosen = count;
+		for (std::size_t chunk = 0; chunk <= lastChunk && chosen == count; ++chunk)
+		{
+			if (chunkWeights[chunk] <= 0)
+				continue;
+			if (remaining >= chunkWeights[chunk] && chunk < lastChunk)
+			{
+				remaining -= chunkWeights[chunk];
+				continue;
+			}
+			for (std::size_t i = chunkBegins[chunk]; i < chunkEnds[chunk]; ++i)
+			{
+				if (nearest[i] <= 0)
+					continue;
+				chosen = i;
+				remaining -= static_cast<double>(nearest[i]);
+				if (remaining < 0)
+					break;
+			}
+		}
+		result.push_back(points_.get(chosen));
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> typename T, typename V>
+KMeansResult<T, V> computeKMeans(PointArray<T, V> const & points_, std::vector< T<V> > centroids_,
+								 KMeansSettings<V> const & settings_, std::size_t const threadCount_)
+{
+	static_assert(std::is_floating_point_v<V>, "K-means requires floating point type");
+	constexpr std::size_t Dimensions = PointArray<T, V>::Dimensions;
+	priv::checkKMeansInput(points_, centroids_.size());
+
+	std::size_t const count = points_.size();
+	std::size_t const k = centroids_.size();
+	bool const pruned = settings_.pruning == KMeansPruning::Hamerly;
+
+	PointArray<T, V> centroids(centroids_);
+	std::vector<std::uint32_t> assignments(count, std::numeric_limits<std::uint32_t>::max());
+	priv::KMeansBounds<V> bounds;
+	if (pruned)
+	{
+		bounds.upper.resize(count);
+		bounds.lower.resize(count);
+		bounds.shifts.resize(k);
+		bounds.halfSeparations.resize(k);
+	}
+
+	// Every chunk of points sums its clusters into its own buffers:
+	std::size_t const chunkCount = priv::parallelChunkCount(count, threadCount_);
+	std::vector<V> sums(chunkCount * k * Dimensions);
+	std::vector<std::size_t> counts(chunkCount * k);
+	std::vector<std::size_t> changes(chunkCount);
+
+	KMeansResult<T, V> result{ {}, {}, V(0), 0, false };
+	bool assigned = false;		// Whether every point is assigned to the nearest of the current centroids.
+	for (std::size_t iteration = 0; iteration < settings_.maxIterations; ++iteration)
+	{
+		std::fill(sums.begin(), sums.end(), V(0));
+		std::fill(counts.begin(), counts.end(), std::size_t(0));
+		priv::parallelFor(count, threadCount_,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+			{
+				V * const chunkSums = sums.data() + chunk_ * k * Dimensions;
+				std::size_t * const chunkCounts = counts.data() + chunk_ * k;
+				std::size_t changed = 0;
+				auto accumulate = [&](std::size_t const point_, std::uint32_t const cluster_) {
+						changed += assignments[point_] != cluster_;
+						assignments[point_] = cluster_;
+						for (std::size_t d = 0; d < Dimensions; ++d)
+							chunkSums[cluster_ * Dimensions + d] += points_.coordinates[d][point_];
+						++chunkCounts[cluster_];
+					};
+
+				if (!pruned)
+				{
+					priv::findNearestCentroids<false>(points_, centroids, begin_, end_,
+						[&](std::size_t const point_, std::uint32_t const cluster_, V, V) { accumulate(point_, cluster_); });
+				}
+				else if (iteration == 0)
+				{
+					priv::findNearestCentroids<true>(points_, centroids, begin_, end_,
+						[&](std::size_t const point_, std::uint32_t const cluster_, V const nearest_, V const second_) {
+							bounds.upper[point_] = std::sqrt(nearest_);
+							bounds.lower[point_] = std::sqrt(second_);
+							accumulate(point_, cluster_);
+						});
+				}
+				else
+					priv::assignKMeansHamerly(points_, centroids, bounds, assignments.data(), begin_, end_, accumulate);
+				changes[chunk_] = changed;
+			});
+		result.iterations = iteration + 1;
+
+		std::size_t changed = 0;
+		for (std::size_t const chunkChanges : changes)
+			changed += chunkChanges;
+		if (changed == 0)
+		{
+			result.converged = true;
+			assigned = true;
+			break;
+		}
+
+		// Means of the clusters, adding the chunks in order:
+		bounds.farthest = 0;
+		bounds.maxShift = 0;
+		bounds.secondShift = 0;
+		for (std::size_t c = 0; c < k; ++c)
+		{
+			std::size_t members = 0;
+			V mean[Dimensions] = {};
+			for (std::size_t chunk = 0; chunk < chunkCount; ++chunk)
+			{
+				members += counts[chunk * k + c];
+				for (std::size_t d = 0; d < Dimensions; ++d)
+					mean[d] += sums[(chunk * k + c) * Dimensions + d];
+			}
+
+			V shiftSquared = 0;
+			if (members != 0)
+			{
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					V const coordinate = mean[d] / static_cast<V>(members);
+					V const difference = coordinate - centroids.coordinates[d][c];
+					shiftSquared += difference * difference;
+					centroids.coordinates[d][c] = coordinate;
+				}
+			}
+
+			V const shift = std::sqrt(shiftSquared);
+			if (pruned)
+				bounds.shifts[c] = shift;
+			if (shift > bounds.maxShift)
+			{
+				bounds.secondShift = bounds.maxShift;
+				bounds.maxShift = shift;
+				bounds.farthest = c;
+			}
+			else if (shift > bounds.secondShift)
+				bounds.secondShift = shift;
+		}
+
+		if (pruned)
+		{
+			for (std::size_t c = 0; c < k; ++c)
+			{
+				V closest = std::numeric_limits<V>::infinity();
+				for (std::size_t other = 0; other < k; ++other)
+				{
+					if (other != c)
+						closest = std::min(closest, priv::distanceSquared(centroids, c, centroids, other));
+				}
+				bounds.halfSeparations[c] = std::sqrt(closest) / V(2);
+			}
+		}
+
+		if (bounds.maxShift <= settings_.tolerance)
+		{
+			result.converged = true;
+			break;
+		}
+	}
+
+	// The last update moved the centroids; points follow them.
+	if (!assigned)
+	{
+		priv::parallelFor(count, threadCount_,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+			{
+				priv::findNearestCentroids<false>(points_, centroids, begin_, end_,
+					[&](std::size_t const point_, std::uint32_t const cluster_, V, V) { assignments[point_] = cluster_; });
+			});
+	}
+
+	std::vector<V> chunkInertia(chunkCount);
+	priv::parallelFor(count, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+		{
+			V inertia = 0;
+			for (std::size_t i = begin_; i < end_; ++i)
+				inertia += priv::distanceSquared(points_, i, centroids, assignments[i]);
+			chunkInertia[chunk_] = inertia;
+		});
+	for (V const inertia : chunkInertia)
+		result.inertia += inertia;
+
+	result.centroids.resize(k);
+	for (std::size_t c = 0; c < k; ++c)
+		result.centroids[c] = centroids.get(c);
+	result.assignments = std::move(assignments);
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> typename T, typename V>
+KMeansResult<T, V> computeKMeans(PointArray<T, V> const & points_, std::size_t const k_,
+								 KMeansSettings<V> const & settings_, std::size_t const threadCount_)
+{
+	return computeKMeans(points_, seedKMeans(points_, k_, threadCount_), settings_, threadCount_);
+}
+
+}
\ No newline at end of file
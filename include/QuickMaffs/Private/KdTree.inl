@@ -0,0 +1,293 @@
+// Note: this file is not meant to be included on its own.
+// Include "KdTree.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Ranges of at most this many points are leaves.
+constexpr std::size_t cxKdTreeLeafSize = 8;
+// Subtrees with at most this many points are never split into separate build tasks.
+constexpr std::size_t cxKdTreeMinTaskSize = 4096;
+// Traversal stack capacity; the tree depth is below 32 as the point count fits 32 bits.
+constexpr std::size_t cxKdTreeStackSize = 64;
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+KdTree<TVectorType, TValueType>::KdTree(std::vector<VectorType> points_, std::size_t const threadCount_)
+{
+	this->build(std::move(points_), threadCount_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void KdTree<TVectorType, TValueType>::build(std::vector<VectorType> points_, std::size_t const threadCount_)
+{
+	if (points_.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("Too many points for k-d tree");
+
+	// Points travel together with their indices, so the partitioning works on contiguous memory.
+	using ItemType = std::pair<VectorType, std::uint32_t>;
+	std::size_t const count = points_.size();
+	std::vector<ItemType> items(count);
+	for (std::size_t i = 0; i < count; ++i)
+		items[i] = ItemType{ points_[i], static_cast<std::uint32_t>(i) };
+	m_splitAxes.assign(count, 0);
+
+	std::size_t const threads = priv::resolveThreadCount(threadCount_);
+	std::size_t const taskSize = std::max(priv::cxKdTreeMinTaskSize, count / (threads * 8));
+
+	using RangeType = std::pair<std::size_t, std::size_t>;
+	auto buildRange = [&](std::size_t const begin_, std::size_t const end_, std::vector<RangeType> * tasks_, auto const & self_) -> void {
+			if (end_ - begin_ <= priv::cxKdTreeLeafSize)
+				return;
+			if (tasks_ != nullptr && end_ - begin_ <= taskSize)
+			{
+				tasks_->emplace_back(begin_, end_);
+				return;
+			}
+
+			VectorType lower = items[begin_].first;
+			VectorType upper = lower;
+			for (std::size_t i = begin_ + 1; i < end_; ++i)
+			{
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					lower[d] = std::min(lower[d], items[i].first[d]);
+					upper[d] = std::max(upper[d], items[i].first[d]);
+				}
+			}
+
+			std::size_t axis = 0;
+			for (std::size_t d = 1; d < Dimensions; ++d)
+			{
+				if (upper[d] - lower[d] > upper[axis] - lower[axis])
+					axis = d;
+			}
+
+			std::size_t const median = begin_ + (end_ - begin_) / 2;
+			std::nth_element(items.begin() + static_cast<std::ptrdiff_t>(begin_), items.begin() + static_cast<std::ptrdiff_t>(median),
+				items.begin() + static_cast<std::ptrdiff_t>(end_),
+				[axis](ItemType const & lhs_, ItemType const & rhs_) { return lhs_.first[axis] < rhs_.first[axis]; });
+			m_splitAxes[median] = static_cast<std::uint8_t>(axis);
+
+			self_(begin_, median, tasks_, self_);
+			self_(median + 1, end_, tasks_, self_);
+		};
+
+	if (threads == 1 || count <= taskSize)
+		buildRange(0, count, nullptr, buildRange);
+	else
+	{
+		std::vector<RangeType> tasks;
+		buildRange(0, count, &tasks, buildRange);
+
+		// Largest subtrees first, handed out one by one to balance the threads:
+		std::sort(tasks.begin(), tasks.end(),
+			[](RangeType const & lhs_, RangeType const & rhs_) { return lhs_.second - lhs_.first > rhs_.second - rhs_.first; });
+
+		std::atomic<std::size_t> nextTask{ 0 };
+		priv::parallelFor(std::min(threads, tasks.size()), threads,
+			[&](std::size_t, std::size_t, std::size_t)
+			{
+				for (std::size_t t = nextTask++; t < tasks.size(); t = nextTask++)
+					buildRange(tasks[t].first, tasks[t].second, nullptr, buildRange);
+			});
+	}
+
+	m_points.resize(count);
+	m_pointIndices.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		m_points[i] = items[i].first;
+		m_pointIndices[i] = items[i].second;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::size_t KdTree<TVectorType, TValueType>::size() const
+{
+	return m_points.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<typename KdTree<TVectorType, TValueType>::VectorType> const & KdTree<TVectorType, TValueType>::getPoints() const
+{
+	return m_points;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<std::uint32_t> const & KdTree<TVectorType, TValueType>::getPointIndices() const
+{
+	return m_pointIndices;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename KdTree<TVectorType, TValueType>::NeighborType KdTree<TVectorType, TValueType>::findNearest(VectorType const & query_) const
+{
+	std::vector<NeighborType> heap;
+	heap.reserve(1);
+	this->searchNearest(query_, 1, heap);
+	return heap.empty() ? NeighborType{ npos, priv::farthestDistance<ValueType>() } : heap.front();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<typename KdTree<TVectorType, TValueType>::NeighborType> KdTree<TVectorType, TValueType>::findNearest(VectorType const & query_,
+																								std::size_t const k_) const
+{
+	std::vector<NeighborType> heap;
+	heap.reserve(std::min(k_, m_points.size()));
+	this->searchNearest(query_, k_, heap);
+	priv::sortNeighbors(heap);
+	return heap;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<typename KdTree<TVectorType, TValueType>::NeighborType> KdTree<TVectorType, TValueType>::findNearest(
+	std::vector<VectorType> const & queries_, std::size_t const k_, std::size_t const threadCount_) const
+{
+	std::vector<NeighborType> result(queries_.size() * k_, NeighborType{ npos, priv::farthestDistance<ValueType>() });
+	priv::parallelFor(queries_.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			std::vector<NeighborType> heap;
+			heap.reserve(std::min(k_, m_points.size()));
+			for (std::size_t q = begin_; q < end_; ++q)
+			{
+				this->searchNearest(queries_[q], k_, heap);
+				priv::sortNeighbors(heap);
+				std::copy(heap.begin(), heap.end(), result.begin() + static_cast<std::ptrdiff_t>(q * k_));
+			}
+		});
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+template <typename TFunction>
+void KdTree<TVectorType, TValueType>::forEachInRadius(VectorType const & center_, ValueType const radius_, TFunction && function_) const
+{
+	ValueType const radiusSquared = radius_ * radius_;
+
+	std::pair<std::size_t, std::size_t> stack[priv::cxKdTreeStackSize];
+	std::size_t top = 0;
+	stack[top++] = { 0, m_points.size() };
+	while (top > 0)
+	{
+		auto const [begin, end] = stack[--top];
+		if (end - begin <= priv::cxKdTreeLeafSize)
+		{
+			for (std::size_t i = begin; i < end; ++i)
+			{
+				ValueType const distanceSquared = center_.distanceSquared(m_points[i]);
+				if (distanceSquared <= radiusSquared)
+					function_(static_cast<std::size_t>(m_pointIndices[i]), distanceSquared);
+			}
+			continue;
+		}
+
+		std::size_t const median = begin + (end - begin) / 2;
+		ValueType const distanceSquared = center_.distanceSquared(m_points[median]);
+		if (distanceSquared <= radiusSquared)
+			function_(static_cast<std::size_t>(m_pointIndices[median]), distanceSquared);
+
+		// A side is visited when the ball reaches it:
+		std::size_t const axis = m_splitAxes[median];
+		ValueType const offset = center_[axis] - m_points[median][axis];
+		bool const reachesOther = offset * offset <= radiusSquared;
+		if (offset < ValueType(0) || reachesOther)
+			stack[top++] = { begin, median };
+		if (offset >= ValueType(0) || reachesOther)
+			stack[top++] = { median + 1, end };
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<std::size_t> KdTree<TVectorType, TValueType>::findInRadius(VectorType const & center_, ValueType const radius_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachInRadius(center_, radius_, [&result](std::size_t const index_, ValueType) { result.push_back(index_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector< std::vector<std::size_t> > KdTree<TVectorType, TValueType>::findInRadius(std::vector<VectorType> const & centers_,
+																					ValueType const radius_, std::size_t const threadCount_) const
+{
+	std::vector< std::vector<std::size_t> > result(centers_.size());
+	priv::parallelFor(centers_.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t q = begin_; q < end_; ++q)
+				result[q] = this->findInRadius(centers_[q], radius_);
+		});
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void KdTree<TVectorType, TValueType>::searchNearest(VectorType const & query_, std::size_t const k_, std::vector<NeighborType> & heap_) const
+{
+	heap_.clear();
+	if (k_ == 0 || m_points.empty())
+		return;
+
+	// Every range is pushed with a lower bound of its distance, so ranges beyond the k-th neighbor are skipped.
+	struct Range
+	{
+		std::size_t	begin, end;
+		ValueType	bound;
+	};
+	Range stack[priv::cxKdTreeStackSize];
+	std::size_t top = 0;
+	stack[top++] = { 0, m_points.size(), ValueType(0) };
+	while (top > 0)
+	{
+		Range const range = stack[--top];
+		if (heap_.size() == k_ && range.bound >= heap_.front().distanceSquared)
+			continue;
+
+		if (range.end - range.begin <= priv::cxKdTreeLeafSize)
+		{
+			for (std::size_t i = range.begin; i < range.end; ++i)
+				priv::offerNeighbor(heap_, k_, NeighborType{ m_pointIndices[i], query_.distanceSquared(m_points[i]) });
+			continue;
+		}
+
+		std::size_t const median = range.begin + (range.end - range.begin) / 2;
+		priv::offerNeighbor(heap_, k_, NeighborType{ m_pointIndices[median], query_.distanceSquared(m_points[median]) });
+
+		// Near side is pushed last, so it is visited first:
+		std::size_t const axis = m_splitAxes[median];
+		ValueType const offset = query_[axis] - m_points[median][axis];
+		Range const before{ range.begin, median, range.bound };
+		Range const after{ median + 1, range.end, range.bound };
+		ValueType const farBound = std::max(range.bound, offset * offset);
+		if (offset < ValueType(0))
+		{
+			stack[top++] = { after.begin, after.end, farBound };
+			stack[top++] = before;
+		}
+		else
+		{
+			stack[top++] = { before.begin, before.end, farBound };
+			stack[top++] = after;
+		}
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,275 @@
+// Note: this file is not meant to be included on its own.
+// Include "LinearTree.hpp" instead.
+
+#include "Parallel.hpp"
+#include "RadixSort.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Nodes with at most this many points are leaves. Also the block size of the leaf tests.
+constexpr std::size_t cxLinearTreeLeafSize = 16;
+// Levels with at least this many nodes are built in parallel.
+constexpr std::size_t cxLinearTreeParallelLevel = 1024;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Spreads the low bits of the value apart, so that `TDimensions - 1` zero bits follow each of them.
+/// </summary>
+template <std::size_t TDimensions>
+std::uint64_t spreadMortonBits(std::uint64_t value_)
+{
+	if constexpr (TDimensions == 2)
+	{
+		value_ &= 0x00000000ffffffffull;
+		value_ = (value_ | (value_ << 16)) & 0x0000ffff0000ffffull;
+		value_ = (value_ | (value_ << 8)) & 0x00ff00ff00ff00ffull;
+		value_ = (value_ | (value_ << 4)) & 0x0f0f0f0f0f0f0f0full;
+		value_ = (value_ | (value_ << 2)) & 0x3333333333333333ull;
+		value_ = (value_ | (value_ << 1)) & 0x5555555555555555ull;
+	}
+	else
+	{
+		value_ &= 0x00000000001fffffull;
+		value_ = (value_ | (value_ << 32)) & 0x001f00000000ffffull;
+		value_ = (value_ | (value_ << 16)) & 0x001f0000ff0000ffull;
+		value_ = (value_ | (value_ << 8)) & 0x100f00f00f00f00full;
+		value_ = (value_ | (value_ << 4)) & 0x10c30c30c30c30c3ull;
+		value_ = (value_ | (value_ << 2)) & 0x1249249249249249ull;
+	}
+	return value_;
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+LinearTree<TVectorType, TValueType>::LinearTree(std::vector<VectorType> points_, std::size_t const threadCount_)
+{
+	this->build(std::move(points_), threadCount_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void LinearTree<TVectorType, TValueType>::build(std::vector<VectorType> points_, std::size_t const threadCount_)
+{
+	if (points_.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("Too many points for linear tree");
+
+	std::size_t const count = points_.size();
+	m_nodes.clear();
+	m_points.clear();
+	m_pointIndices.clear();
+	if (count == 0)
+		return;
+
+	// Bounds of the points:
+	std::vector<AabbType> chunkBounds(priv::parallelChunkCount(count, threadCount_), AabbType::empty());
+	priv::parallelFor(count, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+				chunkBounds[chunk_].extend(points_[i]);
+		});
+	AabbType bounds = AabbType::empty();
+	for (auto const & chunk : chunkBounds)
+		bounds.extend(chunk);
+
+	// Morton keys of the points quantized to the grid over the bounds:
+	constexpr std::uint64_t cells = std::uint64_t(1) << Levels;
+	std::array<double, Dimensions> scales;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		double const extent = static_cast<double>(bounds.upper[d]) - static_cast<double>(bounds.lower[d]);
+		scales[d] = extent > 0.0 ? static_cast<double>(cells) / extent : 0.0;
+	}
+
+	std::vector<std::uint64_t> keys(count);
+	m_pointIndices.resize(count);
+	priv::parallelFor(count, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				std::uint64_t key = 0;
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					double const cell = (static_cast<double>(points_[i][d]) - static_cast<double>(bounds.lower[d])) * scales[d];
+					std::uint64_t const quantized = std::min(cells - 1, static_cast<std::uint64_t>(std::max(cell, 0.0)));
+					key |= priv::spreadMortonBits<Dimensions>(quantized) << d;
+				}
+				keys[i] = key;
+				m_pointIndices[i] = static_cast<std::uint32_t>(i);
+			}
+		});
+	priv::radixSort(keys, m_pointIndices, threadCount_);
+
+	m_points.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
+		m_points[i] = points_[m_pointIndices[i]];
+
+	// Nodes level by level. A node splits into the runs of equal digits of its keys at the next level.
+	auto forEachChild = [&keys](Node const & node_, std::size_t const level_, auto && function_) {
+			if (node_.end - node_.begin <= priv::cxLinearTreeLeafSize || level_ >= Levels)
+				return;
+
+			std::size_t const shift = (Levels - 1 - level_) * Dimensions;
+			auto digit = [shift](std::uint64_t const key_) { return (key_ >> shift) & ((std::uint64_t(1) << Dimensions) - 1); };
+
+			auto const first = keys.begin();
+			for (std::size_t begin = node_.begin; begin < node_.end; )
+			{
+				std::uint64_t const childDigit = digit(keys[begin]);
+				std::size_t const end = static_cast<std::size_t>(std::partition_point(first + static_cast<std::ptrdiff_t>(begin),
+						first + static_cast<std::ptrdiff_t>(node_.end),
+						[&](std::uint64_t const key_) { return digit(key_) <= childDigit; })
+					- first);
+				function_(begin, end);
+				begin = end;
+			}
+		};
+
+	m_nodes.push_back(Node{ AabbType::empty(), 0, static_cast<std::uint32_t>(count), 0, 0 });
+	std::vector<std::size_t> levelStarts{ 0 };
+	for (std::size_t level = 0; levelStarts.back() < m_nodes.size(); ++level)
+	{
+		std::size_t const levelBegin = levelStarts.back();
+		std::size_t const levelEnd = m_nodes.size();
+		std::size_t const levelThreads = levelEnd - levelBegin >= priv::cxLinearTreeParallelLevel ? threadCount_ : 1;
+
+		std::vector<std::uint32_t> childOffsets(levelEnd - levelBegin + 1, 0);
+		priv::parallelFor(levelEnd - levelBegin, levelThreads,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+			{
+				for (std::size_t i = begin_; i < end_; ++i)
+					forEachChild(m_nodes[levelBegin + i], level, [&](std::size_t, std::size_t) { ++childOffsets[i + 1]; });
+			});
+		for (std::size_t i = 1; i < childOffsets.size(); ++i)
+			childOffsets[i] += childOffsets[i - 1];
+
+		m_nodes.resize(levelEnd + childOffsets.back());
+		priv::parallelFor(levelEnd - levelBegin, levelThreads,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+			{
+				for (std::size_t i = begin_; i < end_; ++i)
+				{
+					Node & node = m_nodes[levelBegin + i];
+					node.firstChild = static_cast<std::uint32_t>(levelEnd + childOffsets[i]);
+					node.childCount = childOffsets[i + 1] - childOffsets[i];
+
+					std::size_t child = node.firstChild;
+					forEachChild(node, level, [&](std::size_t const childBegin_, std::size_t const childEnd_) {
+							m_nodes[child++] = Node{ AabbType::empty(), static_cast<std::uint32_t>(childBegin_), static_cast<std::uint32_t>(childEnd_), 0, 0 };
+						});
+				}
+			});
+		levelStarts.push_back(levelEnd);
+	}
+
+	// Tight bounds, deepest level first:
+	for (std::size_t level = levelStarts.size() - 1; level-- > 0; )
+	{
+		std::size_t const levelBegin = levelStarts[level];
+		std::size_t const levelEnd = levelStarts[level + 1];
+		std::size_t const levelThreads = levelEnd - levelBegin >= priv::cxLinearTreeParallelLevel ? threadCount_ : 1;
+		priv::parallelFor(levelEnd - levelBegin, levelThreads,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+			{
+				for (std::size_t i = levelBegin + begin_; i < levelBegin + end_; ++i)
+				{
+					Node & node = m_nodes[i];
+					if (node.childCount == 0)
+					{
+						for (std::size_t p = node.begin; p < node.end; ++p)
+							node.bounds.extend(m_points[p]);
+					}
+					for (std::size_t c = node.firstChild; c < node.firstChild + node.childCount; ++c)
+						node.bounds.extend(m_nodes[c].bounds);
+				}
+			});
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::size_t LinearTree<TVectorType, TValueType>::size() const
+{
+	return m_points.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<typename LinearTree<TVectorType, TValueType>::Node> const & LinearTree<TVectorType, TValueType>::getNodes() const
+{
+	return m_nodes;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<typename LinearTree<TVectorType, TValueType>::VectorType> const & LinearTree<TVectorType, TValueType>::getPoints() const
+{
+	return m_points;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::vector<std::uint32_t> const & LinearTree<TVectorType, TValueType>::getPointIndices() const
+{
+	return m_pointIndices;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+template <typename TQueryShapeType, typename TFunction>
+void LinearTree<TVectorType, TValueType>::forEachInside(TQueryShapeType const & shape_, TFunction && function_) const
+{
+	if (m_nodes.empty())
+		return;
+
+	// At most the siblings of every node on the path are pending:
+	std::uint32_t stack[(std::size_t(1) << Dimensions) * (Levels + 1)];
+	std::size_t top = 0;
+	stack[top++] = 0;
+
+	std::uint8_t mask[priv::cxLinearTreeLeafSize];
+	while (top > 0)
+	{
+		Node const & node = m_nodes[stack[--top]];
+		if (!intersects(shape_, node.bounds))
+			continue;
+
+		// Children in reverse, so they are visited in Morton order:
+		if (node.childCount != 0)
+		{
+			for (std::uint32_t c = node.childCount; c-- > 0; )
+				stack[top++] = node.firstChild + c;
+			continue;
+		}
+
+		for (std::size_t begin = node.begin; begin < node.end; begin += priv::cxLinearTreeLeafSize)
+		{
+			std::size_t const blockSize = std::min<std::size_t>(priv::cxLinearTreeLeafSize, node.end - begin);
+			isPointInside(shape_, m_points.data() + begin, blockSize, mask);
+			for (std::size_t i = 0; i < blockSize; ++i)
+			{
+				if (mask[i])
+					function_(static_cast<std::size_t>(m_pointIndices[begin + i]));
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+template <typename TQueryShapeType>
+std::vector<std::size_t> LinearTree<TVectorType, TValueType>::findInside(TQueryShapeType const & shape_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachInside(shape_, [&result](std::size_t const index_) { result.push_back(index_); });
+	return result;
+}
+
+}
\ No newline at end of file
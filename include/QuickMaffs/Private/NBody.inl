@@ -0,0 +1,253 @@
+// Note: this file is not meant to be included on its own.
+// Include "NBody.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Number of bodies accumulated together by the direct summation: one cache line of every coordinate.
+template <typename V>
+constexpr std::size_t cxGravityTile = 64 / sizeof(V);
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+std::vector< Vector3<V> > computeGravityDirect(Point3Array<V> const & positions_, std::vector<V> const & masses_,
+											   GravitySettings<V> const & settings_, std::size_t const threadCount_)
+{
+	if (masses_.size() != positions_.size())
+		throw std::invalid_argument("Mass count must match position count");
+
+	constexpr std::size_t cxTile = priv::cxGravityTile<V>;
+
+	std::size_t const count = positions_.size();
+	std::vector< Vector3<V> > result(count);
+	V const * const xs = positions_.coordinates[0].data();
+	V const * const ys = positions_.coordinates[1].data();
+	V const * const zs = positions_.coordinates[2].data();
+	V const * const masses = masses_.data();
+	V const bias = settings_.softening * settings_.softening + std::numeric_limits<V>::min();
+
+	priv::parallelFor((count + cxTile - 1) / cxTile, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t tile = begin_; tile < end_; ++tile)
+			{
+				std::size_t const first = tile * cxTile;
+				std::size_t const width = std::min(cxTile, count - first);
+
+				// Lanes past the end repeat the last body; their results are dropped.
+				V tx[cxTile], ty[cxTile], tz[cxTile];
+				V ax[cxTile] = {}, ay[cxTile] = {}, az[cxTile] = {};
+				for (std::size_t k = 0; k < cxTile; ++k)
+				{
+					std::size_t const target = first + std::min(k, width - 1);
+					tx[k] = xs[target];
+					ty[k] = ys[target];
+					tz[k] = zs[target];
+				}
+
+				for (std::size_t j = 0; j < count; ++j)
+				{
+					V const sx = xs[j], sy = ys[j], sz = zs[j], mass = masses[j];
+					for (std::size_t k = 0; k < cxTile; ++k)
+					{
+						V const dx = sx - tx[k];
+						V const dy = sy - ty[k];
+						V const dz = sz - tz[k];
+						// No branch for coincident bodies: the bias keeps the inverse and its square finite,
+						// so the zero offset, scaled first, zeroes the term.
+						V const distanceSquared = dx * dx + dy * dy + dz * dz + bias;
+						V const inverse = V(1) / std::sqrt(distanceSquared);
+						V const inverseSquared = inverse * inverse;
+						V const weight = mass * inverse;
+						ax[k] += dx * inverseSquared * weight;
+						ay[k] += dy * inverseSquared * weight;
+						az[k] += dz * inverseSquared * weight;
+					}
+				}
+
+				for (std::size_t k = 0; k < width; ++k)
+					result[first + k] = Vector3<V>(ax[k], ay[k], az[k]) * settings_.gravitationalConstant;
+			}
+		});
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+BarnesHutTree3<TValueType>::BarnesHutTree3(std::vector<VectorType> positions_, std::vector<ValueType> const & masses_, std::size_t const threadCount_)
+{
+	this->build(std::move(positions_), masses_, threadCount_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+void BarnesHutTree3<TValueType>::build(std::vector<VectorType> positions_, std::vector<ValueType> const & masses_, std::size_t const threadCount_)
+{
+	if (masses_.size() != positions_.size())
+		throw std::invalid_argument("Mass count must match position count");
+
+	m_tree.build(std::move(positions_), threadCount_);
+
+	auto const & nodes = m_tree.getNodes();
+	auto const & points = m_tree.getPoints();
+	auto const & pointIndices = m_tree.getPointIndices();
+
+	m_masses.resize(points.size());
+	priv::parallelFor(points.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+				m_masses[i] = masses_[pointIndices[i]];
+		});
+
+	// Levels are contiguous and follow each other: a level ends where the children of its last parent end.
+	std::vector<std::size_t> levelStarts{ 0 };
+	if (!nodes.empty())
+	{
+		for (std::size_t levelEnd = 1; levelStarts.back() < nodes.size(); )
+		{
+			std::size_t childrenEnd = levelEnd;
+			for (std::size_t i = levelStarts.back(); i < levelEnd; ++i)
+			{
+				if (nodes[i].childCount != 0)
+					childrenEnd = std::size_t(nodes[i].firstChild) + nodes[i].childCount;
+			}
+			levelStarts.push_back(levelEnd);
+			levelEnd = childrenEnd;
+		}
+	}
+
+	// Mass distribution, deepest level first:
+	m_cells.resize(nodes.size());
+	for (std::size_t level = levelStarts.size() - 1; level-- > 0; )
+	{
+		std::size_t const levelBegin = levelStarts[level];
+		std::size_t const levelEnd = levelStarts[level + 1];
+		std::size_t const levelThreads = levelEnd - levelBegin >= priv::cxLinearTreeParallelLevel ? threadCount_ : 1;
+		priv::parallelFor(levelEnd - levelBegin, levelThreads,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+			{
+				for (std::size_t i = levelBegin + begin_; i < levelBegin + end_; ++i)
+				{
+					auto const & node = nodes[i];
+					VectorType moment;
+					ValueType mass = 0;
+					if (node.childCount == 0)
+					{
+						for (std::size_t p = node.begin; p < node.end; ++p)
+						{
+							moment += points[p] * m_masses[p];
+							mass += m_masses[p];
+						}
+					}
+					for (std::size_t c = node.firstChild; c < node.firstChild + node.childCount; ++c)
+					{
+						moment += m_cells[c].centerOfMass * m_cells[c].mass;
+						mass += m_cells[c].mass;
+					}
+
+					// Massless cells sit in the middle of their bounds, where they do no harm.
+					VectorType const extent = node.bounds.getExtent();
+					m_cells[i].centerOfMass = mass > 0 ? moment / mass : node.bounds.lower + extent / ValueType(2);
+					m_cells[i].mass = mass;
+					m_cells[i].size = std::max({ extent.x, extent.y, extent.z });
+				}
+			});
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::size_t BarnesHutTree3<TValueType>::size() const
+{
+	return m_tree.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+typename BarnesHutTree3<TValueType>::TreeType const & BarnesHutTree3<TValueType>::getTree() const
+{
+	return m_tree;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+typename BarnesHutTree3<TValueType>::VectorType BarnesHutTree3<TValueType>::computeAcceleration(VectorType const & point_, SettingsType const & settings_) const
+{
+	auto const & nodes = m_tree.getNodes();
+	auto const & points = m_tree.getPoints();
+
+	VectorType acceleration;
+	if (nodes.empty())
+		return acceleration;
+
+	ValueType const softeningSquared = settings_.softening * settings_.softening;
+	ValueType const openingSquared = settings_.openingAngle * settings_.openingAngle;
+	auto pull = [&](VectorType const & offset_, ValueType const mass_) {
+			ValueType const distanceSquared = offset_.lengthSquared() + softeningSquared;
+			if (distanceSquared > 0)
+				acceleration += offset_ * (mass_ / (distanceSquared * std::sqrt(distanceSquared)));
+		};
+
+	// At most the siblings of every node on the path are pending:
+	std::uint32_t stack[8 * (TreeType::Levels + 1)];
+	std::size_t top = 0;
+	stack[top++] = 0;
+	while (top > 0)
+	{
+		std::uint32_t const index = stack[--top];
+		auto const & node = nodes[index];
+		Cell const & cell = m_cells[index];
+		if (cell.mass == 0)
+			continue;
+
+		VectorType const offset = cell.centerOfMass - point_;
+		bool const inside = point_.x >= node.bounds.lower.x && point_.x <= node.bounds.upper.x
+						 && point_.y >= node.bounds.lower.y && point_.y <= node.bounds.upper.y
+						 && point_.z >= node.bounds.lower.z && point_.z <= node.bounds.upper.z;
+		if (!inside && cell.size * cell.size < openingSquared * offset.lengthSquared())
+		{
+			pull(offset, cell.mass);
+			continue;
+		}
+
+		if (node.childCount != 0)
+		{
+			for (std::uint32_t c = 0; c < node.childCount; ++c)
+				stack[top++] = node.firstChild + c;
+			continue;
+		}
+
+		for (std::size_t p = node.begin; p < node.end; ++p)
+			pull(points[p] - point_, m_masses[p]);
+	}
+	return acceleration * settings_.gravitationalConstant;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::vector<typename BarnesHutTree3<TValueType>::VectorType> BarnesHutTree3<TValueType>::computeAccelerations(SettingsType const & settings_,
+																											   std::size_t const threadCount_) const
+{
+	auto const & points = m_tree.getPoints();
+	auto const & pointIndices = m_tree.getPointIndices();
+
+	// Bodies in Morton order: neighboring queries walk the same cells.
+	std::vector<VectorType> result(points.size());
+	priv::parallelFor(points.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+				result[pointIndices[i]] = this->computeAcceleration(points[i], settings_);
+		});
+	return result;
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,157 @@
+// Note: this file is not meant to be included on its own.
+// Include "NearestNeighbors.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Number of queries processed together against a block of points.
+constexpr std::size_t cxNeighborQueryTile = 8;
+// Number of points in a block; the distances of a tile fit into the first level cache.
+constexpr std::size_t cxNeighborPointBlock = 256;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns the distance larger than any other: infinity, or maximum for integer types.
+/// </summary>
+template <typename TValueType>
+constexpr TValueType farthestDistance()
+{
+	return std::numeric_limits<TValueType>::has_infinity ? std::numeric_limits<TValueType>::infinity() : std::numeric_limits<TValueType>::max();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Offers the neighbor to the max-heap of the k nearest ones found so far.
+/// </summary>
+template <typename TNeighborType>
+void offerNeighbor(std::vector<TNeighborType> & heap_, std::size_t const k_, TNeighborType const & neighbor_)
+{
+	auto const farther = [](TNeighborType const & lhs_, TNeighborType const & rhs_) { return lhs_.distanceSquared < rhs_.distanceSquared; };
+	if (heap_.size() < k_)
+	{
+		heap_.push_back(neighbor_);
+		std::push_heap(heap_.begin(), heap_.end(), farther);
+	}
+	else if (neighbor_.distanceSquared < heap_.front().distanceSquared)
+	{
+		std::pop_heap(heap_.begin(), heap_.end(), farther);
+		heap_.back() = neighbor_;
+		std::push_heap(heap_.begin(), heap_.end(), farther);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Sorts the max-heap of neighbors, nearest first.
+/// </summary>
+template <typename TNeighborType>
+void sortNeighbors(std::vector<TNeighborType> & heap_)
+{
+	std::sort_heap(heap_.begin(), heap_.end(),
+		[](TNeighborType const & lhs_, TNeighborType const & rhs_) { return lhs_.distanceSquared < rhs_.distanceSquared; });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Finds k nearest points of the queries [begin_, end_) and writes them to `result_` (k_ per query).
+/// </summary>
+template <template <typename> typename T, typename V>
+void findNearestNeighborsRange(PointArray<T, V> const & points_, T<V> const * queries_, std::size_t const begin_, std::size_t const end_,
+								std::size_t const k_, Neighbor<V> * result_)
+{
+	constexpr std::size_t Dimensions = PointArray<T, V>::Dimensions;
+
+	std::size_t const count = points_.size();
+	if (k_ == 0 || count == 0)
+		return;
+
+	std::array< std::vector< Neighbor<V> >, cxNeighborQueryTile > heaps;
+	for (auto & heap : heaps)
+		heap.reserve(std::min(k_, count));
+
+	V distances[cxNeighborPointBlock];
+	for (std::size_t tileBegin = begin_; tileBegin < end_; tileBegin += cxNeighborQueryTile)
+	{
+		std::size_t const tileSize = std::min(cxNeighborQueryTile, end_ - tileBegin);
+		for (std::size_t q = 0; q < tileSize; ++q)
+			heaps[q].clear();
+
+		for (std::size_t blockBegin = 0; blockBegin < count; blockBegin += cxNeighborPointBlock)
+		{
+			std::size_t const blockSize = std::min(cxNeighborPointBlock, count - blockBegin);
+			for (std::size_t q = 0; q < tileSize; ++q)
+			{
+				T<V> const & query = queries_[tileBegin + q];
+
+				std::fill_n(distances, blockSize, V(0));
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					V const * coordinates = points_.coordinates[d].data() + blockBegin;
+					V const coordinate = query[d];
+					for (std::size_t i = 0; i < blockSize; ++i)
+					{
+						V const difference = coordinates[i] - coordinate;
+						distances[i] += difference * difference;
+					}
+				}
+
+				auto & heap = heaps[q];
+				V threshold = heap.size() < k_ ? farthestDistance<V>() : heap.front().distanceSquared;
+				for (std::size_t i = 0; i < blockSize; ++i)
+				{
+					if (distances[i] < threshold || heap.size() < k_)
+					{
+						offerNeighbor(heap, k_, Neighbor<V>{ blockBegin + i, distances[i] });
+						if (heap.size() == k_)
+							threshold = heap.front().distanceSquared;
+					}
+				}
+			}
+		}
+
+		for (std::size_t q = 0; q < tileSize; ++q)
+		{
+			sortNeighbors(heaps[q]);
+			std::copy(heaps[q].begin(), heaps[q].end(), result_ + (tileBegin + q) * k_);
+		}
+	}
+}
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> typename T, typename V>
+std::vector< Neighbor<V> > findNearestNeighbors(PointArray<T, V> const & points_, T<V> const & query_, std::size_t const k_)
+{
+	std::vector< Neighbor<V> > result(std::min(k_, points_.size()));
+	if (result.empty())
+		return result;
+
+	priv::findNearestNeighborsRange(points_, &query_, 0, 1, k_, result.data());
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> typename T, typename V>
+std::vector< Neighbor<V> > findNearestNeighbors(PointArray<T, V> const & points_, std::vector< T<V> > const & queries_,
+												std::size_t const k_, std::size_t const threadCount_)
+{
+	std::vector< Neighbor<V> > result(queries_.size() * k_,
+		Neighbor<V>{ std::numeric_limits<std::size_t>::max(), priv::farthestDistance<V>() });
+	if (k_ == 0 || points_.size() == 0)
+		return result;
+
+	priv::parallelFor(queries_.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			priv::findNearestNeighborsRange(points_, queries_.data(), begin_, end_, k_, result.data());
+		});
+	return result;
+}
+
+}
\ No newline at end of file
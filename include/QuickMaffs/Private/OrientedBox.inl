@@ -0,0 +1,374 @@
+// Note: this file is not meant to be included on its own.
+// Include "OrientedBox.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Tolerance added to absolute rotation entries of oriented box tests, in machine epsilons.
+constexpr int cxOrientedBoxTolerance = 64;
+
+// Maximum number of Jacobi sweeps of computeOrientedBoundingBox.
+constexpr int cxJacobiSweeps = 32;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns axes of the coordinate system.
+/// </summary>
+template <typename TVectorType>
+constexpr auto coordinateAxes()
+{
+	constexpr std::size_t dimensions = TVectorType{}.size();
+
+	std::array<TVectorType, dimensions> axes{};
+	for (std::size_t d = 0; d < dimensions; ++d)
+		axes[d][d] = 1;
+	return axes;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Diagonalizes the symmetric matrix with cyclic Jacobi rotations.
+/// Returns the eigenvectors in columns of `vectors_`; eigenvalues are left on the diagonal of `matrix_`.
+/// </summary>
+template <typename TValueType, std::size_t TDimensions>
+void diagonalizeSymmetric(TValueType (&matrix_)[TDimensions][TDimensions], TValueType (&vectors_)[TDimensions][TDimensions])
+{
+	using V = TValueType;
+
+	V scale = V(0);
+	for (std::size_t i = 0; i < TDimensions; ++i)
+	{
+		for (std::size_t j = 0; j < TDimensions; ++j)
+		{
+			vectors_[i][j] = V(i == j);
+			scale += matrix_[i][j] * matrix_[i][j];
+		}
+	}
+
+	V const threshold = scale * std::numeric_limits<V>::epsilon() * std::numeric_limits<V>::epsilon();
+	for (int sweep = 0; sweep < cxJacobiSweeps; ++sweep)
+	{
+		V offDiagonal = V(0);
+		for (std::size_t p = 0; p < TDimensions; ++p)
+		{
+			for (std::size_t q = p + 1; q < TDimensions; ++q)
+				offDiagonal += matrix_[p][q] * matrix_[p][q];
+		}
+		if (offDiagonal <= threshold)
+			break;
+
+		for (std::size_t p = 0; p < TDimensions; ++p)
+		{
+			for (std::size_t q = p + 1; q < TDimensions; ++q)
+			{
+				if (matrix_[p][q] == V(0))
+					continue;
+
+				// Rotation by angle zeroing matrix_[p][q]; t = tan(angle), smaller root for stability.
+				V const theta = (matrix_[q][q] - matrix_[p][p]) / (V(2) * matrix_[p][q]);
+				V const t = (theta >= V(0) ? V(1) : V(-1)) / (std::abs(theta) + std::sqrt(theta * theta + V(1)));
+				V const c = V(1) / std::sqrt(t * t + V(1));
+				V const s = t * c;
+
+				for (std::size_t k = 0; k < TDimensions; ++k)
+				{
+					V const kp = matrix_[k][p];
+					V const kq = matrix_[k][q];
+					matrix_[k][p] = c * kp - s * kq;
+					matrix_[k][q] = s * kp + c * kq;
+				}
+				for (std::size_t k = 0; k < TDimensions; ++k)
+				{
+					V const pk = matrix_[p][k];
+					V const qk = matrix_[q][k];
+					matrix_[p][k] = c * pk - s * qk;
+					matrix_[q][k] = s * pk + c * qk;
+				}
+				for (std::size_t k = 0; k < TDimensions; ++k)
+				{
+					V const kp = vectors_[k][p];
+					V const kq = vectors_[k][q];
+					vectors_[k][p] = c * kp - s * kq;
+					vectors_[k][q] = s * kp + c * kq;
+				}
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Sums of coordinates and of their pairwise products over a chunk of points, relative to a reference point.
+/// </summary>
+template <typename TValueType, std::size_t TDimensions>
+struct CovarianceSums
+{
+	TValueType	sums[TDimensions]					= {};
+	TValueType	products[TDimensions][TDimensions]	= {};
+};
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr OrientedBox< TVectorType, TValueType >::OrientedBox()
+	:
+	center{},
+	axes{ priv::coordinateAxes<VectorType>() },
+	halfExtent{}
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr OrientedBox< TVectorType, TValueType >::OrientedBox(VectorType const & center_, std::array<VectorType, Dimensions> const & axes_,
+																VectorType const & halfExtent_)
+	:
+	center{ center_ },
+	axes{ axes_ },
+	halfExtent{ halfExtent_ }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr OrientedBox< TVectorType, TValueType >::OrientedBox(BoxType const & box_)
+	:
+	center{ box_.center },
+	axes{ priv::coordinateAxes<VectorType>() },
+	halfExtent{ box_.getHalfExtent() }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+OrientedBox<T, V> computeOrientedBoundingBox(T<V> const * points_, std::size_t const count_, std::size_t const threadCount_)
+{
+	using VectorType = T<V>;
+	using SumsType = priv::CovarianceSums<V, VectorType{}.size()>;
+	constexpr std::size_t dimensions = VectorType{}.size();
+
+	if (count_ == 0)
+		return OrientedBox<T, V>{};
+
+	VectorType const reference = points_[0];
+
+	// Pass 1: covariance.
+	std::vector<SumsType> chunkSums(priv::parallelChunkCount(count_, threadCount_));
+	priv::parallelFor(count_, threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_) {
+			SumsType sums;
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				auto const components = priv::vectorComponents(points_[i] - reference);
+				for (std::size_t d = 0; d < dimensions; ++d)
+				{
+					sums.sums[d] += components[d];
+					for (std::size_t e = d; e < dimensions; ++e)
+						sums.products[d][e] += components[d] * components[e];
+				}
+			}
+			chunkSums[chunk_] = sums;
+		});
+
+	V mean[dimensions] = {};
+	V covariance[dimensions][dimensions] = {};
+	for (SumsType const & sums : chunkSums)
+	{
+		for (std::size_t d = 0; d < dimensions; ++d)
+		{
+			mean[d] += sums.sums[d];
+			for (std::size_t e = d; e < dimensions; ++e)
+				covariance[d][e] += sums.products[d][e];
+		}
+	}
+
+	V const inverseCount = V(1) / static_cast<V>(count_);
+	for (std::size_t d = 0; d < dimensions; ++d)
+		mean[d] *= inverseCount;
+	for (std::size_t d = 0; d < dimensions; ++d)
+	{
+		for (std::size_t e = d; e < dimensions; ++e)
+		{
+			covariance[d][e] = covariance[d][e] * inverseCount - mean[d] * mean[e];
+			covariance[e][d] = covariance[d][e];
+		}
+	}
+
+	V vectors[dimensions][dimensions];
+	priv::diagonalizeSymmetric(covariance, vectors);
+
+	// Major axis first.
+	std::array<std::size_t, dimensions> order;
+	for (std::size_t d = 0; d < dimensions; ++d)
+		order[d] = d;
+	std::sort(order.begin(), order.end(), [&](std::size_t const lhs_, std::size_t const rhs_) {
+			return covariance[lhs_][lhs_] > covariance[rhs_][rhs_];
+		});
+
+	std::array<VectorType, dimensions> axes;
+	for (std::size_t k = 0; k < dimensions; ++k)
+	{
+		for (std::size_t d = 0; d < dimensions; ++d)
+			axes[k][d] = vectors[d][order[k]];
+		axes[k].normalizeSelf();
+	}
+	if constexpr (dimensions == 3)
+		axes[2] = axes[0].cross(axes[1]).normalize();
+
+	// Pass 2: extents along the axes.
+	using RangeType = std::array< std::pair<V, V>, dimensions >;
+	std::vector<RangeType> chunkRanges(chunkSums.size());
+	priv::parallelFor(count_, threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_) {
+			RangeType ranges;
+			ranges.fill({ std::numeric_limits<V>::max(), std::numeric_limits<V>::lowest() });
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				VectorType const offset = points_[i] - reference;
+				for (std::size_t k = 0; k < dimensions; ++k)
+				{
+					V const projection = offset.dot(axes[k]);
+					ranges[k].first = std::min(ranges[k].first, projection);
+					ranges[k].second = std::max(ranges[k].second, projection);
+				}
+			}
+			chunkRanges[chunk_] = ranges;
+		});
+
+	OrientedBox<T, V> result{ reference, axes, VectorType{} };
+	for (std::size_t k = 0; k < dimensions; ++k)
+	{
+		V lower = chunkRanges[0][k].first;
+		V upper = chunkRanges[0][k].second;
+		for (RangeType const & ranges : chunkRanges)
+		{
+			lower = std::min(lower, ranges[k].first);
+			upper = std::max(upper, ranges[k].second);
+		}
+		result.center += axes[k] * ((lower + upper) / V(2));
+		result.halfExtent[k] = (upper - lower) / V(2);
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+bool intersects(OrientedBox<T, V> const & lhs_, OrientedBox<T, V> const & rhs_)
+{
+	constexpr std::size_t dimensions = OrientedBox<T, V>::Dimensions;
+	V const tolerance = std::numeric_limits<V>::epsilon() * V(priv::cxOrientedBoxTolerance);
+
+	// Rotation of rhs_ axes in lhs_ frame.
+	V rotation[dimensions][dimensions];
+	V absoluteRotation[dimensions][dimensions];
+	for (std::size_t i = 0; i < dimensions; ++i)
+	{
+		for (std::size_t j = 0; j < dimensions; ++j)
+		{
+			rotation[i][j] = lhs_.axes[i].dot(rhs_.axes[j]);
+			absoluteRotation[i][j] = std::abs(rotation[i][j]) + tolerance;
+		}
+	}
+
+	T<V> const offset = rhs_.center - lhs_.center;
+	V translation[dimensions];
+	for (std::size_t i = 0; i < dimensions; ++i)
+		translation[i] = offset.dot(lhs_.axes[i]);
+
+	// Face axes of lhs_.
+	for (std::size_t i = 0; i < dimensions; ++i)
+	{
+		V rhsRadius = V(0);
+		for (std::size_t j = 0; j < dimensions; ++j)
+			rhsRadius += rhs_.halfExtent[j] * absoluteRotation[i][j];
+		if (std::abs(translation[i]) > lhs_.halfExtent[i] + rhsRadius)
+			return false;
+	}
+
+	// Face axes of rhs_.
+	for (std::size_t j = 0; j < dimensions; ++j)
+	{
+		V lhsRadius = V(0);
+		V distance = V(0);
+		for (std::size_t i = 0; i < dimensions; ++i)
+		{
+			lhsRadius += lhs_.halfExtent[i] * absoluteRotation[i][j];
+			distance += translation[i] * rotation[i][j];
+		}
+		if (std::abs(distance) > lhsRadius + rhs_.halfExtent[j])
+			return false;
+	}
+
+	// Cross products of axes (lhs_.axes[i] x rhs_.axes[j]), expressed in lhs_ frame.
+	if constexpr (dimensions == 3)
+	{
+		for (std::size_t i = 0; i < 3; ++i)
+		{
+			std::size_t const i1 = (i + 1) % 3;
+			std::size_t const i2 = (i + 2) % 3;
+			for (std::size_t j = 0; j < 3; ++j)
+			{
+				std::size_t const j1 = (j + 1) % 3;
+				std::size_t const j2 = (j + 2) % 3;
+				V const lhsRadius = lhs_.halfExtent[i1] * absoluteRotation[i2][j] + lhs_.halfExtent[i2] * absoluteRotation[i1][j];
+				V const rhsRadius = rhs_.halfExtent[j1] * absoluteRotation[i][j2] + rhs_.halfExtent[j2] * absoluteRotation[i][j1];
+				V const distance = translation[i2] * rotation[i1][j] - translation[i1] * rotation[i2][j];
+				if (std::abs(distance) > lhsRadius + rhsRadius)
+					return false;
+			}
+		}
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+bool intersects(OrientedBox<T, V> const & orientedBox_, Box<T, V> const & box_)
+{
+	return intersects(orientedBox_, OrientedBox<T, V>{ box_ });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+bool intersects(Box<T, V> const & box_, OrientedBox<T, V> const & orientedBox_)
+{
+	return intersects(orientedBox_, box_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+bool intersects(OrientedBox<T, V> const & orientedBox_, Ball<T, V> const & ball_)
+{
+	// Distance from the ball center to the nearest point of the box, measured in the box frame.
+	T<V> const offset = ball_.center - orientedBox_.center;
+	V distanceSquared = V(0);
+	for (std::size_t k = 0; k < orientedBox_.Dimensions; ++k)
+	{
+		V const outside = priv::distanceOutside(std::abs(offset.dot(orientedBox_.axes[k])), orientedBox_.halfExtent[k]);
+		distanceSquared += outside * outside;
+	}
+	return distanceSquared <= ball_.getRadius() * ball_.getRadius();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+bool intersects(Ball<T, V> const & ball_, OrientedBox<T, V> const & orientedBox_)
+{
+	return intersects(orientedBox_, ball_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+Aabb<T, V> computeBounds(OrientedBox<T, V> const & orientedBox_)
+{
+	T<V> extent;
+	for (std::size_t k = 0; k < orientedBox_.Dimensions; ++k)
+		extent += orientedBox_.axes[k].absolute() * orientedBox_.halfExtent[k];
+	return Aabb<T, V>{ orientedBox_.center - extent, orientedBox_.center + extent };
+}
+
+}
\ No newline at end of file
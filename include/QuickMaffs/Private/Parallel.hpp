@@ -0,0 +1,41 @@
+#pragma once
+
+#include "PrecompiledHeader.hpp"
+
+namespace quickmaffs::priv
+{
+
+/// <summary>
+/// Resolves number of worker threads to use.
+/// </summary>
+/// <param name="threadCount_">Requested thread count; 0 means one thread per hardware thread.</param>
+/// <returns>Number of worker threads (at least 1).</returns>
+std::size_t resolveThreadCount(std::size_t const threadCount_);
+
+/// <summary>
+/// Splits range [0, count_) into contiguous chunks and processes them on separate threads.
+/// </summary>
+/// <param name="count_">The number of elements.</param>
+/// <param name="threadCount_">Requested thread count; 0 means one thread per hardware thread.</param>
+/// <param name="function_">Callable invoked as function_(begin, end, chunkIndex) for every chunk.</param>
+/// <returns>Number of chunks the range was split into.</returns>
+/// <remarks>
+/// <para>
+/// The calling thread processes the first chunk. Chunk indices are dense, so they can be used
+/// to address per-thread partial buffers. First exception thrown by a chunk is rethrown after all threads finish.
+/// </para>
+/// </remarks>
+template <typename TFunction>
+std::size_t parallelFor(std::size_t const count_, std::size_t const threadCount_, TFunction && function_);
+
+/// <summary>
+/// Returns number of chunks <see cref="parallelFor"/> would split a range into.
+/// </summary>
+/// <param name="count_">The number of elements.</param>
+/// <param name="threadCount_">Requested thread count; 0 means one thread per hardware thread.</param>
+/// <returns>Number of chunks.</returns>
+std::size_t parallelChunkCount(std::size_t const count_, std::size_t const threadCount_);
+
+} // namespace quickmaffs::priv
+
+#include "Parallel.inl"
\ No newline at end of file
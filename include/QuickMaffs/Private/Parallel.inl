@@ -0,0 +1,72 @@
+// Note: this file is not meant to be included on its own.
+// Include "Parallel.hpp" instead.
+
+namespace quickmaffs::priv
+{
+
+////////////////////////////////////////////////////////////////////////
+inline std::size_t resolveThreadCount(std::size_t const threadCount_)
+{
+	if (threadCount_ != 0)
+		return threadCount_;
+
+	return std::max(std::size_t(1), static_cast<std::size_t>(std::thread::hardware_concurrency()));
+}
+
+////////////////////////////////////////////////////////////////////////
+inline std::size_t parallelChunkCount(std::size_t const count_, std::size_t const threadCount_)
+{
+	return std::min(count_, resolveThreadCount(threadCount_));
+}
+
+////////////////////////////////////////////////////////////////////////
+template <typename TFunction>
+inline std::size_t parallelFor(std::size_t const count_, std::size_t const threadCount_, TFunction && function_)
+{
+	std::size_t const chunkCount = parallelChunkCount(count_, threadCount_);
+	if (chunkCount <= 1)
+	{
+		if (count_ != 0)
+			function_(std::size_t(0), count_, std::size_t(0));
+		return chunkCount;
+	}
+
+	auto chunkBegin = [&](std::size_t const chunk_) {
+			return count_ / chunkCount * chunk_ + std::min(chunk_, count_ % chunkCount);
+		};
+
+	std::vector<std::exception_ptr> errors(chunkCount);
+	std::vector<std::thread> workers;
+	workers.reserve(chunkCount - 1);
+
+	for (std::size_t chunk = 1; chunk < chunkCount; ++chunk)
+	{
+		workers.emplace_back([&, chunk] {
+				try {
+					function_(chunkBegin(chunk), chunkBegin(chunk + 1), chunk);
+				}
+				catch (...) {
+					errors[chunk] = std::current_exception();
+				}
+			});
+	}
+
+	try {
+		function_(chunkBegin(0), chunkBegin(1), std::size_t(0));
+	}
+	catch (...) {
+		errors[0] = std::current_exception();
+	}
+
+	for (auto & worker : workers)
+		worker.join();
+
+	for (auto const & error : errors)
+	{
+		if (error)
+			std::rethrow_exception(error);
+	}
+	return chunkCount;
+}
+
+} // namespace quickmaffs::priv
\ No newline at end of file
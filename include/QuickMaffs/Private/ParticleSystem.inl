@@ -0,0 +1,352 @@
+// Note: this file is not meant to be included on its own.
+// Include "ParticleSystem.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Number of particles integrated and collided together by ParticleSystem::step.
+constexpr std::size_t cxParticleBlock = 256;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Copy of positions and velocities of up to cxParticleBlock particles.
+/// Kernels work on the copy, which the compiler knows does not alias, so it vectorizes their loops.
+/// </summary>
+template <typename TValueType, std::size_t TDimensions>
+struct ParticleBlock
+{
+	TValueType	positions[TDimensions][cxParticleBlock];
+	TValueType	velocities[TDimensions][cxParticleBlock];
+	std::size_t	size;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Advances positions and velocities of the block.
+/// </summary>
+template <typename TVectorType, typename TValueType, std::size_t TDimensions>
+void integrateParticles(ParticleBlock<TValueType, TDimensions> & block_, TVectorType const & acceleration_,
+						TValueType const timeStep_, ParticleIntegrator const integrator_)
+{
+	using V = TValueType;
+	for (std::size_t d = 0; d < TDimensions; ++d)
+	{
+		V * positions = block_.positions[d];
+		V * velocities = block_.velocities[d];
+		V const velocityChange = acceleration_[d] * timeStep_;
+		if (integrator_ == ParticleIntegrator::SemiImplicitEuler)
+		{
+			for (std::size_t i = 0; i < block_.size; ++i)
+			{
+				velocities[i] += velocityChange;
+				positions[i] += velocities[i] * timeStep_;
+			}
+		}
+		else
+		{
+			V const positionChange = velocityChange * timeStep_ / V(2);
+			for (std::size_t i = 0; i < block_.size; ++i)
+			{
+				positions[i] += velocities[i] * timeStep_ + positionChange;
+				velocities[i] += velocityChange;
+			}
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Moves particles of the block out of the ball and reflects their velocities.
+/// </summary>
+template <typename TVectorType, typename TValueType, std::size_t TDimensions>
+void collideParticles(ParticleBlock<TValueType, TDimensions> & block_, TVectorType const & center_, TValueType const radius_,
+					  TValueType const restitution_)
+{
+	using V = TValueType;
+	V const radiusSquared = radius_ * radius_;
+	V const bounce = V(1) + restitution_;
+
+	for (std::size_t i = 0; i < block_.size; ++i)
+	{
+		V offsets[TDimensions];
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < TDimensions; ++d)
+		{
+			offsets[d] = block_.positions[d][i] - center_[d];
+			distanceSquared += offsets[d] * offsets[d];
+		}
+		// A particle at the center has no direction of its own; it is pushed out along the first axis.
+		V const centered = distanceSquared > V(0) ? V(0) : V(1);
+		offsets[0] += centered;
+		V const distance = std::sqrt(distanceSquared);
+		V const inverse = V(1) / (distance + centered);
+
+		V normalVelocity = V(0);
+		for (std::size_t d = 0; d < TDimensions; ++d)
+			normalVelocity += block_.velocities[d][i] * offsets[d] * inverse;
+
+		// Single-condition selects of precomputed values keep the loop free of branches.
+		bool const inside = distanceSquared < radiusSquared;
+		V const approaching = normalVelocity < V(0) ? -bounce * normalVelocity : V(0);
+		V const impulse = inside ? approaching : V(0);
+		V const push = inside ? radius_ - distance : V(0);
+		for (std::size_t d = 0; d < TDimensions; ++d)
+		{
+			V const normal = offsets[d] * inverse;
+			block_.positions[d][i] += normal * push;
+			block_.velocities[d][i] += normal * impulse;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Moves particles of the block out of the box through its closest face and reflects their velocities.
+/// </summary>
+template <typename TVectorType, typename TValueType, std::size_t TDimensions>
+void collideParticles(ParticleBlock<TValueType, TDimensions> & block_, TVectorType const & center_, TVectorType const & halfExtent_,
+					  TValueType const restitution_)
+{
+	using V = TValueType;
+	V const bounce = V(1) + restitution_;
+
+	for (std::size_t i = 0; i < block_.size; ++i)
+	{
+		V offsets[TDimensions];
+		V depths[TDimensions];
+		V minimumDepth = std::numeric_limits<V>::infinity();
+		for (std::size_t d = 0; d < TDimensions; ++d)
+		{
+			offsets[d] = block_.positions[d][i] - center_[d];
+			depths[d] = halfExtent_[d] - std::abs(offsets[d]);
+			minimumDepth = std::min(minimumDepth, depths[d]);
+		}
+
+		// Only the first axis of the smallest depth is pushed; nothing is pushed when the particle is outside.
+		V remaining = minimumDepth > V(0) ? V(1) : V(0);
+		for (std::size_t d = 0; d < TDimensions; ++d)
+		{
+			V const selected = depths[d] <= minimumDepth ? remaining : V(0);
+			remaining -= selected;
+
+			V const direction = offsets[d] >= V(0) ? V(1) : V(-1);
+			V const normalVelocity = block_.velocities[d][i] * direction;
+			V const impulse = normalVelocity < V(0) ? -bounce * normalVelocity : V(0);
+			block_.positions[d][i] += direction * depths[d] * selected;
+			block_.velocities[d][i] += direction * impulse * selected;
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Moves particles of the block back into the container and reflects their velocities.
+/// </summary>
+template <typename TVectorType, typename TValueType, std::size_t TDimensions>
+void containParticles(ParticleBlock<TValueType, TDimensions> & block_, TVectorType const & lower_, TVectorType const & upper_,
+					  TValueType const restitution_)
+{
+	using V = TValueType;
+	V const bounce = V(1) + restitution_;
+
+	for (std::size_t d = 0; d < TDimensions; ++d)
+	{
+		V * positions = block_.positions[d];
+		V * velocities = block_.velocities[d];
+		V const lower = lower_[d];
+		V const upper = upper_[d];
+		for (std::size_t i = 0; i < block_.size; ++i)
+		{
+			V const position = positions[i];
+			V const velocity = velocities[i];
+			V const outwardBelow = std::min(velocity, V(0));
+			V const outwardAbove = std::max(velocity, V(0));
+			V const outwardAboveOnly = position > upper ? outwardAbove : V(0);
+			V const outward = position < lower ? outwardBelow : outwardAboveOnly;
+			velocities[i] = velocity - bounce * outward;
+			positions[i] = std::min(std::max(position, lower), upper);
+		}
+	}
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::size_t ParticleSystem< TVectorType, TValueType >::size() const
+{
+	return m_positions.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::reserve(std::size_t const capacity_)
+{
+	m_positions.reserve(capacity_);
+	m_velocities.reserve(capacity_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::clear()
+{
+	m_positions.clear();
+	m_velocities.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::addParticle(VectorType const & position_, VectorType const & velocity_)
+{
+	m_positions.push_back(position_);
+	m_velocities.push_back(velocity_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename ParticleSystem< TVectorType, TValueType >::ArrayType const & ParticleSystem< TVectorType, TValueType >::getPositions() const
+{
+	return m_positions;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename ParticleSystem< TVectorType, TValueType >::ArrayType & ParticleSystem< TVectorType, TValueType >::getPositions()
+{
+	return m_positions;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename ParticleSystem< TVectorType, TValueType >::ArrayType const & ParticleSystem< TVectorType, TValueType >::getVelocities() const
+{
+	return m_velocities;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename ParticleSystem< TVectorType, TValueType >::ArrayType & ParticleSystem< TVectorType, TValueType >::getVelocities()
+{
+	return m_velocities;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::setAcceleration(VectorType const & acceleration_)
+{
+	m_acceleration = acceleration_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename ParticleSystem< TVectorType, TValueType >::VectorType const & ParticleSystem< TVectorType, TValueType >::getAcceleration() const
+{
+	return m_acceleration;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::setIntegrator(ParticleIntegrator const integrator_)
+{
+	m_integrator = integrator_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+ParticleIntegrator ParticleSystem< TVectorType, TValueType >::getIntegrator() const
+{
+	return m_integrator;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::setRestitution(ValueType const restitution_)
+{
+	m_restitution = restitution_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+TValueType ParticleSystem< TVectorType, TValueType >::getRestitution() const
+{
+	return m_restitution;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::setContainer(BoxType const & container_)
+{
+	m_container = container_;
+	m_hasContainer = true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::removeContainer()
+{
+	m_hasContainer = false;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::addObstacle(BallType const & ball_)
+{
+	m_ballObstacles.push_back(ball_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::addObstacle(BoxType const & box_)
+{
+	m_boxObstacles.push_back(box_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::clearObstacles()
+{
+	m_ballObstacles.clear();
+	m_boxObstacles.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void ParticleSystem< TVectorType, TValueType >::step(ValueType const timeStep_, std::size_t const threadCount_)
+{
+	VectorType const containerLower = m_container.center - m_container.getHalfExtent();
+	VectorType const containerUpper = m_container.center + m_container.getHalfExtent();
+
+	priv::parallelFor(this->size(), threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t) {
+			priv::ParticleBlock<ValueType, Dimensions> block;
+			for (std::size_t blockBegin = begin_; blockBegin < end_; blockBegin += priv::cxParticleBlock)
+			{
+				block.size = std::min(priv::cxParticleBlock, end_ - blockBegin);
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					std::copy_n(m_positions.coordinates[d].data() + blockBegin, block.size, block.positions[d]);
+					std::copy_n(m_velocities.coordinates[d].data() + blockBegin, block.size, block.velocities[d]);
+				}
+
+				priv::integrateParticles(block, m_acceleration, timeStep_, m_integrator);
+				for (BallType const & ball : m_ballObstacles)
+					priv::collideParticles(block, ball.center, ball.getRadius(), m_restitution);
+				for (BoxType const & box : m_boxObstacles)
+					priv::collideParticles(block, box.center, box.getHalfExtent(), m_restitution);
+				if (m_hasContainer)
+					priv::containParticles(block, containerLower, containerUpper, m_restitution);
+
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					std::copy_n(block.positions[d], block.size, m_positions.coordinates[d].data() + blockBegin);
+					std::copy_n(block.velocities[d], block.size, m_velocities.coordinates[d].data() + blockBegin);
+				}
+			}
+		});
+}
+
+}
\ No newline at end of file
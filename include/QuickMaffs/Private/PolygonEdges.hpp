@@ -0,0 +1,55 @@
+#pragma once
+
+#include "PrecompiledHeader.hpp"
+
+#include "../Polygon2.hpp"
+
+namespace quickmaffs::priv
+{
+
+/// <summary>
+/// Single directed polygon edge.
+/// </summary>
+template <typename TValueType>
+struct PolygonEdge2
+{
+	Vector2<TValueType> from, to;
+};
+
+/// <summary>
+/// Collects edges of all specified polygons into a flat container. Zero-length edges are skipped.
+/// </summary>
+/// <param name="polygons_">The polygons.</param>
+/// <param name="ringStarts_">When not null, receives index of the first edge of every nonempty ring, followed by the edge count.</param>
+/// <returns>Edges of all polygons; edges of a ring are consecutive.</returns>
+template <typename TValueType>
+std::vector< PolygonEdge2<TValueType> > collectPolygonEdges(std::vector< Polygon2<TValueType> > const & polygons_,
+															std::vector<std::size_t> * ringStarts_ = nullptr)
+{
+	std::size_t edgeCount = 0;
+	for (auto const & polygon : polygons_)
+		edgeCount += polygon.getPointCount();
+
+	std::vector< PolygonEdge2<TValueType> > edges;
+	edges.reserve(edgeCount);
+	for (auto const & polygon : polygons_)
+	{
+		auto const & points = polygon.getPoints();
+		if (points.size() < 2)
+			continue;
+
+		std::size_t const ringStart = edges.size();
+		for (std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+		{
+			if (points[j].x != points[i].x || points[j].y != points[i].y)
+				edges.push_back({ points[j], points[i] });
+		}
+		if (ringStarts_ && edges.size() != ringStart)
+			ringStarts_->push_back(ringStart);
+	}
+	if (ringStarts_)
+		ringStarts_->push_back(edges.size());
+	return edges;
+}
+
+} // namespace quickmaffs::priv
\ No newline at end of file
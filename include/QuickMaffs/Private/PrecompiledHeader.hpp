@@ -10,5 +10,13 @@
 #include <algorithm>
 #include <random>
 #include <chrono>
+#include <array>
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <exception>
 
 // TODO: reference additional headers your program requires here
\ No newline at end of file
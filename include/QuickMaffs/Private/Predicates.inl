@@ -0,0 +1,414 @@
+// Note: this file is not meant to be included on its own.
+// Include "Predicates.hpp" instead.
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+/// <summary>
+/// Holds machine dependent constants used by the exact predicates.
+/// </summary>
+template <typename TValueType>
+struct PredicateConstants
+{
+	static_assert(std::is_floating_point_v<TValueType>, "Geometric predicates require floating point values.");
+
+	// Half of the machine epsilon (2^-p, where p is the mantissa length).
+	static constexpr TValueType epsilon = std::numeric_limits<TValueType>::epsilon() / TValueType(2);
+
+	// Used to split a value into two halves of p/2 bits: 2^ceil(p/2) + 1.
+	static constexpr TValueType splitter = []{
+			TValueType result = 1;
+			for (int i = 0; i < (std::numeric_limits<TValueType>::digits + 1) / 2; ++i)
+				result *= TValueType(2);
+			return result + TValueType(1);
+		}();
+
+	static constexpr TValueType orientation2ErrorBound	= (TValueType(3) + TValueType(16) * epsilon) * epsilon;
+	static constexpr TValueType orientation3ErrorBound	= (TValueType(7) + TValueType(56) * epsilon) * epsilon;
+	static constexpr TValueType inCircleErrorBound		= (TValueType(10) + TValueType(96) * epsilon) * epsilon;
+};
+
+/// <summary>
+/// Floating point expansion - a sum of nonoverlapping components, sorted by increasing magnitude.
+/// </summary>
+template <typename TValueType, std::size_t TCapacity>
+struct Expansion
+{
+	std::array<TValueType, TCapacity>	terms;
+	std::size_t							count = 0;
+
+	/// <summary>
+	/// Returns approximate value of the expansion.
+	/// </summary>
+	/// <returns>Approximate value of the expansion.</returns>
+	TValueType estimate() const
+	{
+		TValueType result = 0;
+		for (std::size_t i = 0; i < count; ++i)
+			result += terms[i];
+		return result;
+	}
+};
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+inline void fastTwoSum(TValueType const a_, TValueType const b_, TValueType & x_, TValueType & y_)
+{
+	x_ = a_ + b_;
+	TValueType const bVirtual = x_ - a_;
+	y_ = b_ - bVirtual;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+inline void twoSum(TValueType const a_, TValueType const b_, TValueType & x_, TValueType & y_)
+{
+	x_ = a_ + b_;
+	TValueType const bVirtual = x_ - a_;
+	TValueType const aVirtual = x_ - bVirtual;
+	y_ = (a_ - aVirtual) + (b_ - bVirtual);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+inline void twoDiff(TValueType const a_, TValueType const b_, TValueType & x_, TValueType & y_)
+{
+	x_ = a_ - b_;
+	TValueType const bVirtual = a_ - x_;
+	TValueType const aVirtual = x_ + bVirtual;
+	y_ = (a_ - aVirtual) + (bVirtual - b_);
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+inline void split(TValueType const a_, TValueType & high_, TValueType & low_)
+{
+	TValueType const c = PredicateConstants<TValueType>::splitter * a_;
+	TValueType const aBig = c - a_;
+	high_ = c - aBig;
+	low_ = a_ - high_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+inline void twoProductPresplit(TValueType const a_, TValueType const b_, TValueType const bHigh_, TValueType const bLow_,
+								TValueType & x_, TValueType & y_)
+{
+	x_ = a_ * b_;
+	TValueType aHigh, aLow;
+	split(a_, aHigh, aLow);
+	TValueType const err1 = x_ - (aHigh * bHigh_);
+	TValueType const err2 = err1 - (aLow * bHigh_);
+	TValueType const err3 = err2 - (aHigh * bLow_);
+	y_ = (aLow * bLow_) - err3;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+inline Expansion<TValueType, 2> exactDifference(TValueType const a_, TValueType const b_)
+{
+	Expansion<TValueType, 2> result;
+	twoDiff(a_, b_, result.terms[1], result.terms[0]);
+	result.count = 2;
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::size_t fastExpansionSumZeroElim(std::size_t const eCount_, TValueType const * e_,
+									std::size_t const fCount_, TValueType const * f_, TValueType * h_)
+{
+	std::size_t eIndex = 0, fIndex = 0, hIndex = 0;
+	TValueType eNow = e_[0];
+	TValueType fNow = f_[0];
+	TValueType q, qNew, hh;
+
+	auto nextE = [&]{ ++eIndex; if (eIndex < eCount_) eNow = e_[eIndex]; };
+	auto nextF = [&]{ ++fIndex; if (fIndex < fCount_) fNow = f_[fIndex]; };
+
+	if ((fNow > eNow) == (fNow > -eNow)) {
+		q = eNow; nextE();
+	}
+	else {
+		q = fNow; nextF();
+	}
+
+	if (eIndex < eCount_ && fIndex < fCount_)
+	{
+		if ((fNow > eNow) == (fNow > -eNow)) {
+			fastTwoSum(eNow, q, qNew, hh); nextE();
+		}
+		else {
+			fastTwoSum(fNow, q, qNew, hh); nextF();
+		}
+		q = qNew;
+		if (hh != 0)
+			h_[hIndex++] = hh;
+
+		while (eIndex < eCount_ && fIndex < fCount_)
+		{
+			if ((fNow > eNow) == (fNow > -eNow)) {
+				twoSum(q, eNow, qNew, hh); nextE();
+			}
+			else {
+				twoSum(q, fNow, qNew, hh); nextF();
+			}
+			q = qNew;
+			if (hh != 0)
+				h_[hIndex++] = hh;
+		}
+	}
+	while (eIndex < eCount_)
+	{
+		twoSum(q, eNow, qNew, hh); nextE();
+		q = qNew;
+		if (hh != 0)
+			h_[hIndex++] = hh;
+	}
+	while (fIndex < fCount_)
+	{
+		twoSum(q, fNow, qNew, hh); nextF();
+		q = qNew;
+		if (hh != 0)
+			h_[hIndex++] = hh;
+	}
+	if (q != 0 || hIndex == 0)
+		h_[hIndex++] = q;
+	return hIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::size_t scaleExpansionZeroElim(std::size_t const eCount_, TValueType const * e_, TValueType const b_, TValueType * h_)
+{
+	TValueType bHigh, bLow;
+	split(b_, bHigh, bLow);
+
+	TValueType q, hh, product1, product0, sum;
+	twoProductPresplit(e_[0], b_, bHigh, bLow, q, hh);
+
+	std::size_t hIndex = 0;
+	if (hh != 0)
+		h_[hIndex++] = hh;
+
+	for (std::size_t eIndex = 1; eIndex < eCount_; ++eIndex)
+	{
+		twoProductPresplit(e_[eIndex], b_, bHigh, bLow, product1, product0);
+		twoSum(q, product0, sum, hh);
+		if (hh != 0)
+			h_[hIndex++] = hh;
+		fastTwoSum(product1, sum, q, hh);
+		if (hh != 0)
+			h_[hIndex++] = hh;
+	}
+	if (q != 0 || hIndex == 0)
+		h_[hIndex++] = q;
+	return hIndex;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType, std::size_t N, std::size_t M>
+Expansion<TValueType, N + M> operator + (Expansion<TValueType, N> const & e_, Expansion<TValueType, M> const & f_)
+{
+	Expansion<TValueType, N + M> result;
+	result.count = fastExpansionSumZeroElim(e_.count, e_.terms.data(), f_.count, f_.terms.data(), result.terms.data());
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType, std::size_t N, std::size_t M>
+Expansion<TValueType, N + M> operator - (Expansion<TValueType, N> const & e_, Expansion<TValueType, M> f_)
+{
+	for (std::size_t i = 0; i < f_.count; ++i)
+		f_.terms[i] = -f_.terms[i];
+	return e_ + f_;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType, std::size_t N, std::size_t M>
+Expansion<TValueType, 2 * N * M> operator * (Expansion<TValueType, N> const & e_, Expansion<TValueType, M> const & f_)
+{
+	Expansion<TValueType, 2 * N * M> result;
+	result.count = scaleExpansionZeroElim(e_.count, e_.terms.data(), f_.terms[0], result.terms.data());
+
+	std::array<TValueType, 2 * N>		scaled;
+	std::array<TValueType, 2 * N * M>	accumulated;
+	for (std::size_t i = 1; i < f_.count; ++i)
+	{
+		std::size_t const scaledCount = scaleExpansionZeroElim(e_.count, e_.terms.data(), f_.terms[i], scaled.data());
+		result.count = fastExpansionSumZeroElim(result.count, result.terms.data(), scaledCount, scaled.data(), accumulated.data());
+		std::copy_n(accumulated.data(), result.count, result.terms.data());
+	}
+	return result;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType orientation2Exact(Vector2<TValueType> const & a_, Vector2<TValueType> const & b_, Vector2<TValueType> const & c_)
+{
+	auto const acx = exactDifference(a_.x, c_.x);
+	auto const acy = exactDifference(a_.y, c_.y);
+	auto const bcx = exactDifference(b_.x, c_.x);
+	auto const bcy = exactDifference(b_.y, c_.y);
+
+	return (acx * bcy - acy * bcx).estimate();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType orientation3Exact(Vector3<TValueType> const & a_, Vector3<TValueType> const & b_,
+							Vector3<TValueType> const & c_, Vector3<TValueType> const & d_)
+{
+	auto const adx = exactDifference(a_.x, d_.x), ady = exactDifference(a_.y, d_.y), adz = exactDifference(a_.z, d_.z);
+	auto const bdx = exactDifference(b_.x, d_.x), bdy = exactDifference(b_.y, d_.y), bdz = exactDifference(b_.z, d_.z);
+	auto const cdx = exactDifference(c_.x, d_.x), cdy = exactDifference(c_.y, d_.y), cdz = exactDifference(c_.z, d_.z);
+
+	auto const bc = bdx * cdy - cdx * bdy;
+	auto const ca = cdx * ady - adx * cdy;
+	auto const ab = adx * bdy - bdx * ady;
+
+	return (adz * bc + bdz * ca + cdz * ab).estimate();
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType inCircleExact(Vector2<TValueType> const & a_, Vector2<TValueType> const & b_,
+						Vector2<TValueType> const & c_, Vector2<TValueType> const & d_)
+{
+	auto const adx = exactDifference(a_.x, d_.x), ady = exactDifference(a_.y, d_.y);
+	auto const bdx = exactDifference(b_.x, d_.x), bdy = exactDifference(b_.y, d_.y);
+	auto const cdx = exactDifference(c_.x, d_.x), cdy = exactDifference(c_.y, d_.y);
+
+	auto const aLift = adx * adx + ady * ady;
+	auto const bLift = bdx * bdx + bdy * bdy;
+	auto const cLift = cdx * cdx + cdy * cdy;
+
+	auto const bc = bdx * cdy - cdx * bdy;
+	auto const ca = cdx * ady - adx * cdy;
+	auto const ab = adx * bdy - bdx * ady;
+
+	return (aLift * bc + bLift * ca + cLift * ab).estimate();
+}
+
+} // namespace priv
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+PredicateType<TValueType> orientation(Vector2<TValueType> const & a_, Vector2<TValueType> const & b_, Vector2<TValueType> const & c_)
+{
+	using Type = PredicateType<TValueType>;
+
+	if constexpr (!std::is_same_v<Type, TValueType>)
+	{
+		return orientation(a_.template convert<Type>(), b_.template convert<Type>(), c_.template convert<Type>());
+	}
+	else
+	{
+		Type const detLeft	= (a_.x - c_.x) * (b_.y - c_.y);
+		Type const detRight	= (a_.y - c_.y) * (b_.x - c_.x);
+		Type const det		= detLeft - detRight;
+
+		Type detSum;
+		if (detLeft > 0)
+		{
+			if (detRight <= 0)
+				return det;
+			detSum = detLeft + detRight;
+		}
+		else if (detLeft < 0)
+		{
+			if (detRight >= 0)
+				return det;
+			detSum = -detLeft - detRight;
+		}
+		else
+			return det;
+
+		Type const errorBound = priv::PredicateConstants<Type>::orientation2ErrorBound * detSum;
+		if (det >= errorBound || -det >= errorBound)
+			return det;
+
+		return priv::orientation2Exact(a_, b_, c_);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+PredicateType<TValueType> orientation(Vector3<TValueType> const & a_, Vector3<TValueType> const & b_,
+										Vector3<TValueType> const & c_, Vector3<TValueType> const & d_)
+{
+	using Type = PredicateType<TValueType>;
+
+	if constexpr (!std::is_same_v<Type, TValueType>)
+	{
+		return orientation(a_.template convert<Type>(), b_.template convert<Type>(),
+							c_.template convert<Type>(), d_.template convert<Type>());
+	}
+	else
+	{
+		Vector3<Type> const ad = a_ - d_;
+		Vector3<Type> const bd = b_ - d_;
+		Vector3<Type> const cd = c_ - d_;
+
+		Type const bdxcdy = bd.x * cd.y, cdxbdy = cd.x * bd.y;
+		Type const cdxady = cd.x * ad.y, adxcdy = ad.x * cd.y;
+		Type const adxbdy = ad.x * bd.y, bdxady = bd.x * ad.y;
+
+		Type const det = ad.z * (bdxcdy - cdxbdy) + bd.z * (cdxady - adxcdy) + cd.z * (adxbdy - bdxady);
+
+		Type const permanent =	(std::abs(bdxcdy) + std::abs(cdxbdy)) * std::abs(ad.z) +
+								(std::abs(cdxady) + std::abs(adxcdy)) * std::abs(bd.z) +
+								(std::abs(adxbdy) + std::abs(bdxady)) * std::abs(cd.z);
+
+		Type const errorBound = priv::PredicateConstants<Type>::orientation3ErrorBound * permanent;
+		if (det > errorBound || -det > errorBound)
+			return det;
+
+		return priv::orientation3Exact(a_, b_, c_, d_);
+	}
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+PredicateType<TValueType> inCircle(Vector2<TValueType> const & a_, Vector2<TValueType> const & b_,
+									Vector2<TValueType> const & c_, Vector2<TValueType> const & d_)
+{
+	using Type = PredicateType<TValueType>;
+
+	if constexpr (!std::is_same_v<Type, TValueType>)
+	{
+		return inCircle(a_.template convert<Type>(), b_.template convert<Type>(),
+						c_.template convert<Type>(), d_.template convert<Type>());
+	}
+	else
+	{
+		Vector2<Type> const ad = a_ - d_;
+		Vector2<Type> const bd = b_ - d_;
+		Vector2<Type> const cd = c_ - d_;
+
+		Type const bdxcdy = bd.x * cd.y, cdxbdy = cd.x * bd.y;
+		Type const cdxady = cd.x * ad.y, adxcdy = ad.x * cd.y;
+		Type const adxbdy = ad.x * bd.y, bdxady = bd.x * ad.y;
+
+		Type const aLift = ad.x * ad.x + ad.y * ad.y;
+		Type const bLift = bd.x * bd.x + bd.y * bd.y;
+		Type const cLift = cd.x * cd.x + cd.y * cd.y;
+
+		Type const det = aLift * (bdxcdy - cdxbdy) + bLift * (cdxady - adxcdy) + cLift * (adxbdy - bdxady);
+
+		Type const permanent =	(std::abs(bdxcdy) + std::abs(cdxbdy)) * aLift +
+								(std::abs(cdxady) + std::abs(adxcdy)) * bLift +
+								(std::abs(adxbdy) + std::abs(bdxady)) * cLift;
+
+		Type const errorBound = priv::PredicateConstants<Type>::inCircleErrorBound * permanent;
+		if (det > errorBound || -det > errorBound)
+			return det;
+
+		return priv::inCircleExact(a_, b_, c_, d_);
+	}
+}
+
+} // namespace quickmaffs
\ No newline at end of file
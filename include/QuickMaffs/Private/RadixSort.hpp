@@ -0,0 +1,41 @@
+#pragma once
+
+#include "PrecompiledHeader.hpp"
+
+namespace quickmaffs::priv
+{
+
+/// <summary>
+/// Unsigned integer type of the radix key of the value type.
+/// </summary>
+template <typename TValueType>
+using RadixKeyType = std::conditional_t<sizeof(TValueType) <= sizeof(std::uint32_t), std::uint32_t, std::uint64_t>;
+
+/// <summary>
+/// Converts value to unsigned key with the same order: floating point bits with the sign handled,
+/// signed integers with the sign bit flipped.
+/// </summary>
+/// <param name="value_">The value. Floating point value must not be NaN.</param>
+/// <returns>The key.</returns>
+template <typename TValueType>
+RadixKeyType<TValueType> toRadixKey(TValueType const value_);
+
+/// <summary>
+/// Sorts the keys with stable least significant digit radix sort and permutes the values along.
+/// </summary>
+/// <param name="keys_">The keys.</param>
+/// <param name="values_">The values, one per key.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <remarks>
+/// <para>
+/// Every pass sorts by one byte: chunks of the range count their digits in parallel, then scatter
+/// to the offsets given by the prefix sums over (digit, chunk), which keeps the sort stable.
+/// Passes over a byte equal for all the keys are skipped.
+/// </para>
+/// </remarks>
+template <typename TKeyType>
+void radixSort(std::vector<TKeyType> & keys_, std::vector<std::uint32_t> & values_, std::size_t const threadCount_ = 1);
+
+} // namespace quickmaffs::priv
+
+#include "RadixSort.inl"
\ No newline at end of file
@@ -0,0 +1,97 @@
+// Note: this file is not meant to be included on its own.
+// Include "RadixSort.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs::priv
+{
+
+// Bits sorted by one pass.
+constexpr std::size_t cxRadixDigitBits = 8;
+constexpr std::size_t cxRadixDigits = std::size_t(1) << cxRadixDigitBits;
+
+////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+RadixKeyType<TValueType> toRadixKey(TValueType const value_)
+{
+	using KeyType = RadixKeyType<TValueType>;
+	constexpr KeyType signBit = KeyType(1) << (sizeof(KeyType) * 8 - 1);
+
+	if constexpr (std::is_floating_point_v<TValueType>)
+	{
+		static_assert(sizeof(TValueType) == sizeof(KeyType), "Radix keys support float and double");
+
+		// Negative values have all the bits flipped, so larger magnitudes come first.
+		KeyType bits;
+		std::memcpy(&bits, &value_, sizeof(bits));
+		return (bits & signBit) ? ~bits : (bits | signBit);
+	}
+	else if constexpr (std::is_signed_v<TValueType>)
+		return static_cast<KeyType>(static_cast< std::make_signed_t<KeyType> >(value_)) ^ signBit;
+	else
+		return static_cast<KeyType>(value_);
+}
+
+////////////////////////////////////////////////////////////////////////
+template <typename TKeyType>
+void radixSort(std::vector<TKeyType> & keys_, std::vector<std::uint32_t> & values_, std::size_t const threadCount_)
+{
+	static_assert(std::is_unsigned_v<TKeyType>, "Radix sort requires unsigned keys");
+
+	std::size_t const count = keys_.size();
+	std::size_t const chunkCount = parallelChunkCount(count, threadCount_);
+	if (count < 2)
+		return;
+
+	std::vector<TKeyType> keys(count);
+	std::vector<std::uint32_t> values(count);
+	std::vector< std::array<std::size_t, cxRadixDigits> > offsets(chunkCount);
+
+	for (std::size_t shift = 0; shift < sizeof(TKeyType) * 8; shift += cxRadixDigitBits)
+	{
+		auto digit = [shift](TKeyType const key_) { return static_cast<std::size_t>(key_ >> shift) & (cxRadixDigits - 1); };
+
+		parallelFor(count, threadCount_,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+			{
+				auto & histogram = offsets[chunk_];
+				histogram.fill(0);
+				for (std::size_t i = begin_; i < end_; ++i)
+					++histogram[digit(keys_[i])];
+			});
+
+		// Exclusive prefix sum in (digit, chunk) order:
+		std::size_t offset = 0;
+		bool trivial = false;
+		for (std::size_t d = 0; d < cxRadixDigits; ++d)
+		{
+			std::size_t digitCount = 0;
+			for (std::size_t c = 0; c < chunkCount; ++c)
+			{
+				std::size_t const chunkDigitCount = offsets[c][d];
+				offsets[c][d] = offset;
+				offset += chunkDigitCount;
+				digitCount += chunkDigitCount;
+			}
+			trivial |= digitCount == count;
+		}
+		if (trivial)
+			continue;
+
+		parallelFor(count, threadCount_,
+			[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+			{
+				auto & cursors = offsets[chunk_];
+				for (std::size_t i = begin_; i < end_; ++i)
+				{
+					std::size_t const target = cursors[digit(keys_[i])]++;
+					keys[target] = keys_[i];
+					values[target] = values_[i];
+				}
+			});
+		keys_.swap(keys);
+		values_.swap(values);
+	}
+}
+
+} // namespace quickmaffs::priv
\ No newline at end of file
@@ -94,7 +94,7 @@ inline TType generate(TType const & from_, TType const & to_)
 	static_assert(cxIsIntegerType || cxIsFloatType, "math::random does not support this type.");
 
 	// Calculate min and max value:
-	auto[minValue, maxValue] = std::minmax(static_cast<TType>(from_), static_cast<TType>(to_));
+	auto [minValue, maxValue] = std::minmax(from_, to_);
 
 
 	// For every integer type:
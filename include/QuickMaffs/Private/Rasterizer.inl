@@ -0,0 +1,233 @@
+// Note: this file is not meant to be included on its own.
+// Include "Rasterizer.hpp" instead.
+
+#include "Parallel.hpp"
+#include "PolygonEdges.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Number of sub-scanlines sampled per pixel row in anti-aliased mode.
+constexpr std::size_t cxRasterSubScanlines = 5;
+
+/// <summary>
+/// Edge of the edge table, in pixel coordinates of the tile.
+/// </summary>
+template <typename TValueType>
+struct RasterEdge
+{
+	TValueType	yTop, yBottom;
+	TValueType	xTop, slope;		// x at yTop and dx/dy.
+	int			winding;			// +1 for downward edges, -1 for upward.
+};
+
+/// <summary>
+/// Entry of the active edge table.
+/// </summary>
+template <typename TValueType>
+struct ActiveRasterEdge
+{
+	TValueType	x;
+	std::size_t	edge;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Converts coordinate to the index of the first sample that is not less than it.
+/// </summary>
+template <typename TValueType>
+std::size_t firstSampleNotBelow(TValueType const coord_, TValueType const origin_, TValueType const cellSize_, std::size_t const count_)
+{
+	TValueType const index = std::ceil((coord_ - origin_) / cellSize_ - TValueType(0.5));
+	if (!(index > TValueType(0)))
+		return 0;
+	if (index >= static_cast<TValueType>(count_))
+		return count_;
+	return static_cast<std::size_t>(index);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+void rasterizeEdges(std::vector< PolygonEdge2<TValueType> > const & edges_, RasterTile<TValueType> const & tile_,
+					RasterMode const mode_, FillRule const fillRule_)
+{
+	using VectorType = Vector2<TValueType>;
+
+	std::size_t const width		= tile_.resolution.x;
+	std::size_t const height	= tile_.resolution.y;
+	if (width == 0 || height == 0)
+		return;
+
+	VectorType const cellSize	= tile_.region.getExtent() / VectorType{ static_cast<TValueType>(width), static_cast<TValueType>(height) };
+	VectorType const origin		= tile_.region.center - tile_.region.getHalfExtent();
+
+	// Edge table, sorted by top y:
+	std::vector< RasterEdge<TValueType> > table;
+	table.reserve(edges_.size());
+	for (auto const & edge : edges_)
+	{
+		VectorType from	= (edge.from - origin) / cellSize;
+		VectorType to	= (edge.to - origin) / cellSize;
+		if (from.y == to.y)
+			continue;
+
+		int winding = 1;
+		if (from.y > to.y)
+		{
+			std::swap(from, to);
+			winding = -1;
+		}
+		if (to.y <= TValueType(0) || from.y >= static_cast<TValueType>(height))
+			continue;
+
+		table.push_back({ from.y, to.y, from.x, (to.x - from.x) / (to.y - from.y), winding });
+	}
+	std::sort(table.begin(), table.end(), [](auto const & lhs_, auto const & rhs_) { return lhs_.yTop < rhs_.yTop; });
+
+	std::size_t const subScanlines = (mode_ == RasterMode::AntiAliased) ? cxRasterSubScanlines : 1;
+	TValueType const subScanlineWeight = TValueType(1) / static_cast<TValueType>(subScanlines);
+
+	std::vector< ActiveRasterEdge<TValueType> > active;
+	std::vector<TValueType> coverage, runs;
+	if (mode_ == RasterMode::AntiAliased)
+	{
+		coverage.resize(width + 2);
+		runs.resize(width + 2);
+	}
+
+	auto isInside = [fillRule_](int const winding_) {
+			return fillRule_ == FillRule::EvenOdd ? (winding_ & 1) != 0 : winding_ != 0;
+		};
+
+	std::size_t nextEdge = 0;
+	for (std::size_t y = 0; y < height; ++y)
+	{
+		std::uint8_t * row = tile_.pixels + static_cast<std::ptrdiff_t>(y) * tile_.stride;
+		if (mode_ == RasterMode::AntiAliased)
+		{
+			std::fill(coverage.begin(), coverage.end(), TValueType(0));
+			std::fill(runs.begin(), runs.end(), TValueType(0));
+		}
+		else
+			std::fill_n(row, width, std::uint8_t(0));
+
+		for (std::size_t s = 0; s < subScanlines; ++s)
+		{
+			TValueType const scanY = static_cast<TValueType>(y) + (static_cast<TValueType>(s) + TValueType(0.5)) * subScanlineWeight;
+
+			// Retire finished edges, activate new ones (half-open in y, so shared vertices are counted once):
+			active.erase(std::remove_if(active.begin(), active.end(),
+					[&](auto const & entry_) { return table[entry_.edge].yBottom <= scanY; }),
+				active.end());
+			for (; nextEdge < table.size() && table[nextEdge].yTop <= scanY; ++nextEdge)
+			{
+				if (table[nextEdge].yBottom > scanY)
+					active.push_back({ TValueType(0), nextEdge });
+			}
+
+			// Update crossings; order barely changes between scanlines, so insertion sort is near linear.
+			for (auto & entry : active)
+			{
+				auto const & edge = table[entry.edge];
+				entry.x = edge.xTop + (scanY - edge.yTop) * edge.slope;
+			}
+			for (std::size_t i = 1; i < active.size(); ++i)
+			{
+				auto const entry = active[i];
+				std::size_t j = i;
+				for (; j > 0 && active[j - 1].x > entry.x; --j)
+					active[j] = active[j - 1];
+				active[j] = entry;
+			}
+
+			// Walk the spans:
+			int winding = 0;
+			TValueType spanBegin = 0;
+			for (auto const & entry : active)
+			{
+				bool const wasInside = isInside(winding);
+				winding += table[entry.edge].winding;
+				bool const nowInside = isInside(winding);
+
+				if (!wasInside && nowInside)
+				{
+					spanBegin = entry.x;
+					continue;
+				}
+				if (!wasInside || nowInside)
+					continue;
+
+				TValueType const spanEnd = entry.x;
+				if (mode_ == RasterMode::Binary)
+				{
+					// Pixel centers within [spanBegin, spanEnd).
+					std::size_t const first = firstSampleNotBelow(spanBegin, TValueType(0), TValueType(1), width);
+					std::size_t const last = firstSampleNotBelow(spanEnd, TValueType(0), TValueType(1), width);
+					if (first < last)
+						std::fill(row + first, row + last, std::uint8_t(255));
+				}
+				else
+				{
+					// Exact horizontal coverage: partial end pixels plus a run of full ones.
+					TValueType const begin = std::clamp(spanBegin, TValueType(0), static_cast<TValueType>(width));
+					TValueType const end = std::clamp(spanEnd, TValueType(0), static_cast<TValueType>(width));
+					if (end <= begin)
+						continue;
+
+					std::size_t const beginPixel = static_cast<std::size_t>(begin);
+					std::size_t const endPixel = static_cast<std::size_t>(end);
+					if (beginPixel == endPixel)
+						coverage[beginPixel] += end - begin;
+					else
+					{
+						coverage[beginPixel] += static_cast<TValueType>(beginPixel + 1) - begin;
+						runs[beginPixel + 1] += TValueType(1);
+						runs[endPixel] -= TValueType(1);
+						coverage[endPixel] += end - static_cast<TValueType>(endPixel);
+					}
+				}
+			}
+		}
+
+		if (mode_ == RasterMode::AntiAliased)
+		{
+			TValueType run = 0;
+			for (std::size_t x = 0; x < width; ++x)
+			{
+				run += runs[x];
+				TValueType const value = std::clamp((run + coverage[x]) * subScanlineWeight, TValueType(0), TValueType(1));
+				row[x] = static_cast<std::uint8_t>(value * TValueType(255) + TValueType(0.5));
+			}
+		}
+	}
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+void rasterizePolygons(std::vector< Polygon2<TValueType> > const & polygons_, RasterTile<TValueType> const & tile_,
+						RasterMode const mode_, FillRule const fillRule_)
+{
+	priv::rasterizeEdges(priv::collectPolygonEdges(polygons_), tile_, mode_, fillRule_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+void rasterizePolygons(std::vector< Polygon2<TValueType> > const & polygons_, std::vector< RasterTile<TValueType> > const & tiles_,
+						RasterMode const mode_, FillRule const fillRule_, std::size_t const threadCount_)
+{
+	auto const edges = priv::collectPolygonEdges(polygons_);
+
+	priv::parallelFor(tiles_.size(), threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+				priv::rasterizeEdges(edges, tiles_[i], mode_, fillRule_);
+		});
+}
+
+}
\ No newline at end of file
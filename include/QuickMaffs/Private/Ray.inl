@@ -0,0 +1,301 @@
+// Note: this file is not meant to be included on its own.
+// Include "Ray.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Bytes of one lane array of packets built by castRays (one AVX-512 register).
+constexpr std::size_t cxRayPacketBytes = 64;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns parameter t where the ray `origin + t * direction` crosses the segment `from + s * edge`, s in [0, 1],
+/// or infinity when it does not (or runs parallel to it). Branch-free, so it vectorizes when called per lane.
+/// </summary>
+template <typename TValueType>
+inline TValueType rayEdgeDistance(TValueType const originX_, TValueType const originY_, TValueType const directionX_, TValueType const directionY_,
+									TValueType const fromX_, TValueType const fromY_, TValueType const edgeX_, TValueType const edgeY_)
+{
+	using V = TValueType;
+
+	V const denominator = directionX_ * edgeY_ - directionY_ * edgeX_;
+	V const offsetX = fromX_ - originX_;
+	V const offsetY = fromY_ - originY_;
+	V const t = (offsetX * edgeY_ - offsetY * edgeX_) / denominator;
+	V const s = (offsetX * directionY_ - offsetY * directionX_) / denominator;
+	V const infinity = std::numeric_limits<V>::infinity();
+
+	// Misses are folded in with max of 0 or infinity, see castRay of ball packets. A NaN `t` (parallel edge) loses to `miss`.
+	V const miss = (denominator != V(0) ? V(0) : infinity) + (t >= V(0) ? V(0) : infinity)
+		+ (s >= V(0) ? V(0) : infinity) + (s <= V(1) ? V(0) : infinity);
+	return std::max(miss, t);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Slab test of every lane of the packet against the bounds.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Lanes parallel to an axis are resolved with selects instead of a branch: the slab then either
+/// spans the whole ray (origin between the planes) or rejects it.
+/// </para>
+/// </remarks>
+template <template<typename> typename T, typename V, std::size_t N>
+std::array<V, N> castRayPacketBounds(RayPacket<T, V, N> const & packet_, T<V> const & lower_, T<V> const & upper_)
+{
+	constexpr V infinity = std::numeric_limits<V>::infinity();
+
+	std::array<V, N> tNear;
+	std::array<V, N> tFar;
+	tNear.fill(V(0));
+	tFar.fill(infinity);
+
+	for (std::size_t d = 0; d < packet_.Dimensions; ++d)
+	{
+		V const lower = lower_[d];
+		V const upper = upper_[d];
+		V const * origins = packet_.origins[d].data();
+		V const * directions = packet_.directions[d].data();
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			V const inverse = V(1) / directions[i];
+			V const t1 = (lower - origins[i]) * inverse;
+			V const t2 = (upper - origins[i]) * inverse;
+			V const slabNear = std::min(t1, t2);
+			V const slabFar = std::max(t1, t2);
+
+			// Single-condition selects of precomputed values keep the loop free of branches.
+			V parallelNear = lower <= origins[i] ? -infinity : infinity;
+			parallelNear = origins[i] <= upper ? parallelNear : infinity;
+			bool const parallel = directions[i] == V(0);
+			tNear[i] = std::max(tNear[i], parallel ? parallelNear : slabNear);
+			tFar[i] = std::min(tFar[i], parallel ? -parallelNear : slabFar);
+		}
+	}
+
+	for (std::size_t i = 0; i < N; ++i)
+		tNear[i] = tNear[i] <= tFar[i] ? tNear[i] : infinity;
+	return tNear;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns number of lanes of packets built by castRays.
+/// </summary>
+template <typename TValueType>
+constexpr std::size_t rayPacketLanes()
+{
+	return std::max<std::size_t>(cxRayPacketBytes / sizeof(TValueType), 1);
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr Ray< TVectorType, TValueType >::Ray(VectorType const& origin_, VectorType const& direction_)
+	:
+	origin{ origin_ },
+	direction{ direction_ }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+constexpr typename Ray< TVectorType, TValueType >::VectorType Ray< TVectorType, TValueType >::getPoint(ValueType const distance_) const
+{
+	return origin + direction * distance_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType, std::size_t TSize>
+constexpr void RayPacket< TVectorType, TValueType, TSize >::set(std::size_t const lane_, RayType const & ray_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		origins[d][lane_] = ray_.origin[d];
+		directions[d][lane_] = ray_.direction[d];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType, std::size_t TSize>
+constexpr typename RayPacket< TVectorType, TValueType, TSize >::RayType RayPacket< TVectorType, TValueType, TSize >::get(std::size_t const lane_) const
+{
+	RayType ray;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		ray.origin[d] = origins[d][lane_];
+		ray.direction[d] = directions[d][lane_];
+	}
+	return ray;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+V castRay(Ray<T, V> const & ray_, Ball<T, V> const & ball_)
+{
+	V entry;
+	return priv::rayRangeEntry(ball_, ray_.origin, ray_.direction, std::numeric_limits<V>::infinity(), entry)
+		? entry : std::numeric_limits<V>::infinity();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+V castRay(Ray<T, V> const & ray_, Box<T, V> const & box_)
+{
+	V entry;
+	return priv::rayRangeEntry(box_, ray_.origin, ray_.direction, std::numeric_limits<V>::infinity(), entry)
+		? entry : std::numeric_limits<V>::infinity();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+V castRay(Ray<T, V> const & ray_, Aabb<T, V> const & aabb_)
+{
+	V entry;
+	return priv::rayRangeEntry(aabb_, ray_.origin, ray_.direction, std::numeric_limits<V>::infinity(), entry)
+		? entry : std::numeric_limits<V>::infinity();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V>
+V castRay(Ray<Vector2, V> const & ray_, Polygon2<V> const & polygon_)
+{
+	auto const & points = polygon_.getPoints();
+
+	V result = std::numeric_limits<V>::infinity();
+	if (points.size() < 2)
+		return result;
+
+	for (std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+	{
+		V const distance = priv::rayEdgeDistance(ray_.origin.x, ray_.origin.y, ray_.direction.x, ray_.direction.y,
+									points[j].x, points[j].y, points[i].x - points[j].x, points[i].y - points[j].y);
+		result = std::min(result, distance);
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<T, V, N> const & packet_, Ball<T, V> const & ball_)
+{
+	constexpr V infinity = std::numeric_limits<V>::infinity();
+
+	// Coefficients of |origin + t * direction - center|^2 = radius^2, as in priv::rayRangeEntryBall.
+	std::array<V, N> a{};
+	std::array<V, N> b{};
+	std::array<V, N> c;
+	c.fill(-ball_.getRadius() * ball_.getRadius());
+
+	for (std::size_t d = 0; d < packet_.Dimensions; ++d)
+	{
+		V const center = ball_.center[d];
+		V const * origins = packet_.origins[d].data();
+		V const * directions = packet_.directions[d].data();
+		for (std::size_t i = 0; i < N; ++i)
+		{
+			V const offset = origins[i] - center;
+			a[i] += directions[i] * directions[i];
+			b[i] += offset * directions[i];
+			c[i] += offset * offset;
+		}
+	}
+
+	std::array<V, N> result;
+	for (std::size_t i = 0; i < N; ++i)
+	{
+		V const discriminant = b[i] * b[i] - a[i] * c[i];
+		V const root = std::sqrt(std::max(discriminant, V(0)));
+		V const entry = (-b[i] - root) / a[i];
+
+		// Misses are folded in with max/min of 0 or infinity: selects of `entry` itself
+		// make GCC keep the division behind a branch. The square root vectorizes only with -fno-math-errno.
+		V const miss = (discriminant >= V(0) ? V(0) : infinity) + (b[i] < V(0) ? V(0) : infinity) + (a[i] > V(0) ? V(0) : infinity);
+		V const inside = c[i] <= V(0) ? V(0) : infinity;
+		result[i] = std::min(inside, std::max(miss, entry));
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<T, V, N> const & packet_, Box<T, V> const & box_)
+{
+	T<V> const halfExtent = box_.getHalfExtent();
+	return priv::castRayPacketBounds(packet_, box_.center - halfExtent, box_.center + halfExtent);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<T, V, N> const & packet_, Aabb<T, V> const & aabb_)
+{
+	return priv::castRayPacketBounds(packet_, aabb_.lower, aabb_.upper);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<Vector2, V, N> const & packet_, Polygon2<V> const & polygon_)
+{
+	auto const & points = polygon_.getPoints();
+
+	std::array<V, N> result;
+	result.fill(std::numeric_limits<V>::infinity());
+	if (points.size() < 2)
+		return result;
+
+	V const * originsX = packet_.origins[0].data();
+	V const * originsY = packet_.origins[1].data();
+	V const * directionsX = packet_.directions[0].data();
+	V const * directionsY = packet_.directions[1].data();
+	for (std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+	{
+		V const fromX = points[j].x;
+		V const fromY = points[j].y;
+		V const edgeX = points[i].x - fromX;
+		V const edgeY = points[i].y - fromY;
+		for (std::size_t lane = 0; lane < N; ++lane)
+		{
+			V const distance = priv::rayEdgeDistance(originsX[lane], originsY[lane], directionsX[lane], directionsY[lane],
+										fromX, fromY, edgeX, edgeY);
+			result[lane] = std::min(result[lane], distance);
+		}
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V, typename TShapeType>
+std::vector<V> castRays(std::vector< Ray<T, V> > const & rays_, TShapeType const & shape_, std::size_t const threadCount_)
+{
+	constexpr std::size_t lanes = priv::rayPacketLanes<V>();
+	using PacketType = RayPacket<T, V, lanes>;
+
+	std::vector<V> distances(rays_.size());
+	std::size_t const packetCount = (rays_.size() + lanes - 1) / lanes;
+
+	priv::parallelFor(packetCount, threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t) {
+			PacketType packet;
+			for (std::size_t p = begin_; p < end_; ++p)
+			{
+				std::size_t const first = p * lanes;
+				std::size_t const count = std::min(lanes, rays_.size() - first);
+
+				// The last packet repeats its last ray in the unused lanes.
+				for (std::size_t lane = 0; lane < lanes; ++lane)
+					packet.set(lane, rays_[first + std::min(lane, count - 1)]);
+
+				std::array<V, lanes> const hits = castRay(packet, shape_);
+				std::copy_n(hits.begin(), count, distances.begin() + first);
+			}
+		});
+	return distances;
+}
+
+}
\ No newline at end of file
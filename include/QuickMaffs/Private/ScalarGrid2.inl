@@ -0,0 +1,87 @@
+// Note: this file is not meant to be included on its own.
+// Include "ScalarGrid2.hpp" instead.
+
+namespace quickmaffs
+{
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+ScalarGrid2<TValueType>::ScalarGrid2(RegionType const & region_, Vector2size const & resolution_, ValueType const fill_)
+	:
+	m_region{ region_ },
+	m_resolution{ resolution_ },
+	m_values(resolution_.x * resolution_.y, fill_)
+{
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+Vector2size const & ScalarGrid2<TValueType>::getResolution() const
+{
+	return m_resolution;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+typename ScalarGrid2<TValueType>::RegionType const & ScalarGrid2<TValueType>::getRegion() const
+{
+	return m_region;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+typename ScalarGrid2<TValueType>::VectorType ScalarGrid2<TValueType>::getCellSize() const
+{
+	return m_region.getExtent() / VectorType{
+			static_cast<ValueType>(std::max(std::size_t(1), m_resolution.x)),
+			static_cast<ValueType>(std::max(std::size_t(1), m_resolution.y))
+		};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+typename ScalarGrid2<TValueType>::VectorType ScalarGrid2<TValueType>::getSamplePosition(std::size_t const x_, std::size_t const y_) const
+{
+	VectorType const cellSize = this->getCellSize();
+	return m_region.center - m_region.getHalfExtent() + VectorType{
+			(static_cast<ValueType>(x_) + ValueType(0.5)) * cellSize.x,
+			(static_cast<ValueType>(y_) + ValueType(0.5)) * cellSize.y
+		};
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType & ScalarGrid2<TValueType>::at(std::size_t const x_, std::size_t const y_)
+{
+	return m_values[y_ * m_resolution.x + x_];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType ScalarGrid2<TValueType>::at(std::size_t const x_, std::size_t const y_) const
+{
+	return m_values[y_ * m_resolution.x + x_];
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType * ScalarGrid2<TValueType>::row(std::size_t const y_)
+{
+	return m_values.data() + y_ * m_resolution.x;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TValueType const * ScalarGrid2<TValueType>::row(std::size_t const y_) const
+{
+	return m_values.data() + y_ * m_resolution.x;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+typename ScalarGrid2<TValueType>::ContainerType const & ScalarGrid2<TValueType>::getValues() const
+{
+	return m_values;
+}
+
+}
\ No newline at end of file
@@ -4,6 +4,399 @@
 namespace quickmaffs
 {
 
+namespace priv
+{
+
+// Number of shapes processed per block by batched ray tests.
+constexpr std::size_t cxShapeBatchBlock = 256;
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns |lhs_ - rhs_|, also for unsigned types.
+/// </summary>
+template <typename TValueType>
+constexpr TValueType absoluteDifference(TValueType const lhs_, TValueType const rhs_)
+{
+	return lhs_ > rhs_ ? lhs_ - rhs_ : rhs_ - lhs_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Returns how much `distance_` exceeds `halfExtent_`, or zero.
+/// </summary>
+template <typename TValueType>
+constexpr TValueType distanceOutside(TValueType const distance_, TValueType const halfExtent_)
+{
+	return distance_ > halfExtent_ ? distance_ - halfExtent_ : TValueType(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Tests whether `coordinate_` lies strictly between the faces of a box along one axis.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Floating point boxes compare against min/max corners. Integer boxes compare the distance from the center
+/// instead, so unsigned corners cannot wrap around.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+constexpr bool isInsideBoxAxis(TValueType const coordinate_, TValueType const center_, TValueType const halfExtent_)
+{
+	if constexpr (std::is_floating_point_v<TValueType>)
+		return (center_ - halfExtent_ < coordinate_) & (coordinate_ < center_ + halfExtent_);
+	else
+		return absoluteDifference(coordinate_, center_) < halfExtent_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Tests the ray `origin_ + t * direction_`, t in [0, tMax_], against the ball.
+/// </summary>
+template <typename TVectorType, typename TValueType>
+bool rayRangeHitsBall(TVectorType const & center_, TValueType const radius_,
+						TVectorType const & origin_, TVectorType const & direction_, TValueType const tMax_)
+{
+	static_assert(std::is_floating_point_v<TValueType>, "Ray tests require floating point type");
+
+	TValueType const lengthSquared = direction_.lengthSquared();
+	TValueType t = lengthSquared > TValueType(0) ? (center_ - origin_).dot(direction_) / lengthSquared : TValueType(0);
+	t = std::min(std::max(t, TValueType(0)), tMax_);
+	return (origin_ + direction_ * t).distanceSquared(center_) <= radius_ * radius_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Finds where the ray `origin_ + t * direction_`, t in [0, tMax_], enters the ball.
+/// `entry_` receives the parameter t of the entry point (0 when the origin is inside).
+/// </summary>
+template <typename TVectorType, typename TValueType>
+bool rayRangeEntryBall(TVectorType const & center_, TValueType const radius_,
+						TVectorType const & origin_, TVectorType const & direction_, TValueType const tMax_, TValueType & entry_)
+{
+	static_assert(std::is_floating_point_v<TValueType>, "Ray tests require floating point type");
+
+	TVectorType const offset = origin_ - center_;
+	TValueType const c = offset.lengthSquared() - radius_ * radius_;
+	if (c <= TValueType(0))
+	{
+		entry_ = TValueType(0);
+		return true;
+	}
+
+	TValueType const a = direction_.lengthSquared();
+	TValueType const b = offset.dot(direction_);
+	TValueType const discriminant = b * b - a * c;
+	if (a == TValueType(0) || b >= TValueType(0) || discriminant < TValueType(0))
+		return false;
+
+	entry_ = (-b - std::sqrt(discriminant)) / a;
+	return entry_ <= tMax_;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Finds where the ray `origin_ + t * direction_`, t in [0, tMax_], enters the bounds (slab test).
+/// `entry_` receives the parameter t of the entry point (0 when the origin is inside).
+/// </summary>
+template <typename TVectorType, typename TValueType>
+bool rayRangeEntryBounds(TVectorType const & lower_, TVectorType const & upper_,
+						TVectorType const & origin_, TVectorType const & direction_, TValueType const tMax_, TValueType & entry_)
+{
+	static_assert(std::is_floating_point_v<TValueType>, "Ray tests require floating point type");
+
+	TValueType tNear = TValueType(0);
+	TValueType tFar = tMax_;
+	for (std::size_t d = 0; d < lower_.size(); ++d)
+	{
+		if (direction_[d] == TValueType(0))
+		{
+			if (origin_[d] < lower_[d] || origin_[d] > upper_[d])
+				return false;
+			continue;
+		}
+
+		TValueType const inverse = TValueType(1) / direction_[d];
+		TValueType const t1 = (lower_[d] - origin_[d]) * inverse;
+		TValueType const t2 = (upper_[d] - origin_[d]) * inverse;
+		tNear = std::max(tNear, std::min(t1, t2));
+		tFar = std::min(tFar, std::max(t1, t2));
+	}
+	entry_ = tNear;
+	return tNear <= tFar;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Tests the ray `origin_ + t * direction_`, t in [0, tMax_], against the bounds (slab test).
+/// </summary>
+template <typename TVectorType, typename TValueType>
+bool rayRangeHitsBounds(TVectorType const & lower_, TVectorType const & upper_,
+						TVectorType const & origin_, TVectorType const & direction_, TValueType const tMax_)
+{
+	TValueType entry;
+	return rayRangeEntryBounds(lower_, upper_, origin_, direction_, tMax_, entry);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Finds where the ray range enters the shape, see <see cref="rayRangeEntryBall"/>.
+/// </summary>
+template <template<typename> typename T, typename V>
+bool rayRangeEntry(Ball<T, V> const & ball_, T<V> const & origin_, T<V> const & direction_, V const tMax_, V & entry_)
+{
+	return rayRangeEntryBall(ball_.center, ball_.getRadius(), origin_, direction_, tMax_, entry_);
+}
+
+template <template<typename> typename T, typename V>
+bool rayRangeEntry(Box<T, V> const & box_, T<V> const & origin_, T<V> const & direction_, V const tMax_, V & entry_)
+{
+	return rayRangeEntryBounds(box_.center - box_.getHalfExtent(), box_.center + box_.getHalfExtent(), origin_, direction_, tMax_, entry_);
+}
+
+template <template<typename> typename T, typename V>
+bool rayRangeEntry(Aabb<T, V> const & aabb_, T<V> const & origin_, T<V> const & direction_, V const tMax_, V & entry_)
+{
+	return rayRangeEntryBounds(aabb_.lower, aabb_.upper, origin_, direction_, tMax_, entry_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Tests the ray `origin_ + t * direction_`, t in [0, tMax_], against every ball of the array.
+/// </summary>
+template <template<typename> typename T, typename V>
+void intersectsRayRange(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & origin_,
+						typename BallArray<T, V>::VectorType const & direction_, V const tMax_, std::uint8_t * mask_)
+{
+	static_assert(std::is_floating_point_v<V>, "Ray tests require floating point type");
+	constexpr std::size_t Dimensions = BallArray<T, V>::Dimensions;
+
+	V const lengthSquared = direction_.lengthSquared();
+	V const inverseLength = lengthSquared > V(0) ? V(1) / lengthSquared : V(0);
+
+	V const * centers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		centers[d] = balls_.centers[d].data();
+	V const * radii = balls_.radii.data();
+
+	std::size_t const count = balls_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		// Closest point of the ray to the center:
+		V t = V(0);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			t += (centers[d][i] - origin_[d]) * direction_[d];
+		t = std::min(std::max(t * inverseLength, V(0)), tMax_);
+
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			V const offset = origin_[d] + direction_[d] * t - centers[d][i];
+			distanceSquared += offset * offset;
+		}
+		mask_[i] = static_cast<std::uint8_t>(distanceSquared <= radii[i] * radii[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Tests the ray `origin_ + t * direction_`, t in [0, tMax_], against every box of the component arrays.
+/// Boxes are given either as center and half extent (`TCenterExtent`) or as minimum and maximum corner.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Slab test, one dimension at a time over a block of boxes. Axes the ray is parallel to are handled
+/// by a separate loop, so no division by zero is needed.
+/// </para>
+/// </remarks>
+template <bool TCenterExtent, typename TVectorType, typename TValueType, std::size_t TDimensions>
+void rayRangeSlabs(std::array< std::vector<TValueType>, TDimensions > const & first_, std::array< std::vector<TValueType>, TDimensions > const & second_,
+					TVectorType const & origin_, TVectorType const & direction_, TValueType const tMax_, std::uint8_t * mask_)
+{
+	using V = TValueType;
+	static_assert(std::is_floating_point_v<V>, "Ray tests require floating point type");
+
+	V tNear[cxShapeBatchBlock];
+	V tFar[cxShapeBatchBlock];
+
+	std::size_t const count = first_[0].size();
+	for (std::size_t blockBegin = 0; blockBegin < count; blockBegin += cxShapeBatchBlock)
+	{
+		std::size_t const blockSize = std::min(cxShapeBatchBlock, count - blockBegin);
+		std::fill_n(tNear, blockSize, V(0));
+		std::fill_n(tFar, blockSize, tMax_);
+
+		for (std::size_t d = 0; d < TDimensions; ++d)
+		{
+			V const * first = first_[d].data() + blockBegin;
+			V const * second = second_[d].data() + blockBegin;
+			V const origin = origin_[d];
+
+			auto bounds = [&](std::size_t const i_) {
+					if constexpr (TCenterExtent)
+						return std::pair<V, V>{ first[i_] - second[i_], first[i_] + second[i_] };
+					else
+						return std::pair<V, V>{ first[i_], second[i_] };
+				};
+
+			if (direction_[d] != V(0))
+			{
+				V const inverse = V(1) / direction_[d];
+				for (std::size_t i = 0; i < blockSize; ++i)
+				{
+					auto const [lower, upper] = bounds(i);
+					V const t1 = (lower - origin) * inverse;
+					V const t2 = (upper - origin) * inverse;
+					tNear[i] = std::max(tNear[i], std::min(t1, t2));
+					tFar[i] = std::min(tFar[i], std::max(t1, t2));
+				}
+			}
+			else
+			{
+				for (std::size_t i = 0; i < blockSize; ++i)
+				{
+					auto const [lower, upper] = bounds(i);
+					tFar[i] = (lower <= origin) & (origin <= upper) ? tFar[i] : V(-1);
+				}
+			}
+		}
+
+		for (std::size_t i = 0; i < blockSize; ++i)
+			mask_[blockBegin + i] = static_cast<std::uint8_t>(tNear[i] <= tFar[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+void intersectsRayRange(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & origin_,
+						typename BoxArray<T, V>::VectorType const & direction_, V const tMax_, std::uint8_t * mask_)
+{
+	rayRangeSlabs<true>(boxes_.centers, boxes_.halfExtents, origin_, direction_, tMax_, mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template<typename> typename T, typename V>
+void intersectsRayRange(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & origin_,
+						typename AabbArray<T, V>::VectorType const & direction_, V const tMax_, std::uint8_t * mask_)
+{
+	rayRangeSlabs<false>(aabbs_.lowers, aabbs_.uppers, origin_, direction_, tMax_, mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Point containment test of a ball with precomputed squared radius.
+/// </summary>
+template <template<typename> typename T, typename V>
+struct BallContainment
+{
+	constexpr explicit BallContainment(Ball<T, V> const & ball_)
+		: center{ ball_.center }, radiusSquared{ ball_.getRadius() * ball_.getRadius() }
+	{
+	}
+
+	constexpr bool operator()(T<V> const & point_) const
+	{
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < point_.size(); ++d)
+		{
+			V const offset = absoluteDifference(point_[d], center[d]);
+			distanceSquared += offset * offset;
+		}
+		return distanceSquared <= radiusSquared;
+	}
+
+	T<V>	center;
+	V		radiusSquared;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Point containment test of a box. Box interior is open.
+/// </summary>
+template <template<typename> typename T, typename V>
+struct BoxContainment
+{
+	constexpr explicit BoxContainment(Box<T, V> const & box_)
+		: center{ box_.center }, halfExtent{ box_.getHalfExtent() }
+	{
+	}
+
+	constexpr bool operator()(T<V> const & point_) const
+	{
+		bool inside = true;
+		for (std::size_t d = 0; d < point_.size(); ++d)
+			inside &= isInsideBoxAxis(point_[d], center[d], halfExtent[d]);
+		return inside;
+	}
+
+	T<V>	center, halfExtent;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Point containment test of bounds, comparisons only. Interior is open, like the box one.
+/// </summary>
+template <template<typename> typename T, typename V>
+struct AabbContainment
+{
+	constexpr explicit AabbContainment(Aabb<T, V> const & aabb_)
+		: lower{ aabb_.lower }, upper{ aabb_.upper }
+	{
+	}
+
+	constexpr bool operator()(T<V> const & point_) const
+	{
+		bool inside = true;
+		for (std::size_t d = 0; d < point_.size(); ++d)
+			inside &= (lower[d] < point_[d]) & (point_[d] < upper[d]);
+		return inside;
+	}
+
+	T<V>	lower, upper;
+};
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TVectorType, typename TContainment>
+void containmentMask(TContainment const & containment_, TVectorType const * points_, std::size_t const count_, std::uint8_t * mask_)
+{
+	for (std::size_t i = 0; i < count_; ++i)
+		mask_[i] = static_cast<std::uint8_t>(containment_(points_[i]));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TVectorType, typename TContainment>
+void containmentBits(TContainment const & containment_, TVectorType const * points_, std::size_t const count_, std::uint64_t * bits_)
+{
+	// Byte mask of 64 points first (vectorized), then packed into a word.
+	std::uint8_t mask[64];
+	for (std::size_t begin = 0; begin < count_; begin += 64)
+	{
+		std::size_t const size = std::min<std::size_t>(64, count_ - begin);
+		containmentMask(containment_, points_ + begin, size, mask);
+
+		std::uint64_t word = 0;
+		for (std::size_t j = 0; j < size; ++j)
+			word |= static_cast<std::uint64_t>(mask[j]) << j;
+		bits_[begin / 64] = word;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TVectorType, typename TContainment>
+std::size_t containmentIndices(TContainment const & containment_, TVectorType const * points_, std::size_t const count_, std::size_t * indices_)
+{
+	// Every index is written, but only advances the output when the point is inside - no branches.
+	std::size_t found = 0;
+	for (std::size_t i = 0; i < count_; ++i)
+	{
+		indices_[found] = i;
+		found += static_cast<std::size_t>(containment_(points_[i]));
+	}
+	return found;
+}
+
+} // namespace priv
+
 ///////////////////////////////////////////////////////////////////////////////////////////////////////////////
 template <typename TValueType>
 bool isPointInside(Polygon2<TValueType> const & polygon_, Vector2< typename type_traits::identity<TValueType>::type > const & point_)
@@ -19,11 +412,24 @@ bool isPointInside(Polygon2<TValueType> const & polygon_, Vector2< typename type
 	bool check = false;
 	for (SizeType i = 0, j = vertices.size() - 1; i < vertices.size(); j = i++)
 	{
-		if (((vertices[i].y > point_.y) != (vertices[j].y > point_.y)) &&
-			(point_.x < (vertices[j].x - vertices[i].x) * (point_.y - vertices[i].y) / (vertices[j].y - vertices[i].y) +
-				vertices[i].x))
+		if ((vertices[i].y > point_.y) == (vertices[j].y > point_.y))
+			continue;
+
+		if constexpr (std::is_floating_point_v<TValueType>)
 		{
-			check = !check;
+			// Point is left of an upward edge (or right of a downward one) - decided by the exact predicate,
+			// so near-degenerate inputs give consistent results.
+			auto const side = orientation(vertices[i], vertices[j], point_);
+			if (vertices[j].y > vertices[i].y ? side > 0 : side < 0)
+				check = !check;
+		}
+		else
+		{
+			if (point_.x < (vertices[j].x - vertices[i].x) * (point_.y - vertices[i].y) / (vertices[j].y - vertices[i].y) +
+					vertices[i].x)
+			{
+				check = !check;
+			}
 		}
 	}
 	return check;
@@ -40,14 +446,571 @@ constexpr bool isPointInside(Ball<T, V> const & ball_, typename Ball<T, V>::Vect
 template<template <typename> typename T, typename V>
 constexpr bool isPointInside(Box<T, V> const & box_, typename Box<T, V>::VectorType const & point_)
 {
-	auto diff = (box_.center - point_).absolute();
+	return priv::BoxContainment<T, V>{ box_ }(point_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Ball<T, V> const & lhs_, Ball<T, V> const & rhs_)
+{
+	V const radii = lhs_.getRadius() + rhs_.getRadius();
+	return lhs_.center.distanceSquared(rhs_.center) <= radii * radii;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Box<T, V> const & lhs_, Box<T, V> const & rhs_)
+{
+	auto const lhsHalfExtent = lhs_.getHalfExtent();
+	auto const rhsHalfExtent = rhs_.getHalfExtent();
+
+	bool result = true;
+	for (std::size_t d = 0; d < lhs_.center.size(); ++d)
+		result &= priv::absoluteDifference(lhs_.center[d], rhs_.center[d]) <= lhsHalfExtent[d] + rhsHalfExtent[d];
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Ball<T, V> const & ball_, Box<T, V> const & box_)
+{
+	auto const halfExtent = box_.getHalfExtent();
+
+	// Squared distance from the ball center to the closest point of the box:
+	V distanceSquared = V(0);
+	for (std::size_t d = 0; d < box_.center.size(); ++d)
+	{
+		V const outside = priv::distanceOutside(priv::absoluteDifference(ball_.center[d], box_.center[d]), halfExtent[d]);
+		distanceSquared += outside * outside;
+	}
+	return distanceSquared <= ball_.getRadius() * ball_.getRadius();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Box<T, V> const & box_, Ball<T, V> const & ball_)
+{
+	return intersects(ball_, box_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+bool intersectsSegment(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const & from_, typename Ball<T, V>::VectorType const & to_)
+{
+	return priv::rayRangeHitsBall(ball_.center, ball_.getRadius(), from_, to_ - from_, V(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+bool intersectsSegment(Box<T, V> const & box_, typename Box<T, V>::VectorType const & from_, typename Box<T, V>::VectorType const & to_)
+{
+	return priv::rayRangeHitsBounds(box_.center - box_.getHalfExtent(), box_.center + box_.getHalfExtent(), from_, to_ - from_, V(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+bool intersectsRay(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const & origin_, typename Ball<T, V>::VectorType const & direction_)
+{
+	return priv::rayRangeHitsBall(ball_.center, ball_.getRadius(), origin_, direction_, std::numeric_limits<V>::infinity());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+bool intersectsRay(Box<T, V> const & box_, typename Box<T, V>::VectorType const & origin_, typename Box<T, V>::VectorType const & direction_)
+{
+	return priv::rayRangeHitsBounds(box_.center - box_.getHalfExtent(), box_.center + box_.getHalfExtent(), origin_, direction_,
+		std::numeric_limits<V>::infinity());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersects(Ball<T, V> const & ball_, BallArray<T, V> const & balls_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = BallArray<T, V>::Dimensions;
+
+	V const * centers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		centers[d] = balls_.centers[d].data();
+	V const * radii = balls_.radii.data();
+	V const radius = ball_.getRadius();
+
+	std::size_t const count = balls_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			V const offset = priv::absoluteDifference(centers[d][i], ball_.center[d]);
+			distanceSquared += offset * offset;
+		}
+		V const sum = radii[i] + radius;
+		mask_[i] = static_cast<std::uint8_t>(distanceSquared <= sum * sum);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersects(Ball<T, V> const & ball_, BoxArray<T, V> const & boxes_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = BoxArray<T, V>::Dimensions;
+
+	V const * centers[Dimensions];
+	V const * halfExtents[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d] = boxes_.centers[d].data();
+		halfExtents[d] = boxes_.halfExtents[d].data();
+	}
+	V const radiusSquared = ball_.getRadius() * ball_.getRadius();
+
+	std::size_t const count = boxes_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			V const outside = priv::distanceOutside(priv::absoluteDifference(centers[d][i], ball_.center[d]), halfExtents[d][i]);
+			distanceSquared += outside * outside;
+		}
+		mask_[i] = static_cast<std::uint8_t>(distanceSquared <= radiusSquared);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersects(Box<T, V> const & box_, BoxArray<T, V> const & boxes_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = BoxArray<T, V>::Dimensions;
+
+	V const * centers[Dimensions];
+	V const * halfExtents[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d] = boxes_.centers[d].data();
+		halfExtents[d] = boxes_.halfExtents[d].data();
+	}
+	auto const halfExtent = box_.getHalfExtent();
+
+	std::size_t const count = boxes_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		bool overlaps = true;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			overlaps &= priv::absoluteDifference(centers[d][i], box_.center[d]) <= halfExtents[d][i] + halfExtent[d];
+		mask_[i] = static_cast<std::uint8_t>(overlaps);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersects(Box<T, V> const & box_, BallArray<T, V> const & balls_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = BallArray<T, V>::Dimensions;
+
+	V const * centers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		centers[d] = balls_.centers[d].data();
+	V const * radii = balls_.radii.data();
+	auto const halfExtent = box_.getHalfExtent();
+
+	std::size_t const count = balls_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			V const outside = priv::distanceOutside(priv::absoluteDifference(centers[d][i], box_.center[d]), halfExtent[d]);
+			distanceSquared += outside * outside;
+		}
+		mask_[i] = static_cast<std::uint8_t>(distanceSquared <= radii[i] * radii[i]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersectsSegment(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & from_,
+						typename BallArray<T, V>::VectorType const & to_, std::uint8_t * mask_)
+{
+	priv::intersectsRayRange(balls_, from_, to_ - from_, V(1), mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersectsSegment(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & from_,
+						typename BoxArray<T, V>::VectorType const & to_, std::uint8_t * mask_)
+{
+	priv::intersectsRayRange(boxes_, from_, to_ - from_, V(1), mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersectsRay(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & origin_,
+					typename BallArray<T, V>::VectorType const & direction_, std::uint8_t * mask_)
+{
+	priv::intersectsRayRange(balls_, origin_, direction_, std::numeric_limits<V>::infinity(), mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersectsRay(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & origin_,
+					typename BoxArray<T, V>::VectorType const & direction_, std::uint8_t * mask_)
+{
+	priv::intersectsRayRange(boxes_, origin_, direction_, std::numeric_limits<V>::infinity(), mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInside(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const * points_, std::size_t const count_, std::uint8_t * mask_)
+{
+	priv::containmentMask(priv::BallContainment<T, V>{ ball_ }, points_, count_, mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInside(Box<T, V> const & box_, typename Box<T, V>::VectorType const * points_, std::size_t const count_, std::uint8_t * mask_)
+{
+	priv::containmentMask(priv::BoxContainment<T, V>{ box_ }, points_, count_, mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInsideBits(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const * points_, std::size_t const count_, std::uint64_t * bits_)
+{
+	priv::containmentBits(priv::BallContainment<T, V>{ ball_ }, points_, count_, bits_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInsideBits(Box<T, V> const & box_, typename Box<T, V>::VectorType const * points_, std::size_t const count_, std::uint64_t * bits_)
+{
+	priv::containmentBits(priv::BoxContainment<T, V>{ box_ }, points_, count_, bits_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+std::size_t findPointsInside(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const * points_, std::size_t const count_, std::size_t * indices_)
+{
+	return priv::containmentIndices(priv::BallContainment<T, V>{ ball_ }, points_, count_, indices_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+std::size_t findPointsInside(Box<T, V> const & box_, typename Box<T, V>::VectorType const * points_, std::size_t const count_, std::size_t * indices_)
+{
+	return priv::containmentIndices(priv::BoxContainment<T, V>{ box_ }, points_, count_, indices_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInside(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & point_, std::uint8_t * mask_)
+{
+	// Same as intersecting a zero radius ball.
+	intersects(Ball<T, V>{ point_, V(0) }, balls_, mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInside(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & point_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = BoxArray<T, V>::Dimensions;
+
+	V const * centers[Dimensions];
+	V const * halfExtents[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d] = boxes_.centers[d].data();
+		halfExtents[d] = boxes_.halfExtents[d].data();
+	}
+
+	std::size_t const count = boxes_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		bool inside = true;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			inside &= priv::isInsideBoxAxis(point_[d], centers[d][i], halfExtents[d][i]);
+		mask_[i] = static_cast<std::uint8_t>(inside);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+std::size_t findShapesContaining(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & point_, std::size_t * indices_)
+{
+	constexpr std::size_t Dimensions = BallArray<T, V>::Dimensions;
+
+	V const * centers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		centers[d] = balls_.centers[d].data();
+	V const * radii = balls_.radii.data();
+
+	std::size_t found = 0;
+	std::size_t const count = balls_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			V const offset = priv::absoluteDifference(point_[d], centers[d][i]);
+			distanceSquared += offset * offset;
+		}
+		indices_[found] = i;
+		found += static_cast<std::size_t>(distanceSquared <= radii[i] * radii[i]);
+	}
+	return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+std::size_t findShapesContaining(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & point_, std::size_t * indices_)
+{
+	constexpr std::size_t Dimensions = BoxArray<T, V>::Dimensions;
+
+	V const * centers[Dimensions];
+	V const * halfExtents[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d] = boxes_.centers[d].data();
+		halfExtents[d] = boxes_.halfExtents[d].data();
+	}
+
+	std::size_t found = 0;
+	std::size_t const count = boxes_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		bool inside = true;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			inside &= priv::isInsideBoxAxis(point_[d], centers[d][i], halfExtents[d][i]);
+		indices_[found] = i;
+		found += static_cast<std::size_t>(inside);
+	}
+	return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool isPointInside(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const & point_)
+{
+	return priv::AabbContainment<T, V>{ aabb_ }(point_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Aabb<T, V> const & lhs_, Aabb<T, V> const & rhs_)
+{
+	bool result = true;
+	for (std::size_t d = 0; d < lhs_.lower.size(); ++d)
+		result &= (lhs_.lower[d] <= rhs_.upper[d]) & (rhs_.lower[d] <= lhs_.upper[d]);
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Ball<T, V> const & ball_, Aabb<T, V> const & aabb_)
+{
+	// Squared distance from the ball center to the closest point of the bounds:
+	V distanceSquared = V(0);
+	for (std::size_t d = 0; d < aabb_.lower.size(); ++d)
+	{
+		V const outside = priv::distanceOutside(aabb_.lower[d], ball_.center[d]) + priv::distanceOutside(ball_.center[d], aabb_.upper[d]);
+		distanceSquared += outside * outside;
+	}
+	return distanceSquared <= ball_.getRadius() * ball_.getRadius();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Aabb<T, V> const & aabb_, Ball<T, V> const & ball_)
+{
+	return intersects(ball_, aabb_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+bool intersectsSegment(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const & from_, typename Aabb<T, V>::VectorType const & to_)
+{
+	return priv::rayRangeHitsBounds(aabb_.lower, aabb_.upper, from_, to_ - from_, V(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+bool intersectsRay(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const & origin_, typename Aabb<T, V>::VectorType const & direction_)
+{
+	return priv::rayRangeHitsBounds(aabb_.lower, aabb_.upper, origin_, direction_, std::numeric_limits<V>::infinity());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersects(Aabb<T, V> const & aabb_, AabbArray<T, V> const & aabbs_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = AabbArray<T, V>::Dimensions;
+
+	V const * lowers[Dimensions];
+	V const * uppers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d] = aabbs_.lowers[d].data();
+		uppers[d] = aabbs_.uppers[d].data();
+	}
+
+	std::size_t const count = aabbs_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		bool overlaps = true;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			overlaps &= (lowers[d][i] <= aabb_.upper[d]) & (aabb_.lower[d] <= uppers[d][i]);
+		mask_[i] = static_cast<std::uint8_t>(overlaps);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersects(Ball<T, V> const & ball_, AabbArray<T, V> const & aabbs_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = AabbArray<T, V>::Dimensions;
+
+	V const * lowers[Dimensions];
+	V const * uppers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d] = aabbs_.lowers[d].data();
+		uppers[d] = aabbs_.uppers[d].data();
+	}
+	V const radiusSquared = ball_.getRadius() * ball_.getRadius();
 
-	for (std::size_t i = 0; i < diff.size(); i++) {
-		if (diff[i] >= box_.getHalfExtent()[i])
-			return false;
+	std::size_t const count = aabbs_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		V distanceSquared = V(0);
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			V const outside = priv::distanceOutside(lowers[d][i], ball_.center[d]) + priv::distanceOutside(ball_.center[d], uppers[d][i]);
+			distanceSquared += outside * outside;
+		}
+		mask_[i] = static_cast<std::uint8_t>(distanceSquared <= radiusSquared);
 	}
-	return true;
 }
 
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersectsSegment(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & from_,
+						typename AabbArray<T, V>::VectorType const & to_, std::uint8_t * mask_)
+{
+	priv::intersectsRayRange(aabbs_, from_, to_ - from_, V(1), mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void intersectsRay(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & origin_,
+					typename AabbArray<T, V>::VectorType const & direction_, std::uint8_t * mask_)
+{
+	priv::intersectsRayRange(aabbs_, origin_, direction_, std::numeric_limits<V>::infinity(), mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInside(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const * points_, std::size_t const count_, std::uint8_t * mask_)
+{
+	priv::containmentMask(priv::AabbContainment<T, V>{ aabb_ }, points_, count_, mask_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInsideBits(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const * points_, std::size_t const count_, std::uint64_t * bits_)
+{
+	priv::containmentBits(priv::AabbContainment<T, V>{ aabb_ }, points_, count_, bits_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+std::size_t findPointsInside(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const * points_, std::size_t const count_, std::size_t * indices_)
+{
+	return priv::containmentIndices(priv::AabbContainment<T, V>{ aabb_ }, points_, count_, indices_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+void isPointInside(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & point_, std::uint8_t * mask_)
+{
+	constexpr std::size_t Dimensions = AabbArray<T, V>::Dimensions;
+
+	V const * lowers[Dimensions];
+	V const * uppers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d] = aabbs_.lowers[d].data();
+		uppers[d] = aabbs_.uppers[d].data();
+	}
+
+	std::size_t const count = aabbs_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		bool inside = true;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			inside &= (lowers[d][i] < point_[d]) & (point_[d] < uppers[d][i]);
+		mask_[i] = static_cast<std::uint8_t>(inside);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+std::size_t findShapesContaining(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & point_, std::size_t * indices_)
+{
+	constexpr std::size_t Dimensions = AabbArray<T, V>::Dimensions;
+
+	V const * lowers[Dimensions];
+	V const * uppers[Dimensions];
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d] = aabbs_.lowers[d].data();
+		uppers[d] = aabbs_.uppers[d].data();
+	}
+
+	std::size_t found = 0;
+	std::size_t const count = aabbs_.size();
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		bool inside = true;
+		for (std::size_t d = 0; d < Dimensions; ++d)
+			inside &= (lowers[d][i] < point_[d]) & (point_[d] < uppers[d][i]);
+		indices_[found] = i;
+		found += static_cast<std::size_t>(inside);
+	}
+	return found;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Box<T, V> const & box_, Aabb<T, V> const & aabb_)
+{
+	return intersects(Aabb<T, V>{ box_ }, aabb_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr bool intersects(Aabb<T, V> const & aabb_, Box<T, V> const & box_)
+{
+	return intersects(aabb_, Aabb<T, V>{ box_ });
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr Aabb<T, V> computeBounds(Ball<T, V> const & ball_)
+{
+	return Aabb<T, V>{ ball_.center - ball_.getRadius(), ball_.center + ball_.getRadius() };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr Aabb<T, V> computeBounds(Box<T, V> const & box_)
+{
+	return Aabb<T, V>{ box_ };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template<template <typename> typename T, typename V>
+constexpr Aabb<T, V> computeBounds(Aabb<T, V> const & aabb_)
+{
+	return aabb_;
+}
 
 }
\ No newline at end of file
@@ -0,0 +1,251 @@
+// Note: this file is not meant to be included on its own.
+// Include "ShapeArrays.hpp" instead.
+
+namespace quickmaffs
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::size_t BallArray< TVectorType, TValueType >::size() const
+{
+	return radii.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BallArray< TVectorType, TValueType >::reserve(std::size_t const capacity_)
+{
+	for (auto & component : centers)
+		component.reserve(capacity_);
+	radii.reserve(capacity_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BallArray< TVectorType, TValueType >::clear()
+{
+	for (auto & component : centers)
+		component.clear();
+	radii.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BallArray< TVectorType, TValueType >::push_back(ShapeType const & ball_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		centers[d].push_back(ball_.center[d]);
+	radii.push_back(ball_.getRadius());
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename BallArray< TVectorType, TValueType >::ShapeType BallArray< TVectorType, TValueType >::get(std::size_t const index_) const
+{
+	VectorType center;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		center[d] = centers[d][index_];
+	return ShapeType{ center, radii[index_] };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BallArray< TVectorType, TValueType >::set(std::size_t const index_, ShapeType const & ball_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		centers[d][index_] = ball_.center[d];
+	radii[index_] = ball_.getRadius();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::size_t BoxArray< TVectorType, TValueType >::size() const
+{
+	return centers[0].size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BoxArray< TVectorType, TValueType >::reserve(std::size_t const capacity_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d].reserve(capacity_);
+		halfExtents[d].reserve(capacity_);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BoxArray< TVectorType, TValueType >::clear()
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d].clear();
+		halfExtents[d].clear();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BoxArray< TVectorType, TValueType >::push_back(ShapeType const & box_)
+{
+	VectorType const halfExtent = box_.getHalfExtent();
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d].push_back(box_.center[d]);
+		halfExtents[d].push_back(halfExtent[d]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename BoxArray< TVectorType, TValueType >::ShapeType BoxArray< TVectorType, TValueType >::get(std::size_t const index_) const
+{
+	VectorType center, halfExtent;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		center[d] = centers[d][index_];
+		halfExtent[d] = halfExtents[d][index_];
+	}
+	return ShapeType{ center, halfExtent };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void BoxArray< TVectorType, TValueType >::set(std::size_t const index_, ShapeType const & box_)
+{
+	VectorType const halfExtent = box_.getHalfExtent();
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		centers[d][index_] = box_.center[d];
+		halfExtents[d][index_] = halfExtent[d];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::size_t AabbArray< TVectorType, TValueType >::size() const
+{
+	return lowers[0].size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void AabbArray< TVectorType, TValueType >::reserve(std::size_t const capacity_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d].reserve(capacity_);
+		uppers[d].reserve(capacity_);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void AabbArray< TVectorType, TValueType >::clear()
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d].clear();
+		uppers[d].clear();
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void AabbArray< TVectorType, TValueType >::push_back(ShapeType const & aabb_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d].push_back(aabb_.lower[d]);
+		uppers[d].push_back(aabb_.upper[d]);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename AabbArray< TVectorType, TValueType >::ShapeType AabbArray< TVectorType, TValueType >::get(std::size_t const index_) const
+{
+	ShapeType result;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		result.lower[d] = lowers[d][index_];
+		result.upper[d] = uppers[d][index_];
+	}
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void AabbArray< TVectorType, TValueType >::set(std::size_t const index_, ShapeType const & aabb_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		lowers[d][index_] = aabb_.lower[d];
+		uppers[d][index_] = aabb_.upper[d];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+PointArray< TVectorType, TValueType >::PointArray(std::vector<VectorType> const & points_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		coordinates[d].resize(points_.size());
+		for (std::size_t i = 0; i < points_.size(); ++i)
+			coordinates[d][i] = points_[i][d];
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+std::size_t PointArray< TVectorType, TValueType >::size() const
+{
+	return coordinates[0].size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void PointArray< TVectorType, TValueType >::reserve(std::size_t const capacity_)
+{
+	for (auto & component : coordinates)
+		component.reserve(capacity_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void PointArray< TVectorType, TValueType >::clear()
+{
+	for (auto & component : coordinates)
+		component.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void PointArray< TVectorType, TValueType >::push_back(VectorType const & point_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		coordinates[d].push_back(point_[d]);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+typename PointArray< TVectorType, TValueType >::VectorType PointArray< TVectorType, TValueType >::get(std::size_t const index_) const
+{
+	VectorType point;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		point[d] = coordinates[d][index_];
+	return point;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <template <typename> class TVectorType, typename TValueType>
+void PointArray< TVectorType, TValueType >::set(std::size_t const index_, VectorType const & point_)
+{
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		coordinates[d][index_] = point_[d];
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,283 @@
+// Note: this file is not meant to be included on its own.
+// Include "SpatialHashGrid.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Cell coordinates are clamped to [-limit, limit].
+constexpr std::int32_t cxHashGridCellLimit = std::int32_t(1) << 30;
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+SpatialHashGrid<TShapeType>::SpatialHashGrid(ValueType const cellSize_)
+	:
+	m_cellSize{ cellSize_ }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void SpatialHashGrid<TShapeType>::build(std::vector<ShapeType> shapes_, std::size_t const threadCount_)
+{
+	constexpr std::size_t maxEntries = std::numeric_limits<std::uint32_t>::max();
+	if (shapes_.size() > maxEntries)
+		throw std::length_error("Too many shapes for spatial hash grid");
+
+	m_shapes = std::move(shapes_);
+	std::size_t const count = m_shapes.size();
+
+	// Cell ranges of the shapes and number of entries:
+	m_lowerCells.resize(count);
+	std::vector<CellType> upperCells(count);
+	std::vector<std::size_t> chunkEntries(priv::parallelChunkCount(count, threadCount_));
+	priv::parallelFor(count, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+		{
+			std::size_t entries = 0;
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				this->computeCellRange(computeBounds(m_shapes[i]), m_lowerCells[i], upperCells[i]);
+
+				// Counts saturate just above the limit, so huge shapes cannot wrap them around:
+				std::size_t cells = 1;
+				for (std::size_t d = 0; d < Dimensions; ++d)
+				{
+					std::size_t const span = static_cast<std::size_t>(std::int64_t(upperCells[i][d]) - m_lowerCells[i][d]) + 1;
+					cells = cells > maxEntries / span ? maxEntries + 1 : cells * span;
+				}
+				entries = std::min(entries + cells, maxEntries + 1);
+			}
+			chunkEntries[chunk_] = entries;
+		});
+
+	std::size_t entryCount = 0;
+	for (std::size_t const entries : chunkEntries)
+		entryCount = std::min(entryCount + entries, maxEntries + 1);
+	if (entryCount > maxEntries)
+		throw std::length_error("Too many cells touched by the shapes, cell size of the spatial hash grid is too small");
+
+	std::size_t bucketCount = 1;
+	while (bucketCount < entryCount)
+		bucketCount *= 2;
+	m_bucketMask = static_cast<std::uint32_t>(bucketCount - 1);
+
+	// Counting sort of the entries by bucket: count, scan, then scatter with the counters as cursors.
+	std::vector< std::atomic<std::uint32_t> > counters(bucketCount);
+	priv::parallelFor(count, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				forEachCell(m_lowerCells[i], upperCells[i], [&](CellType const & cell_) {
+						counters[this->getBucket(cell_)].fetch_add(1, std::memory_order_relaxed);
+					});
+			}
+		});
+
+	m_bucketStarts.assign(bucketCount + 1, 0);
+	for (std::size_t b = 0; b < bucketCount; ++b)
+	{
+		m_bucketStarts[b + 1] = m_bucketStarts[b] + counters[b].load(std::memory_order_relaxed);
+		counters[b].store(m_bucketStarts[b], std::memory_order_relaxed);
+	}
+
+	m_entryCells.resize(entryCount);
+	m_entryShapes.resize(entryCount);
+	priv::parallelFor(count, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t)
+		{
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				forEachCell(m_lowerCells[i], upperCells[i], [&](CellType const & cell_) {
+						std::uint32_t const entry = counters[this->getBucket(cell_)].fetch_add(1, std::memory_order_relaxed);
+						m_entryCells[entry] = cell_;
+						m_entryShapes[entry] = static_cast<std::uint32_t>(i);
+					});
+			}
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t SpatialHashGrid<TShapeType>::size() const
+{
+	return m_shapes.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+typename SpatialHashGrid<TShapeType>::ValueType SpatialHashGrid<TShapeType>::getCellSize() const
+{
+	return m_cellSize;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<TShapeType> const & SpatialHashGrid<TShapeType>::getShapes() const
+{
+	return m_shapes;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+typename SpatialHashGrid<TShapeType>::CellType SpatialHashGrid<TShapeType>::getCell(VectorType const & point_) const
+{
+	using ScalarType = std::conditional_t<std::is_floating_point_v<ValueType>, ValueType, double>;
+	constexpr ScalarType limit = static_cast<ScalarType>(priv::cxHashGridCellLimit);
+
+	CellType cell;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+	{
+		ScalarType const coordinate = std::floor(static_cast<ScalarType>(point_[d]) / static_cast<ScalarType>(m_cellSize));
+		cell[d] = static_cast<std::int32_t>(std::clamp(coordinate, -limit, limit));
+	}
+	return cell;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TQueryShapeType, typename TFunction>
+void SpatialHashGrid<TShapeType>::forEachOverlapping(TQueryShapeType const & shape_, TFunction && function_) const
+{
+	if (m_shapes.empty())
+		return;
+
+	CellType lower, upper;
+	this->computeCellRange(computeBounds(shape_), lower, upper);
+	forEachCell(lower, upper, [&](CellType const & cell_) {
+			std::size_t const bucket = this->getBucket(cell_);
+			for (std::size_t e = m_bucketStarts[bucket]; e < m_bucketStarts[bucket + 1]; ++e)
+			{
+				std::size_t const index = m_entryShapes[e];
+				if (m_entryCells[e] == cell_ && isFirstSharedCell(cell_, lower, m_lowerCells[index])
+					&& intersects(shape_, m_shapes[index]))
+				{
+					function_(index);
+				}
+			}
+		});
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TQueryShapeType>
+std::vector<std::size_t> SpatialHashGrid<TShapeType>::findOverlapping(TQueryShapeType const & shape_) const
+{
+	std::vector<std::size_t> result;
+	this->forEachOverlapping(shape_, [&result](std::size_t const index_) { result.push_back(index_); });
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<typename SpatialHashGrid<TShapeType>::PairType> SpatialHashGrid<TShapeType>::findOverlappingPairs(std::size_t const threadCount_) const
+{
+	if (m_shapes.empty())
+		return {};
+
+	// Every chunk of buckets collects its own pairs, concatenated at the end.
+	std::size_t const bucketCount = m_bucketStarts.size() - 1;
+	std::vector< std::vector<PairType> > chunkPairs(priv::parallelChunkCount(bucketCount, threadCount_));
+	priv::parallelFor(bucketCount, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+		{
+			auto & pairs = chunkPairs[chunk_];
+			for (std::size_t bucket = begin_; bucket < end_; ++bucket)
+			{
+				std::size_t const last = m_bucketStarts[bucket + 1];
+				for (std::size_t e = m_bucketStarts[bucket]; e < last; ++e)
+				{
+					CellType const & cell = m_entryCells[e];
+					std::size_t const first = m_entryShapes[e];
+					for (std::size_t o = e + 1; o < last; ++o)
+					{
+						std::size_t const second = m_entryShapes[o];
+						if (m_entryCells[o] == cell && isFirstSharedCell(cell, m_lowerCells[first], m_lowerCells[second])
+							&& intersects(m_shapes[first], m_shapes[second]))
+						{
+							pairs.push_back(std::minmax(first, second));
+						}
+					}
+				}
+			}
+		});
+
+	std::size_t pairCount = 0;
+	for (auto const & pairs : chunkPairs)
+		pairCount += pairs.size();
+
+	std::vector<PairType> result;
+	result.reserve(pairCount);
+	for (auto const & pairs : chunkPairs)
+		result.insert(result.end(), pairs.begin(), pairs.end());
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void SpatialHashGrid<TShapeType>::computeCellRange(AabbType const & bounds_, CellType & lower_, CellType & upper_) const
+{
+	lower_ = this->getCell(bounds_.lower);
+	upper_ = this->getCell(bounds_.upper);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t SpatialHashGrid<TShapeType>::getBucket(CellType const & cell_) const
+{
+	constexpr std::uint32_t primes[] = { 73856093u, 19349663u, 83492791u };
+
+	std::uint32_t hash = 0;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		hash ^= static_cast<std::uint32_t>(cell_[d]) * primes[d];
+
+	// Mix high bits into the low ones, the bucket count is a power of 2:
+	hash ^= hash >> 16;
+	hash *= 0x85ebca6bu;
+	hash ^= hash >> 13;
+	return hash & m_bucketMask;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+template <typename TFunction>
+void SpatialHashGrid<TShapeType>::forEachCell(CellType const & lower_, CellType const & upper_, TFunction && function_)
+{
+	CellType cell = lower_;
+	while (true)
+	{
+		function_(cell);
+
+		std::size_t d = 0;
+		for (; d < Dimensions; ++d)
+		{
+			if (cell[d] < upper_[d])
+			{
+				++cell[d];
+				break;
+			}
+			cell[d] = lower_[d];
+		}
+		if (d == Dimensions)
+			return;
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+bool SpatialHashGrid<TShapeType>::isFirstSharedCell(CellType const & cell_, CellType const & firstLower_, CellType const & secondLower_)
+{
+	bool result = true;
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		result &= cell_[d] == std::max(firstLower_[d], secondLower_[d]);
+	return result;
+}
+
+}
\ No newline at end of file
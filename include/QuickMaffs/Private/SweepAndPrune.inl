@@ -0,0 +1,216 @@
+// Note: this file is not meant to be included on its own.
+// Include "SweepAndPrune.hpp" instead.
+
+#include "Parallel.hpp"
+#include "RadixSort.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+// Insertion sort gives up when it shifted elements more times than this per shape.
+constexpr std::size_t cxSweepMaxShiftsPerShape = 16;
+// Automatically chosen axis changes only when the variance along the new one is this many times larger.
+constexpr double cxSweepAxisSwitchRatio = 1.5;
+
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+SweepAndPrune<TShapeType>::SweepAndPrune(std::size_t const axis_)
+	:
+	m_fixedAxis{ axis_ }
+{
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void SweepAndPrune<TShapeType>::update(std::vector<ShapeType> shapes_, std::size_t const threadCount_)
+{
+	if (shapes_.size() > std::numeric_limits<std::uint32_t>::max())
+		throw std::length_error("Too many shapes for sweep and prune");
+
+	bool cold = shapes_.size() != m_shapes.size() || m_axis == npos;
+	m_shapes = std::move(shapes_);
+
+	std::size_t const axis = m_fixedAxis != npos ? m_fixedAxis : this->chooseAxis(!cold);
+	cold |= axis != m_axis;
+	m_axis = axis;
+
+	std::size_t const count = m_shapes.size();
+	m_lowers.resize(count);
+	m_uppers.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		auto const bounds = computeBounds(m_shapes[i]);
+		m_lowers[i] = bounds.lower[m_axis];
+		m_uppers[i] = bounds.upper[m_axis];
+	}
+
+	if (cold || !this->repairOrder())
+		this->sortOrder(threadCount_);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void SweepAndPrune<TShapeType>::clear()
+{
+	m_axis = npos;
+	m_shapes.clear();
+	m_lowers.clear();
+	m_uppers.clear();
+	m_order.clear();
+	m_sortedLowers.clear();
+	m_sortedUppers.clear();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t SweepAndPrune<TShapeType>::size() const
+{
+	return m_shapes.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t SweepAndPrune<TShapeType>::getAxis() const
+{
+	return m_axis;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<std::uint32_t> const & SweepAndPrune<TShapeType>::getOrder() const
+{
+	return m_order;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::vector<typename SweepAndPrune<TShapeType>::PairType> SweepAndPrune<TShapeType>::findOverlappingPairs(std::size_t const threadCount_) const
+{
+	// Every chunk of the sorted intervals collects its own pairs, concatenated at the end.
+	std::size_t const count = m_order.size();
+	std::vector< std::vector<PairType> > chunkPairs(priv::parallelChunkCount(count, threadCount_));
+	priv::parallelFor(count, threadCount_,
+		[&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_)
+		{
+			auto & pairs = chunkPairs[chunk_];
+			for (std::size_t k = begin_; k < end_; ++k)
+			{
+				std::size_t const first = m_order[k];
+				ValueType const upper = m_sortedUppers[k];
+				for (std::size_t o = k + 1; o < count && m_sortedLowers[o] <= upper; ++o)
+				{
+					std::size_t const second = m_order[o];
+					if (intersects(m_shapes[first], m_shapes[second]))
+						pairs.push_back(std::minmax(first, second));
+				}
+			}
+		});
+
+	std::size_t pairCount = 0;
+	for (auto const & pairs : chunkPairs)
+		pairCount += pairs.size();
+
+	std::vector<PairType> result;
+	result.reserve(pairCount);
+	for (auto const & pairs : chunkPairs)
+		result.insert(result.end(), pairs.begin(), pairs.end());
+	return result;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+std::size_t SweepAndPrune<TShapeType>::chooseAxis(bool const keepCurrent_) const
+{
+	// Variance of the centers along every axis, accumulated in double:
+	std::array<double, Dimensions> sums{}, squareSums{};
+	for (auto const & shape : m_shapes)
+	{
+		auto const center = computeBounds(shape).getCenter();
+		for (std::size_t d = 0; d < Dimensions; ++d)
+		{
+			double const value = static_cast<double>(center[d]);
+			sums[d] += value;
+			squareSums[d] += value * value;
+		}
+	}
+
+	std::array<double, Dimensions> variances{};
+	double const count = static_cast<double>(std::max(m_shapes.size(), std::size_t(1)));
+	for (std::size_t d = 0; d < Dimensions; ++d)
+		variances[d] = squareSums[d] / count - (sums[d] / count) * (sums[d] / count);
+
+	std::size_t const best = static_cast<std::size_t>(std::max_element(variances.begin(), variances.end()) - variances.begin());
+	if (keepCurrent_ && !(variances[best] > variances[m_axis] * priv::cxSweepAxisSwitchRatio))
+		return m_axis;
+	return best;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+bool SweepAndPrune<TShapeType>::repairOrder()
+{
+	std::size_t const count = m_order.size();
+	for (std::size_t k = 0; k < count; ++k)
+	{
+		m_sortedLowers[k] = m_lowers[m_order[k]];
+		m_sortedUppers[k] = m_uppers[m_order[k]];
+	}
+
+	// Insertion sort; the result of an early exit is still a permutation, sorted from scratch then.
+	std::size_t shifts = 0;
+	std::size_t const maxShifts = count * priv::cxSweepMaxShiftsPerShape;
+	for (std::size_t k = 1; k < count; ++k)
+	{
+		ValueType const lower = m_sortedLowers[k];
+		if (!(lower < m_sortedLowers[k - 1]))
+			continue;
+
+		ValueType const upper = m_sortedUppers[k];
+		std::uint32_t const index = m_order[k];
+		std::size_t o = k;
+		for (; o > 0 && lower < m_sortedLowers[o - 1]; --o)
+		{
+			m_sortedLowers[o] = m_sortedLowers[o - 1];
+			m_sortedUppers[o] = m_sortedUppers[o - 1];
+			m_order[o] = m_order[o - 1];
+		}
+		m_sortedLowers[o] = lower;
+		m_sortedUppers[o] = upper;
+		m_order[o] = index;
+
+		shifts += k - o;
+		if (shifts > maxShifts)
+			return false;
+	}
+	return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TShapeType>
+void SweepAndPrune<TShapeType>::sortOrder(std::size_t const threadCount_)
+{
+	std::size_t const count = m_shapes.size();
+	std::vector< priv::RadixKeyType<ValueType> > keys(count);
+	m_order.resize(count);
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		keys[i] = priv::toRadixKey(m_lowers[i]);
+		m_order[i] = static_cast<std::uint32_t>(i);
+	}
+	priv::radixSort(keys, m_order, threadCount_);
+
+	m_sortedLowers.resize(count);
+	m_sortedUppers.resize(count);
+	for (std::size_t k = 0; k < count; ++k)
+	{
+		m_sortedLowers[k] = m_lowers[m_order[k]];
+		m_sortedUppers[k] = m_uppers[m_order[k]];
+	}
+}
+
+}
\ No newline at end of file
@@ -0,0 +1,240 @@
+// Note: this file is not meant to be included on its own.
+// Include "TriangleMesh.hpp" instead.
+
+#include "Parallel.hpp"
+
+namespace quickmaffs
+{
+
+namespace priv
+{
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Möller–Trumbore test of the ray against triangles [begin_, begin_ + count_) given as corner and two edges.
+/// Writes the ray parameter of every hit, infinity on miss.
+/// </summary>
+/// <remarks>
+/// <para>
+/// One ray against a block of triangles, branch-free so that the loop vectorizes over triangles.
+/// Degenerate triangles and rays parallel to the triangle plane miss. Barycentric weights are not written:
+/// every extra output array multiplies the run-time alias checks the vectorized loop needs.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+void intersectTriangles(Ray3<TValueType> const & ray_, std::array< std::vector<TValueType>, 3 > const & corners_,
+						std::array< std::vector<TValueType>, 3 > const & edges1_, std::array< std::vector<TValueType>, 3 > const & edges2_,
+						std::size_t const begin_, std::size_t const count_, TValueType * distances_)
+{
+	using V = TValueType;
+	constexpr V infinity = std::numeric_limits<V>::infinity();
+
+	V const ox = ray_.origin.x, oy = ray_.origin.y, oz = ray_.origin.z;
+	V const dx = ray_.direction.x, dy = ray_.direction.y, dz = ray_.direction.z;
+
+	V const * cornersX = corners_[0].data() + begin_;
+	V const * cornersY = corners_[1].data() + begin_;
+	V const * cornersZ = corners_[2].data() + begin_;
+	V const * edges1X = edges1_[0].data() + begin_;
+	V const * edges1Y = edges1_[1].data() + begin_;
+	V const * edges1Z = edges1_[2].data() + begin_;
+	V const * edges2X = edges2_[0].data() + begin_;
+	V const * edges2Y = edges2_[1].data() + begin_;
+	V const * edges2Z = edges2_[2].data() + begin_;
+
+	for (std::size_t i = 0; i < count_; ++i)
+	{
+		// p = direction x edge2
+		V const px = dy * edges2Z[i] - dz * edges2Y[i];
+		V const py = dz * edges2X[i] - dx * edges2Z[i];
+		V const pz = dx * edges2Y[i] - dy * edges2X[i];
+		V const determinant = edges1X[i] * px + edges1Y[i] * py + edges1Z[i] * pz;
+		V const inverse = V(1) / determinant;
+
+		V const sx = ox - cornersX[i];
+		V const sy = oy - cornersY[i];
+		V const sz = oz - cornersZ[i];
+		V const u = (sx * px + sy * py + sz * pz) * inverse;
+
+		// q = s x edge1
+		V const qx = sy * edges1Z[i] - sz * edges1Y[i];
+		V const qy = sz * edges1X[i] - sx * edges1Z[i];
+		V const qz = sx * edges1Y[i] - sy * edges1X[i];
+		V const v = (dx * qx + dy * qy + dz * qz) * inverse;
+		V const t = (edges2X[i] * qx + edges2Y[i] * qy + edges2Z[i] * qz) * inverse;
+
+		// Misses are folded in with max of 0 or infinity, see castRay of ball packets. A NaN `t` loses to `miss`.
+		V const miss = (determinant != V(0) ? V(0) : infinity) + (u >= V(0) ? V(0) : infinity)
+			+ (v >= V(0) ? V(0) : infinity) + (u + v <= V(1) ? V(0) : infinity) + (t >= V(0) ? V(0) : infinity);
+		distances_[i] = std::max(miss, t);
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+/// <summary>
+/// Computes barycentric weights of the second and third corner where the ray meets the plane of the triangle.
+/// </summary>
+template <typename TValueType>
+void triangleBarycentric(Ray3<TValueType> const & ray_, Vector3<TValueType> const & corner_,
+						Vector3<TValueType> const & edge1_, Vector3<TValueType> const & edge2_, TValueType & u_, TValueType & v_)
+{
+	Vector3<TValueType> const p = ray_.direction.cross(edge2_);
+	TValueType const inverse = TValueType(1) / edge1_.dot(p);
+	Vector3<TValueType> const s = ray_.origin - corner_;
+	u_ = s.dot(p) * inverse;
+	v_ = ray_.direction.dot(s.cross(edge1_)) * inverse;
+}
+
+} // namespace priv
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+TriangleMesh<TValueType>::TriangleMesh(std::vector<VectorType> vertices_, std::vector<IndexType> indices_)
+	:
+	m_vertices{ std::move(vertices_) },
+	m_indices{ std::move(indices_) }
+{
+	if (m_indices.size() % 3 != 0)
+		throw std::invalid_argument("Index count of triangle mesh must be a multiple of 3");
+	if (m_vertices.size() > std::numeric_limits<IndexType>::max())
+		throw std::length_error("Too many vertices for triangle mesh");
+	for (IndexType const index : m_indices)
+	{
+		if (index >= m_vertices.size())
+			throw std::out_of_range("Triangle mesh index does not refer to a vertex");
+	}
+
+	std::size_t const triangleCount = this->getTriangleCount();
+	for (std::size_t d = 0; d < 3; ++d)
+	{
+		m_corners[d].resize(triangleCount);
+		m_edges1[d].resize(triangleCount);
+		m_edges2[d].resize(triangleCount);
+	}
+
+	for (std::size_t i = 0; i < triangleCount; ++i)
+	{
+		std::array<VectorType, 3> const triangle = this->getTriangle(i);
+		VectorType const edge1 = triangle[1] - triangle[0];
+		VectorType const edge2 = triangle[2] - triangle[0];
+		for (std::size_t d = 0; d < 3; ++d)
+		{
+			m_corners[d][i] = triangle[0][d];
+			m_edges1[d][i] = edge1[d];
+			m_edges2[d][i] = edge2[d];
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::vector<typename TriangleMesh<TValueType>::VectorType> const & TriangleMesh<TValueType>::getVertices() const
+{
+	return m_vertices;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::vector<typename TriangleMesh<TValueType>::IndexType> const & TriangleMesh<TValueType>::getIndices() const
+{
+	return m_indices;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::size_t TriangleMesh<TValueType>::getTriangleCount() const
+{
+	return m_indices.size() / 3;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::array<typename TriangleMesh<TValueType>::VectorType, 3> TriangleMesh<TValueType>::getTriangle(std::size_t const triangle_) const
+{
+	IndexType const * indices = m_indices.data() + triangle_ * 3;
+	return { m_vertices[indices[0]], m_vertices[indices[1]], m_vertices[indices[2]] };
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::vector<typename TriangleMesh<TValueType>::VectorType> TriangleMesh<TValueType>::computeVertexNormals(std::size_t const threadCount_) const
+{
+	std::size_t const triangleCount = this->getTriangleCount();
+	std::size_t const vertexCount = m_vertices.size();
+
+	// One buffer of partial sums per chunk of triangles.
+	std::vector< std::vector<VectorType> > partialSums(priv::parallelChunkCount(triangleCount, threadCount_));
+	priv::parallelFor(triangleCount, threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t const chunk_) {
+			std::vector<VectorType> & sums = partialSums[chunk_];
+			sums.assign(vertexCount, VectorType{});
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				IndexType const * indices = m_indices.data() + i * 3;
+				VectorType const & a = m_vertices[indices[0]];
+
+				// Length of the cross product is twice the area, which weights the normal.
+				VectorType const normal = (m_vertices[indices[1]] - a).cross(m_vertices[indices[2]] - a);
+				sums[indices[0]] += normal;
+				sums[indices[1]] += normal;
+				sums[indices[2]] += normal;
+			}
+		});
+
+	std::vector<VectorType> normals(vertexCount);
+	priv::parallelFor(vertexCount, threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t) {
+			for (std::size_t i = begin_; i < end_; ++i)
+			{
+				VectorType sum;
+				for (auto const & sums : partialSums)
+					sum += sums[i];
+				normals[i] = sum.normalize();
+			}
+		});
+	return normals;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+typename TriangleMesh<TValueType>::HitType TriangleMesh<TValueType>::castRay(RayType const & ray_) const
+{
+	ValueType distances[priv::cxShapeBatchBlock];
+
+	HitType hit{ npos, std::numeric_limits<ValueType>::infinity(), ValueType(0), ValueType(0) };
+
+	std::size_t const triangleCount = this->getTriangleCount();
+	for (std::size_t blockBegin = 0; blockBegin < triangleCount; blockBegin += priv::cxShapeBatchBlock)
+	{
+		std::size_t const blockSize = std::min(priv::cxShapeBatchBlock, triangleCount - blockBegin);
+		priv::intersectTriangles(ray_, m_corners, m_edges1, m_edges2, blockBegin, blockSize, distances);
+
+		std::size_t const nearest = static_cast<std::size_t>(std::min_element(distances, distances + blockSize) - distances);
+		if (distances[nearest] < hit.distance)
+		{
+			hit.triangle = blockBegin + nearest;
+			hit.distance = distances[nearest];
+		}
+	}
+
+	if (hit.triangle != npos)
+	{
+		auto const corner = [&](std::array< std::vector<ValueType>, 3 > const & components_) {
+				return VectorType{ components_[0][hit.triangle], components_[1][hit.triangle], components_[2][hit.triangle] };
+			};
+		priv::triangleBarycentric(ray_, corner(m_corners), corner(m_edges1), corner(m_edges2), hit.u, hit.v);
+	}
+	return hit;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////////////////
+template <typename TValueType>
+std::vector<typename TriangleMesh<TValueType>::HitType> TriangleMesh<TValueType>::castRays(std::vector<RayType> const & rays_, std::size_t const threadCount_) const
+{
+	std::vector<HitType> hits(rays_.size());
+	priv::parallelFor(rays_.size(), threadCount_, [&](std::size_t const begin_, std::size_t const end_, std::size_t) {
+			for (std::size_t i = begin_; i < end_; ++i)
+				hits[i] = this->castRay(rays_[i]);
+		});
+	return hits;
+}
+
+}
\ No newline at end of file
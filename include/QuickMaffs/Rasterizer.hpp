@@ -0,0 +1,70 @@
+// File description:
+// Implements active edge table scanline rasterization of polygons into coverage masks.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Polygon2.hpp"
+#include "Box.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Specifies how pixel coverage is computed.
+/// </summary>
+enum class RasterMode
+{
+	Binary,			// Pixel is either fully covered (255) or empty (0), depending on its center.
+	AntiAliased		// Pixel stores approximate area covered by polygons (0 - 255).
+};
+
+/// <summary>
+/// Specifies which parts of overlapping or self-intersecting polygons are filled.
+/// </summary>
+enum class FillRule
+{
+	EvenOdd,		// Point is inside when a ray from it crosses edges odd number of times.
+	NonZero			// Point is inside when winding number of the edges around it is non zero.
+};
+
+/// <summary>
+/// Describes destination of the rasterization - a caller-provided buffer of 8-bit coverage values.
+/// </summary>
+template <typename TValueType>
+struct RasterTile
+{
+	Rect2<TValueType>	region;				// Region of the plane covered by the tile.
+	Vector2size			resolution;			// Number of pixels in x and y direction.
+	std::uint8_t *		pixels = nullptr;	// First pixel of the first row.
+	std::ptrdiff_t		stride = 0;			// Distance in bytes between the beginnings of consecutive rows.
+};
+
+/// <summary>
+/// Rasterizes polygons into a tile. Every pixel of the tile is overwritten.
+/// </summary>
+/// <param name="polygons_">The polygons.</param>
+/// <param name="tile_">The destination tile.</param>
+/// <param name="mode_">The coverage computation mode.</param>
+/// <param name="fillRule_">The fill rule.</param>
+template <typename TValueType>
+void rasterizePolygons(std::vector< Polygon2<TValueType> > const & polygons_, RasterTile<TValueType> const & tile_,
+						RasterMode const mode_ = RasterMode::AntiAliased, FillRule const fillRule_ = FillRule::EvenOdd);
+
+/// <summary>
+/// Rasterizes polygons into multiple independent tiles, processed in parallel.
+/// </summary>
+/// <param name="polygons_">The polygons.</param>
+/// <param name="tiles_">The destination tiles. Tiles must not share pixel memory.</param>
+/// <param name="mode_">The coverage computation mode.</param>
+/// <param name="fillRule_">The fill rule.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+template <typename TValueType>
+void rasterizePolygons(std::vector< Polygon2<TValueType> > const & polygons_, std::vector< RasterTile<TValueType> > const & tiles_,
+						RasterMode const mode_ = RasterMode::AntiAliased, FillRule const fillRule_ = FillRule::EvenOdd,
+						std::size_t const threadCount_ = 0);
+
+}
+
+#include "Private/Rasterizer.inl"
\ No newline at end of file
@@ -0,0 +1,232 @@
+// File description:
+// Implements rays, structure-of-arrays ray packets and ray casting against balls, boxes, bounds and polygons.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Vector3.hpp"
+#include "Polygon2.hpp"
+#include "Ball.hpp"
+#include "Box.hpp"
+#include "Aabb.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// A ray `origin + t * direction`, t in [0, inf).
+/// </summary>
+/// <remarks>
+/// <para>
+/// The direction does not have to be normalized. Hit distances returned by <see cref="castRay"/> are the parameter t,
+/// so they are measured in multiples of the direction length.
+/// </para>
+/// </remarks>
+template <template <typename> typename TVectorType, typename TValueType>
+struct Ray
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+
+	static_assert(std::is_floating_point_v<ValueType>, "Rays require floating point type");
+
+	// Methods:
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Ray"/> struct.
+	/// </summary>
+	constexpr Ray() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="Ray"/> struct.
+	/// </summary>
+	/// <param name="origin_">The origin.</param>
+	/// <param name="direction_">The direction, does not have to be normalized.</param>
+	constexpr Ray(VectorType const& origin_, VectorType const& direction_);
+
+	/// <summary>
+	/// Returns point on the ray at the specified parameter.
+	/// </summary>
+	/// <param name="distance_">The parameter t.</param>
+	/// <returns>Point `origin + distance_ * direction`.</returns>
+	constexpr VectorType getPoint(ValueType const distance_) const;
+
+	VectorType	origin;
+	VectorType	direction;
+};
+
+/// <summary>
+/// A fixed number of rays stored as structure of arrays: one array of `TSize` lanes per origin and direction component.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Packet casts process all lanes with branch-free loops, which the compiler turns into SIMD instructions
+/// (4, 8 or 16 lanes match SSE, AVX and AVX-512 registers of floats). Unused lanes should repeat a valid ray.
+/// </para>
+/// </remarks>
+template <template <typename> typename TVectorType, typename TValueType, std::size_t TSize>
+struct RayPacket
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using RayType		= Ray<TVectorType, ValueType>;
+	using LanesType		= std::array<ValueType, TSize>;
+
+	static constexpr std::size_t Dimensions	= VectorType{}.size();
+	static constexpr std::size_t Size		= TSize;
+
+	static_assert(std::is_floating_point_v<ValueType>, "Rays require floating point type");
+	static_assert(TSize > 0, "Ray packet must have at least one lane");
+
+	/// <summary>
+	/// Replaces ray at specified lane.
+	/// </summary>
+	/// <param name="lane_">The lane.</param>
+	/// <param name="ray_">The ray.</param>
+	constexpr void set(std::size_t const lane_, RayType const & ray_);
+
+	/// <summary>
+	/// Returns ray at specified lane.
+	/// </summary>
+	/// <param name="lane_">The lane.</param>
+	/// <returns>Ray at specified lane.</returns>
+	constexpr RayType get(std::size_t const lane_) const;
+
+	std::array< LanesType, Dimensions >	origins{};
+	std::array< LanesType, Dimensions >	directions{};
+};
+
+/// <summary>
+/// Casts the ray against the ball.
+/// </summary>
+/// <param name="ray_">The ray.</param>
+/// <param name="ball_">The ball.</param>
+/// <returns>Parameter t where the ray enters the ball (0 when the origin is inside), or infinity if the ray misses.</returns>
+template <template<typename> typename T, typename V>
+V castRay(Ray<T, V> const & ray_, Ball<T, V> const & ball_);
+
+/// <summary>
+/// Casts the ray against the box.
+/// </summary>
+/// <param name="ray_">The ray.</param>
+/// <param name="box_">The box.</param>
+/// <returns>Parameter t where the ray enters the box (0 when the origin is inside), or infinity if the ray misses.</returns>
+template <template<typename> typename T, typename V>
+V castRay(Ray<T, V> const & ray_, Box<T, V> const & box_);
+
+/// <summary>
+/// Casts the ray against the bounds.
+/// </summary>
+/// <param name="ray_">The ray.</param>
+/// <param name="aabb_">The bounds.</param>
+/// <returns>Parameter t where the ray enters the bounds (0 when the origin is inside), or infinity if the ray misses.</returns>
+template <template<typename> typename T, typename V>
+V castRay(Ray<T, V> const & ray_, Aabb<T, V> const & aabb_);
+
+/// <summary>
+/// Casts the ray against the polygon edges.
+/// </summary>
+/// <param name="ray_">The ray.</param>
+/// <param name="polygon_">The polygon.</param>
+/// <returns>Parameter t of the first edge crossing, or infinity if the ray crosses no edge.</returns>
+/// <remarks>
+/// <para>
+/// Only the outline is tested: a ray starting inside the polygon hits the edge it leaves through.
+/// Edges parallel to the ray are not reported.
+/// </para>
+/// </remarks>
+template <typename V>
+V castRay(Ray<Vector2, V> const & ray_, Polygon2<V> const & polygon_);
+
+// Packet variants, one distance per lane.
+
+/// <summary>
+/// Casts every ray of the packet against the ball, see <see cref="castRay"/>.
+/// </summary>
+/// <param name="packet_">The ray packet.</param>
+/// <param name="ball_">The ball.</param>
+/// <returns>Hit distance of every lane, infinity where the ray misses.</returns>
+template <template<typename> typename T, typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<T, V, N> const & packet_, Ball<T, V> const & ball_);
+
+/// <summary>
+/// Casts every ray of the packet against the box (slab test), see <see cref="castRay"/>.
+/// </summary>
+/// <param name="packet_">The ray packet.</param>
+/// <param name="box_">The box.</param>
+/// <returns>Hit distance of every lane, infinity where the ray misses.</returns>
+template <template<typename> typename T, typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<T, V, N> const & packet_, Box<T, V> const & box_);
+
+/// <summary>
+/// Casts every ray of the packet against the bounds (slab test), see <see cref="castRay"/>.
+/// </summary>
+/// <param name="packet_">The ray packet.</param>
+/// <param name="aabb_">The bounds.</param>
+/// <returns>Hit distance of every lane, infinity where the ray misses.</returns>
+template <template<typename> typename T, typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<T, V, N> const & packet_, Aabb<T, V> const & aabb_);
+
+/// <summary>
+/// Casts every ray of the packet against the polygon edges, see <see cref="castRay"/>.
+/// </summary>
+/// <param name="packet_">The ray packet.</param>
+/// <param name="polygon_">The polygon.</param>
+/// <returns>Hit distance of every lane, infinity where the ray crosses no edge.</returns>
+/// <remarks>
+/// <para>
+/// Edges are visited one at a time and every edge is tested against all lanes at once.
+/// </para>
+/// </remarks>
+template <typename V, std::size_t N>
+std::array<V, N> castRay(RayPacket<Vector2, V, N> const & packet_, Polygon2<V> const & polygon_);
+
+/// <summary>
+/// Casts all rays against the shape, packing them into packets and splitting packets between threads.
+/// </summary>
+/// <param name="rays_">The rays.</param>
+/// <param name="shape_">The shape: a ball, box, bounds or (in 2D) polygon.</param>
+/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+/// <returns>Hit distance of every ray, infinity where the ray misses.</returns>
+template <template<typename> typename T, typename V, typename TShapeType>
+std::vector<V> castRays(std::vector< Ray<T, V> > const & rays_, TShapeType const & shape_, std::size_t const threadCount_ = 0);
+
+template <typename TValueType>
+using Ray2 = Ray<Vector2, TValueType>;
+
+template <typename TValueType>
+using Ray3 = Ray<Vector3, TValueType>;
+
+template <typename TValueType, std::size_t TSize>
+using Ray2Packet = RayPacket<Vector2, TValueType, TSize>;
+
+template <typename TValueType, std::size_t TSize>
+using Ray3Packet = RayPacket<Vector3, TValueType, TSize>;
+
+using Ray2f		= Ray2<float>;
+using Ray2d		= Ray2<double>;
+using Ray2ld	= Ray2<long double>;
+
+using Ray3f		= Ray3<float>;
+using Ray3d		= Ray3<double>;
+using Ray3ld	= Ray3<long double>;
+
+using Ray2fPacket4		= Ray2Packet<float, 4>;
+using Ray2fPacket8		= Ray2Packet<float, 8>;
+using Ray2fPacket16		= Ray2Packet<float, 16>;
+using Ray2dPacket4		= Ray2Packet<double, 4>;
+using Ray2dPacket8		= Ray2Packet<double, 8>;
+
+using Ray3fPacket4		= Ray3Packet<float, 4>;
+using Ray3fPacket8		= Ray3Packet<float, 8>;
+using Ray3fPacket16		= Ray3Packet<float, 16>;
+using Ray3dPacket4		= Ray3Packet<double, 4>;
+using Ray3dPacket8		= Ray3Packet<double, 8>;
+
+}
+
+#include "Private/Ray.inl"
\ No newline at end of file
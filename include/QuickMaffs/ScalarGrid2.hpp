@@ -0,0 +1,124 @@
+// File description:
+// Implements regular two dimensional grid of scalar samples placed over a rectangle.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector2.hpp"
+#include "Box.hpp"
+#include "TypeTraits.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Regular grid of scalar samples covering a rectangular region.
+/// Samples are stored row by row and placed at the centers of the grid cells.
+/// </summary>
+template <typename TValueType>
+class ScalarGrid2
+{
+public:
+
+	using ValueType			= TValueType;
+	using VectorType		= Vector2<TValueType>;
+	using RegionType		= Rect2<TValueType>;
+	using ContainerType		= std::vector< ValueType >;
+
+	static_assert(
+		std::is_floating_point_v<ValueType>,
+		"ValueType of a scalar grid must be a floating point type."
+	);
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="ScalarGrid2"/> class.
+	/// </summary>
+	ScalarGrid2() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="ScalarGrid2"/> class.
+	/// </summary>
+	/// <param name="region_">The region covered by the grid.</param>
+	/// <param name="resolution_">Number of cells in x and y direction.</param>
+	/// <param name="fill_">Initial value of every sample.</param>
+	ScalarGrid2(RegionType const & region_, Vector2size const & resolution_, ValueType const fill_ = ValueType(0));
+
+	/// <summary>
+	/// Returns number of cells in x and y direction.
+	/// </summary>
+	/// <returns>Grid resolution.</returns>
+	Vector2size const & getResolution() const;
+
+	/// <summary>
+	/// Returns the region covered by the grid.
+	/// </summary>
+	/// <returns>The region covered by the grid.</returns>
+	RegionType const & getRegion() const;
+
+	/// <summary>
+	/// Returns size of a single cell.
+	/// </summary>
+	/// <returns>Size of a single cell.</returns>
+	VectorType getCellSize() const;
+
+	/// <summary>
+	/// Returns position of the sample with specified coordinates (center of the cell).
+	/// </summary>
+	/// <param name="x_">The column index.</param>
+	/// <param name="y_">The row index.</param>
+	/// <returns>Sample position.</returns>
+	VectorType getSamplePosition(std::size_t const x_, std::size_t const y_) const;
+
+	/// <summary>
+	/// Returns sample with specified coordinates by ref.
+	/// </summary>
+	/// <param name="x_">The column index.</param>
+	/// <param name="y_">The row index.</param>
+	/// <returns>Sample by ref.</returns>
+	ValueType & at(std::size_t const x_, std::size_t const y_);
+
+	/// <summary>
+	/// Returns sample with specified coordinates by value.
+	/// </summary>
+	/// <param name="x_">The column index.</param>
+	/// <param name="y_">The row index.</param>
+	/// <returns>Sample by value.</returns>
+	ValueType at(std::size_t const x_, std::size_t const y_) const;
+
+	/// <summary>
+	/// Returns pointer to the first sample of specified row.
+	/// </summary>
+	/// <param name="y_">The row index.</param>
+	/// <returns>Pointer to the row.</returns>
+	ValueType * row(std::size_t const y_);
+
+	/// <summary>
+	/// Returns pointer to the first sample of specified row.
+	/// </summary>
+	/// <param name="y_">The row index.</param>
+	/// <returns>Pointer to the row.</returns>
+	ValueType const * row(std::size_t const y_) const;
+
+	/// <summary>
+	/// Returns cref to sample container.
+	/// </summary>
+	/// <returns>Sample container by cref.</returns>
+	ContainerType const & getValues() const;
+
+protected:
+	RegionType		m_region;
+	Vector2size		m_resolution;
+	ContainerType	m_values;		// Samples stored row by row, m_resolution.x samples per row.
+};
+
+// Scalar grid specialized with float
+using ScalarGrid2f	= ScalarGrid2<float>;
+// Scalar grid specialized with double
+using ScalarGrid2d	= ScalarGrid2<double>;
+// Scalar grid specialized with long double
+using ScalarGrid2ld	= ScalarGrid2<long double>;
+
+}
+
+#include "Private/ScalarGrid2.inl"
\ No newline at end of file
@@ -1,10 +1,13 @@
 #pragma once
 
 #include "Vector2.hpp"
+#include "Predicates.hpp"
 
 #include "Polygon2.hpp"
 #include "Ball.hpp"
 #include "Box.hpp"
+#include "Aabb.hpp"
+#include "ShapeArrays.hpp"
 
 namespace quickmaffs
 {
@@ -42,6 +45,493 @@ constexpr bool isPointInside(Ball<T, V> const & ball_, typename Ball<T, V>::Vect
 template <template<typename> typename T, typename V>
 constexpr bool isPointInside(Box<T, V> const & box_, typename Box<T, V>::VectorType const & point_);
 
+/// <summary>
+/// Determines whether two balls intersect. Touching balls intersect.
+/// </summary>
+/// <param name="lhs_">The first ball.</param>
+/// <param name="rhs_">The second ball.</param>
+/// <returns>
+///   <c>true</c> if balls intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Ball<T, V> const & lhs_, Ball<T, V> const & rhs_);
+
+/// <summary>
+/// Determines whether two boxes intersect. Touching boxes intersect.
+/// </summary>
+/// <param name="lhs_">The first box.</param>
+/// <param name="rhs_">The second box.</param>
+/// <returns>
+///   <c>true</c> if boxes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Box<T, V> const & lhs_, Box<T, V> const & rhs_);
+
+/// <summary>
+/// Determines whether a ball and a box intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="box_">The box.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Ball<T, V> const & ball_, Box<T, V> const & box_);
+
+/// <summary>
+/// Determines whether a box and a ball intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <param name="ball_">The ball.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Box<T, V> const & box_, Ball<T, V> const & ball_);
+
+/// <summary>
+/// Determines whether the segment intersects the ball.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="from_">The segment start.</param>
+/// <param name="to_">The segment end.</param>
+/// <returns>
+///   <c>true</c> if the segment intersects the ball; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersectsSegment(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const & from_, typename Ball<T, V>::VectorType const & to_);
+
+/// <summary>
+/// Determines whether the segment intersects the box.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <param name="from_">The segment start.</param>
+/// <param name="to_">The segment end.</param>
+/// <returns>
+///   <c>true</c> if the segment intersects the box; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersectsSegment(Box<T, V> const & box_, typename Box<T, V>::VectorType const & from_, typename Box<T, V>::VectorType const & to_);
+
+/// <summary>
+/// Determines whether the ray intersects the ball.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="origin_">The ray origin.</param>
+/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+/// <returns>
+///   <c>true</c> if the ray intersects the ball; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersectsRay(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const & origin_, typename Ball<T, V>::VectorType const & direction_);
+
+/// <summary>
+/// Determines whether the ray intersects the box.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <param name="origin_">The ray origin.</param>
+/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+/// <returns>
+///   <c>true</c> if the ray intersects the box; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersectsRay(Box<T, V> const & box_, typename Box<T, V>::VectorType const & origin_, typename Box<T, V>::VectorType const & direction_);
+
+// Batched variants.
+// Every shape of the array is tested and `mask_` receives 1 (intersects) or 0 per shape, so it must have room for `size()` entries.
+// Loops run over the component arrays without branches, so the compiler vectorizes them.
+
+/// <summary>
+/// Tests the ball against every ball of the array.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="balls_">The tested balls.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersects(Ball<T, V> const & ball_, BallArray<T, V> const & balls_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the ball against every box of the array.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="boxes_">The tested boxes.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersects(Ball<T, V> const & ball_, BoxArray<T, V> const & boxes_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the box against every box of the array.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <param name="boxes_">The tested boxes.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersects(Box<T, V> const & box_, BoxArray<T, V> const & boxes_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the box against every ball of the array.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <param name="balls_">The tested balls.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersects(Box<T, V> const & box_, BallArray<T, V> const & balls_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the segment against every ball of the array.
+/// </summary>
+/// <param name="balls_">The tested balls.</param>
+/// <param name="from_">The segment start.</param>
+/// <param name="to_">The segment end.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersectsSegment(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & from_,
+						typename BallArray<T, V>::VectorType const & to_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the segment against every box of the array.
+/// </summary>
+/// <param name="boxes_">The tested boxes.</param>
+/// <param name="from_">The segment start.</param>
+/// <param name="to_">The segment end.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersectsSegment(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & from_,
+						typename BoxArray<T, V>::VectorType const & to_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the ray against every ball of the array.
+/// </summary>
+/// <param name="balls_">The tested balls.</param>
+/// <param name="origin_">The ray origin.</param>
+/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersectsRay(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & origin_,
+					typename BallArray<T, V>::VectorType const & direction_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the ray against every box of the array.
+/// </summary>
+/// <param name="boxes_">The tested boxes.</param>
+/// <param name="origin_">The ray origin.</param>
+/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+/// <param name="mask_">The result mask.</param>
+template <template<typename> typename T, typename V>
+void intersectsRay(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & origin_,
+					typename BoxArray<T, V>::VectorType const & direction_, std::uint8_t * mask_);
+
+// Batched containment.
+// Point spans are tested against one shape, or one point against a shape array. Results are written
+// as a byte mask (1 inside, 0 outside), a bit mask (bit `i % 64` of word `i / 64`) or a compacted list of indices.
+
+/// <summary>
+/// Tests every point of the span against the ball.
+/// </summary>
+/// <param name="ball_">The ball shape.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="mask_">The result mask, room for `count_` entries.</param>
+template <template<typename> typename T, typename V>
+void isPointInside(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const * points_, std::size_t const count_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests every point of the span against the box.
+/// </summary>
+/// <param name="box_">The box shape.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="mask_">The result mask, room for `count_` entries.</param>
+template <template<typename> typename T, typename V>
+void isPointInside(Box<T, V> const & box_, typename Box<T, V>::VectorType const * points_, std::size_t const count_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests every point of the span against the ball, writing one bit per point.
+/// </summary>
+/// <param name="ball_">The ball shape.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="bits_">The result bits, room for `(count_ + 63) / 64` words. Unused bits of the last word are cleared.</param>
+template <template<typename> typename T, typename V>
+void isPointInsideBits(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const * points_, std::size_t const count_, std::uint64_t * bits_);
+
+/// <summary>
+/// Tests every point of the span against the box, writing one bit per point.
+/// </summary>
+/// <param name="box_">The box shape.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="bits_">The result bits, room for `(count_ + 63) / 64` words. Unused bits of the last word are cleared.</param>
+template <template<typename> typename T, typename V>
+void isPointInsideBits(Box<T, V> const & box_, typename Box<T, V>::VectorType const * points_, std::size_t const count_, std::uint64_t * bits_);
+
+/// <summary>
+/// Finds the points of the span that are inside the ball.
+/// </summary>
+/// <param name="ball_">The ball shape.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="indices_">Receives indices of the points inside, in increasing order. Must have room for `count_` entries.</param>
+/// <returns>Number of points inside.</returns>
+template <template<typename> typename T, typename V>
+std::size_t findPointsInside(Ball<T, V> const & ball_, typename Ball<T, V>::VectorType const * points_, std::size_t const count_, std::size_t * indices_);
+
+/// <summary>
+/// Finds the points of the span that are inside the box.
+/// </summary>
+/// <param name="box_">The box shape.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="indices_">Receives indices of the points inside, in increasing order. Must have room for `count_` entries.</param>
+/// <returns>Number of points inside.</returns>
+template <template<typename> typename T, typename V>
+std::size_t findPointsInside(Box<T, V> const & box_, typename Box<T, V>::VectorType const * points_, std::size_t const count_, std::size_t * indices_);
+
+/// <summary>
+/// Tests the point against every ball of the array.
+/// </summary>
+/// <param name="balls_">The balls.</param>
+/// <param name="point_">The point.</param>
+/// <param name="mask_">The result mask, room for `balls_.size()` entries.</param>
+template <template<typename> typename T, typename V>
+void isPointInside(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & point_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the point against every box of the array.
+/// </summary>
+/// <param name="boxes_">The boxes.</param>
+/// <param name="point_">The point.</param>
+/// <param name="mask_">The result mask, room for `boxes_.size()` entries.</param>
+template <template<typename> typename T, typename V>
+void isPointInside(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & point_, std::uint8_t * mask_);
+
+/// <summary>
+/// Finds the balls of the array that contain the point.
+/// </summary>
+/// <param name="balls_">The balls.</param>
+/// <param name="point_">The point.</param>
+/// <param name="indices_">Receives indices of the balls, in increasing order. Must have room for `balls_.size()` entries.</param>
+/// <returns>Number of balls containing the point.</returns>
+template <template<typename> typename T, typename V>
+std::size_t findShapesContaining(BallArray<T, V> const & balls_, typename BallArray<T, V>::VectorType const & point_, std::size_t * indices_);
+
+/// <summary>
+/// Finds the boxes of the array that contain the point.
+/// </summary>
+/// <param name="boxes_">The boxes.</param>
+/// <param name="point_">The point.</param>
+/// <param name="indices_">Receives indices of the boxes, in increasing order. Must have room for `boxes_.size()` entries.</param>
+/// <returns>Number of boxes containing the point.</returns>
+template <template<typename> typename T, typename V>
+std::size_t findShapesContaining(BoxArray<T, V> const & boxes_, typename BoxArray<T, V>::VectorType const & point_, std::size_t * indices_);
+
+// Axis aligned bounds (min/max corners).
+// Same tests as for boxes, but bounds need no `center ± halfExtent` arithmetic, so they reduce to compares and masks.
+
+/// <summary>
+/// Determines whether the specified point is inside the bounds. Interior is open, like for boxes.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="point_">The point.</param>
+/// <returns>
+///   <c>true</c> if point is inside; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool isPointInside(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const & point_);
+
+/// <summary>
+/// Determines whether two bounds intersect. Touching bounds intersect.
+/// </summary>
+/// <param name="lhs_">The first bounds.</param>
+/// <param name="rhs_">The second bounds.</param>
+/// <returns>
+///   <c>true</c> if bounds intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Aabb<T, V> const & lhs_, Aabb<T, V> const & rhs_);
+
+/// <summary>
+/// Determines whether a ball and bounds intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="aabb_">The bounds.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Ball<T, V> const & ball_, Aabb<T, V> const & aabb_);
+
+/// <summary>
+/// Determines whether bounds and a ball intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="ball_">The ball.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Aabb<T, V> const & aabb_, Ball<T, V> const & ball_);
+
+/// <summary>
+/// Determines whether the segment intersects the bounds.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="from_">The segment start.</param>
+/// <param name="to_">The segment end.</param>
+/// <returns>
+///   <c>true</c> if the segment intersects the bounds; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersectsSegment(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const & from_, typename Aabb<T, V>::VectorType const & to_);
+
+/// <summary>
+/// Determines whether the ray intersects the bounds.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="origin_">The ray origin.</param>
+/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+/// <returns>
+///   <c>true</c> if the ray intersects the bounds; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+bool intersectsRay(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const & origin_, typename Aabb<T, V>::VectorType const & direction_);
+
+/// <summary>
+/// Tests the bounds against every bounds of the array.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="aabbs_">The tested bounds.</param>
+/// <param name="mask_">The result mask, room for `aabbs_.size()` entries.</param>
+template <template<typename> typename T, typename V>
+void intersects(Aabb<T, V> const & aabb_, AabbArray<T, V> const & aabbs_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the ball against every bounds of the array.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <param name="aabbs_">The tested bounds.</param>
+/// <param name="mask_">The result mask, room for `aabbs_.size()` entries.</param>
+template <template<typename> typename T, typename V>
+void intersects(Ball<T, V> const & ball_, AabbArray<T, V> const & aabbs_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the segment against every bounds of the array.
+/// </summary>
+/// <param name="aabbs_">The tested bounds.</param>
+/// <param name="from_">The segment start.</param>
+/// <param name="to_">The segment end.</param>
+/// <param name="mask_">The result mask, room for `aabbs_.size()` entries.</param>
+template <template<typename> typename T, typename V>
+void intersectsSegment(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & from_,
+						typename AabbArray<T, V>::VectorType const & to_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests the ray against every bounds of the array.
+/// </summary>
+/// <param name="aabbs_">The tested bounds.</param>
+/// <param name="origin_">The ray origin.</param>
+/// <param name="direction_">The ray direction, does not have to be normalized.</param>
+/// <param name="mask_">The result mask, room for `aabbs_.size()` entries.</param>
+template <template<typename> typename T, typename V>
+void intersectsRay(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & origin_,
+					typename AabbArray<T, V>::VectorType const & direction_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests every point of the span against the bounds.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="mask_">The result mask, room for `count_` entries.</param>
+template <template<typename> typename T, typename V>
+void isPointInside(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const * points_, std::size_t const count_, std::uint8_t * mask_);
+
+/// <summary>
+/// Tests every point of the span against the bounds, writing one bit per point.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="bits_">The result bits, room for `(count_ + 63) / 64` words. Unused bits of the last word are cleared.</param>
+template <template<typename> typename T, typename V>
+void isPointInsideBits(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const * points_, std::size_t const count_, std::uint64_t * bits_);
+
+/// <summary>
+/// Finds the points of the span that are inside the bounds.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="points_">The points.</param>
+/// <param name="count_">Number of points.</param>
+/// <param name="indices_">Receives indices of the points inside, in increasing order. Must have room for `count_` entries.</param>
+/// <returns>Number of points inside.</returns>
+template <template<typename> typename T, typename V>
+std::size_t findPointsInside(Aabb<T, V> const & aabb_, typename Aabb<T, V>::VectorType const * points_, std::size_t const count_, std::size_t * indices_);
+
+/// <summary>
+/// Tests the point against every bounds of the array.
+/// </summary>
+/// <param name="aabbs_">The bounds.</param>
+/// <param name="point_">The point.</param>
+/// <param name="mask_">The result mask, room for `aabbs_.size()` entries.</param>
+template <template<typename> typename T, typename V>
+void isPointInside(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & point_, std::uint8_t * mask_);
+
+/// <summary>
+/// Finds the bounds of the array that contain the point.
+/// </summary>
+/// <param name="aabbs_">The bounds.</param>
+/// <param name="point_">The point.</param>
+/// <param name="indices_">Receives indices of the bounds, in increasing order. Must have room for `aabbs_.size()` entries.</param>
+/// <returns>Number of bounds containing the point.</returns>
+template <template<typename> typename T, typename V>
+std::size_t findShapesContaining(AabbArray<T, V> const & aabbs_, typename AabbArray<T, V>::VectorType const & point_, std::size_t * indices_);
+
+/// <summary>
+/// Determines whether a box and bounds intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <param name="aabb_">The bounds.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Box<T, V> const & box_, Aabb<T, V> const & aabb_);
+
+/// <summary>
+/// Determines whether bounds and a box intersect. Touching shapes intersect.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <param name="box_">The box.</param>
+/// <returns>
+///   <c>true</c> if shapes intersect; otherwise, <c>false</c>.
+/// </returns>
+template <template<typename> typename T, typename V>
+constexpr bool intersects(Aabb<T, V> const & aabb_, Box<T, V> const & box_);
+
+/// <summary>
+/// Computes axis aligned bounds of the ball.
+/// </summary>
+/// <param name="ball_">The ball.</param>
+/// <returns>The bounds.</returns>
+template <template<typename> typename T, typename V>
+constexpr Aabb<T, V> computeBounds(Ball<T, V> const & ball_);
+
+/// <summary>
+/// Computes axis aligned bounds of the box.
+/// </summary>
+/// <param name="box_">The box.</param>
+/// <returns>The bounds.</returns>
+template <template<typename> typename T, typename V>
+constexpr Aabb<T, V> computeBounds(Box<T, V> const & box_);
+
+/// <summary>
+/// Returns the bounds, so generic code can call <c>computeBounds</c> on any shape.
+/// </summary>
+/// <param name="aabb_">The bounds.</param>
+/// <returns>The bounds.</returns>
+template <template<typename> typename T, typename V>
+constexpr Aabb<T, V> computeBounds(Aabb<T, V> const & aabb_);
+
 }
 
 #include "Private/ShapeAlgorithms.inl"
\ No newline at end of file
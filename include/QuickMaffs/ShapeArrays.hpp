@@ -0,0 +1,283 @@
+// File description:
+// Implements structure-of-arrays containers of shapes, used by batched shape algorithms.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Ball.hpp"
+#include "Box.hpp"
+#include "Aabb.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Balls stored as structure of arrays: one contiguous array per center component plus radii.
+/// </summary>
+template <template <typename> typename TVectorType, typename TValueType>
+struct BallArray
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using ShapeType		= Ball<TVectorType, ValueType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	/// <summary>
+	/// Returns number of stored balls.
+	/// </summary>
+	/// <returns>Number of stored balls.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Reserves memory for the specified number of balls.
+	/// </summary>
+	/// <param name="capacity_">The capacity.</param>
+	void reserve(std::size_t const capacity_);
+
+	/// <summary>
+	/// Removes all balls.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Appends the ball.
+	/// </summary>
+	/// <param name="ball_">The ball.</param>
+	void push_back(ShapeType const & ball_);
+
+	/// <summary>
+	/// Returns ball at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <returns>Ball at specified index.</returns>
+	ShapeType get(std::size_t const index_) const;
+
+	/// <summary>
+	/// Replaces ball at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <param name="ball_">The ball.</param>
+	void set(std::size_t const index_, ShapeType const & ball_);
+
+	std::array< std::vector<ValueType>, Dimensions >	centers;
+	std::vector<ValueType>								radii;
+};
+
+/// <summary>
+/// Boxes stored as structure of arrays: one contiguous array per center and half extent component.
+/// </summary>
+template <template <typename> typename TVectorType, typename TValueType>
+struct BoxArray
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using ShapeType		= Box<TVectorType, ValueType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	/// <summary>
+	/// Returns number of stored boxes.
+	/// </summary>
+	/// <returns>Number of stored boxes.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Reserves memory for the specified number of boxes.
+	/// </summary>
+	/// <param name="capacity_">The capacity.</param>
+	void reserve(std::size_t const capacity_);
+
+	/// <summary>
+	/// Removes all boxes.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Appends the box.
+	/// </summary>
+	/// <param name="box_">The box.</param>
+	void push_back(ShapeType const & box_);
+
+	/// <summary>
+	/// Returns box at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <returns>Box at specified index.</returns>
+	ShapeType get(std::size_t const index_) const;
+
+	/// <summary>
+	/// Replaces box at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <param name="box_">The box.</param>
+	void set(std::size_t const index_, ShapeType const & box_);
+
+	std::array< std::vector<ValueType>, Dimensions >	centers;
+	std::array< std::vector<ValueType>, Dimensions >	halfExtents;
+};
+
+/// <summary>
+/// Axis aligned bounding boxes stored as structure of arrays: one contiguous array per minimum and maximum corner component.
+/// </summary>
+template <template <typename> typename TVectorType, typename TValueType>
+struct AabbArray
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+	using ShapeType		= Aabb<TVectorType, ValueType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	/// <summary>
+	/// Returns number of stored bounds.
+	/// </summary>
+	/// <returns>Number of stored bounds.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Reserves memory for the specified number of bounds.
+	/// </summary>
+	/// <param name="capacity_">The capacity.</param>
+	void reserve(std::size_t const capacity_);
+
+	/// <summary>
+	/// Removes all bounds.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Appends the bounds.
+	/// </summary>
+	/// <param name="aabb_">The bounds.</param>
+	void push_back(ShapeType const & aabb_);
+
+	/// <summary>
+	/// Returns bounds at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <returns>Bounds at specified index.</returns>
+	ShapeType get(std::size_t const index_) const;
+
+	/// <summary>
+	/// Replaces bounds at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <param name="aabb_">The bounds.</param>
+	void set(std::size_t const index_, ShapeType const & aabb_);
+
+	std::array< std::vector<ValueType>, Dimensions >	lowers;
+	std::array< std::vector<ValueType>, Dimensions >	uppers;
+};
+
+/// <summary>
+/// Points stored as structure of arrays: one contiguous array per component.
+/// </summary>
+template <template <typename> typename TVectorType, typename TValueType>
+struct PointArray
+{
+	// Aliases:
+	using ValueType		= TValueType;
+	using VectorType	= TVectorType<ValueType>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	/// <summary>
+	/// Initializes a new, empty instance of the <see cref="PointArray"/> struct.
+	/// </summary>
+	PointArray() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="PointArray"/> struct from array of structures.
+	/// </summary>
+	/// <param name="points_">The points.</param>
+	explicit PointArray(std::vector<VectorType> const & points_);
+
+	/// <summary>
+	/// Returns number of stored points.
+	/// </summary>
+	/// <returns>Number of stored points.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Reserves memory for the specified number of points.
+	/// </summary>
+	/// <param name="capacity_">The capacity.</param>
+	void reserve(std::size_t const capacity_);
+
+	/// <summary>
+	/// Removes all points.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Appends the point.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	void push_back(VectorType const & point_);
+
+	/// <summary>
+	/// Returns point at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <returns>Point at specified index.</returns>
+	VectorType get(std::size_t const index_) const;
+
+	/// <summary>
+	/// Replaces point at specified index.
+	/// </summary>
+	/// <param name="index_">The index.</param>
+	/// <param name="point_">The point.</param>
+	void set(std::size_t const index_, VectorType const & point_);
+
+	std::array< std::vector<ValueType>, Dimensions >	coordinates;
+};
+
+template <typename TValueType>
+using Circle2Array	= BallArray<Vector2, TValueType>;
+
+template <typename TValueType>
+using Sphere3Array	= BallArray<Vector3, TValueType>;
+
+template <typename TValueType>
+using Rect2Array	= BoxArray<Vector2, TValueType>;
+
+template <typename TValueType>
+using Cuboid3Array	= BoxArray<Vector3, TValueType>;
+
+template <typename TValueType>
+using Aabb2Array	= AabbArray<Vector2, TValueType>;
+
+template <typename TValueType>
+using Aabb3Array	= AabbArray<Vector3, TValueType>;
+
+template <typename TValueType>
+using Point2Array	= PointArray<Vector2, TValueType>;
+
+template <typename TValueType>
+using Point3Array	= PointArray<Vector3, TValueType>;
+
+using Circle2fArray		= Circle2Array<float>;
+using Circle2dArray		= Circle2Array<double>;
+using Sphere3fArray		= Sphere3Array<float>;
+using Sphere3dArray		= Sphere3Array<double>;
+using Rect2fArray		= Rect2Array<float>;
+using Rect2dArray		= Rect2Array<double>;
+using Cuboid3fArray		= Cuboid3Array<float>;
+using Cuboid3dArray		= Cuboid3Array<double>;
+using Aabb2fArray		= Aabb2Array<float>;
+using Aabb2dArray		= Aabb2Array<double>;
+using Aabb3fArray		= Aabb3Array<float>;
+using Aabb3dArray		= Aabb3Array<double>;
+using Point2fArray		= Point2Array<float>;
+using Point2dArray		= Point2Array<double>;
+using Point3fArray		= Point3Array<float>;
+using Point3dArray		= Point3Array<double>;
+
+}
+
+#include "Private/ShapeArrays.inl"
\ No newline at end of file
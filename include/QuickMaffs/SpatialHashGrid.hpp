@@ -0,0 +1,132 @@
+// File description:
+// Implements spatial hash grid broadphase for balls, boxes or bounds.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Aabb.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Broadphase over a collection of shapes (<see cref="Ball"/>, <see cref="Box"/> or <see cref="Aabb"/>) bucketed
+/// by the uniform grid cells they touch. Suits dense collections of shapes of similar size.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Cells are hashed into buckets, so the grid is unbounded and its memory depends only on the shapes.
+/// Every shape is entered once per cell its bounds touch; the entries are sorted by bucket with a counting sort
+/// into one flat array. Cell size should be about the size of the larger shapes: smaller cells make
+/// large shapes touch many cells, larger ones put many shapes into one cell.
+/// </para>
+/// <para>
+/// Two shapes sharing several cells are reported once, in the first cell they share.
+/// </para>
+/// </remarks>
+template <typename TShapeType>
+class SpatialHashGrid
+{
+public:
+
+	using ShapeType		= TShapeType;
+	using ValueType		= typename ShapeType::ValueType;
+	using VectorType	= typename ShapeType::VectorType;
+	using AabbType		= decltype(computeBounds(std::declval<ShapeType>()));
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+
+	using CellType		= std::array<std::int32_t, Dimensions>;
+	using PairType		= std::pair<std::size_t, std::size_t>;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="SpatialHashGrid"/> class.
+	/// </summary>
+	/// <param name="cellSize_">Edge length of the grid cells. Must be positive.</param>
+	explicit SpatialHashGrid(ValueType const cellSize_);
+
+	/// <summary>
+	/// Rebuilds the grid over the shapes.
+	/// </summary>
+	/// <param name="shapes_">The shapes.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	void build(std::vector<ShapeType> shapes_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Returns number of shapes.
+	/// </summary>
+	/// <returns>Number of shapes.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Returns edge length of the grid cells.
+	/// </summary>
+	/// <returns>Edge length of the grid cells.</returns>
+	ValueType getCellSize() const;
+
+	/// <summary>
+	/// Returns the shapes, in the order passed to <c>build</c>.
+	/// </summary>
+	/// <returns>The shapes.</returns>
+	std::vector<ShapeType> const & getShapes() const;
+
+	/// <summary>
+	/// Returns the cell containing the point. Coordinates beyond the range of the cell type are clamped.
+	/// </summary>
+	/// <param name="point_">The point.</param>
+	/// <returns>The cell.</returns>
+	CellType getCell(VectorType const & point_) const;
+
+	/// <summary>
+	/// Calls the function with index of every shape intersecting the query shape.
+	/// </summary>
+	/// <param name="shape_">The query shape: ball, box or bounds.</param>
+	/// <param name="function_">The function, called as function_(index).</param>
+	template <typename TQueryShapeType, typename TFunction>
+	void forEachOverlapping(TQueryShapeType const & shape_, TFunction && function_) const;
+
+	/// <summary>
+	/// Finds indices of the shapes intersecting the query shape.
+	/// </summary>
+	/// <param name="shape_">The query shape: ball, box or bounds.</param>
+	/// <returns>Indices of the shapes.</returns>
+	template <typename TQueryShapeType>
+	std::vector<std::size_t> findOverlapping(TQueryShapeType const & shape_) const;
+
+	/// <summary>
+	/// Finds all pairs of intersecting shapes.
+	/// </summary>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <returns>The pairs, smaller index first. Order of the pairs is unspecified.</returns>
+	std::vector<PairType> findOverlappingPairs(std::size_t const threadCount_ = 0) const;
+
+private:
+	void computeCellRange(AabbType const & bounds_, CellType & lower_, CellType & upper_) const;
+
+	std::size_t getBucket(CellType const & cell_) const;
+
+	/// <summary>
+	/// Calls the function with every cell of the range.
+	/// </summary>
+	template <typename TFunction>
+	static void forEachCell(CellType const & lower_, CellType const & upper_, TFunction && function_);
+
+	/// <summary>
+	/// Checks whether the cell is the first one shared by the two cell ranges.
+	/// </summary>
+	static bool isFirstSharedCell(CellType const & cell_, CellType const & firstLower_, CellType const & secondLower_);
+
+	ValueType					m_cellSize;
+	std::vector<ShapeType>		m_shapes;
+	std::vector<CellType>		m_lowerCells;		// Indexed by shape.
+	std::vector<CellType>		m_entryCells;		// Sorted by bucket.
+	std::vector<std::uint32_t>	m_entryShapes;		// Sorted by bucket.
+	std::vector<std::uint32_t>	m_bucketStarts;		// Entries of bucket i are [m_bucketStarts[i], m_bucketStarts[i + 1]).
+	std::uint32_t				m_bucketMask = 0;	// Bucket count is a power of 2.
+};
+
+}
+
+#include "Private/SpatialHashGrid.inl"
\ No newline at end of file
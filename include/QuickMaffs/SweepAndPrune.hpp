@@ -0,0 +1,103 @@
+// File description:
+// Implements sweep-and-prune broadphase for balls, boxes or bounds.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Aabb.hpp"
+#include "ShapeAlgorithms.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Sweep-and-prune broadphase over a collection of shapes (<see cref="Ball"/>, <see cref="Box"/> or <see cref="Aabb"/>).
+/// </summary>
+/// <remarks>
+/// <para>
+/// Shapes are kept sorted by the lower end of their intervals on the sweep axis. Pairs are found by sweeping
+/// the sorted intervals, and tested exactly only when the intervals overlap.
+/// </para>
+/// <para>
+/// When the shapes moved only a little since the previous update, the order is repaired by insertion sort,
+/// which is close to linear then. The first update, a change of the shape count or of the axis, and too much
+/// reordering fall back to radix sort.
+/// </para>
+/// </remarks>
+template <typename TShapeType>
+class SweepAndPrune
+{
+public:
+
+	using ShapeType		= TShapeType;
+	using ValueType		= typename ShapeType::ValueType;
+	using VectorType	= typename ShapeType::VectorType;
+	using PairType		= std::pair<std::size_t, std::size_t>;
+
+	static constexpr std::size_t Dimensions = VectorType{}.size();
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="SweepAndPrune"/> class.
+	/// </summary>
+	/// <param name="axis_">The sweep axis, or npos to use the axis along which the shape centers vary the most.</param>
+	explicit SweepAndPrune(std::size_t const axis_ = npos);
+
+	/// <summary>
+	/// Updates the shapes. Index of a shape is its position in the vector.
+	/// </summary>
+	/// <param name="shapes_">The shapes.</param>
+	/// <param name="threadCount_">Number of worker threads used for radix sort; 0 means one thread per hardware thread.</param>
+	void update(std::vector<ShapeType> shapes_, std::size_t const threadCount_ = 0);
+
+	/// <summary>
+	/// Removes all the shapes, so the next update sorts from scratch.
+	/// </summary>
+	void clear();
+
+	/// <summary>
+	/// Returns number of shapes.
+	/// </summary>
+	/// <returns>Number of shapes.</returns>
+	std::size_t size() const;
+
+	/// <summary>
+	/// Returns the current sweep axis.
+	/// </summary>
+	/// <returns>The sweep axis, npos before the first update.</returns>
+	std::size_t getAxis() const;
+
+	/// <summary>
+	/// Returns indices of the shapes sorted by the lower end of their intervals on the sweep axis.
+	/// </summary>
+	/// <returns>The sorted indices.</returns>
+	std::vector<std::uint32_t> const & getOrder() const;
+
+	/// <summary>
+	/// Finds all pairs of intersecting shapes.
+	/// </summary>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <returns>The pairs, smaller index first.</returns>
+	std::vector<PairType> findOverlappingPairs(std::size_t const threadCount_ = 0) const;
+
+private:
+	std::size_t chooseAxis(bool const keepCurrent_) const;
+
+	bool repairOrder();
+
+	void sortOrder(std::size_t const threadCount_);
+
+	std::size_t					m_fixedAxis;
+	std::size_t					m_axis = npos;
+	std::vector<ShapeType>		m_shapes;
+	std::vector<ValueType>		m_lowers;			// Interval of every shape on the axis, by shape index.
+	std::vector<ValueType>		m_uppers;
+	std::vector<std::uint32_t>	m_order;
+	std::vector<ValueType>		m_sortedLowers;		// Intervals in the sorted order.
+	std::vector<ValueType>		m_sortedUppers;
+};
+
+}
+
+#include "Private/SweepAndPrune.inl"
\ No newline at end of file
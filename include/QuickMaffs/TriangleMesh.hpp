@@ -0,0 +1,142 @@
+// File description:
+// Implements indexed triangle mesh with batched ray casting and parallel vertex normals.
+#pragma once
+
+// Precompiled header:
+#include "Private/PrecompiledHeader.hpp"
+
+#include "Vector3.hpp"
+#include "Ray.hpp"
+
+namespace quickmaffs
+{
+
+/// <summary>
+/// Ray hit found on a triangle mesh.
+/// </summary>
+template <typename TValueType>
+struct TriangleHit
+{
+	std::size_t	triangle;	// Index of the triangle, npos of the mesh when the ray missed.
+	TValueType	distance;	// Ray parameter t of the hit, infinity when the ray missed.
+	TValueType	u;			// Barycentric weight of the second triangle vertex.
+	TValueType	v;			// Barycentric weight of the third triangle vertex.
+};
+
+/// <summary>
+/// Indexed triangle mesh: shared vertex array plus three vertex indices per triangle.
+/// </summary>
+/// <remarks>
+/// <para>
+/// Besides the vertices and indices, the mesh keeps the first corner and both edges of every triangle
+/// as structure of arrays. Ray casts run Möller–Trumbore against blocks of triangles with a branch-free loop
+/// that the compiler vectorizes, so a cast costs no gather of vertices through indices.
+/// The mesh is immutable; construct a new one when the geometry changes.
+/// </para>
+/// <para>
+/// Casts are brute force over all triangles. For large meshes, put the triangle bounds into
+/// a <see cref="BoundingVolumeHierarchy"/> first.
+/// </para>
+/// </remarks>
+template <typename TValueType>
+class TriangleMesh
+{
+public:
+
+	using ValueType		= TValueType;
+	using VectorType	= Vector3<ValueType>;
+	using IndexType		= std::uint32_t;
+	using RayType		= Ray3<ValueType>;
+	using HitType		= TriangleHit<ValueType>;
+
+	static_assert(std::is_floating_point_v<ValueType>, "Triangle mesh requires floating point type");
+
+	static constexpr std::size_t npos = std::numeric_limits<std::size_t>::max();
+
+	/// <summary>
+	/// Initializes a new, empty instance of the <see cref="TriangleMesh"/> class.
+	/// </summary>
+	TriangleMesh() = default;
+
+	/// <summary>
+	/// Initializes a new instance of the <see cref="TriangleMesh"/> class.
+	/// </summary>
+	/// <param name="vertices_">The vertices.</param>
+	/// <param name="indices_">Three vertex indices per triangle.</param>
+	/// <exception cref="std::invalid_argument">Index count is not a multiple of three.</exception>
+	/// <exception cref="std::out_of_range">An index does not refer to a vertex.</exception>
+	/// <exception cref="std::length_error">There are more vertices than fit into the index type.</exception>
+	TriangleMesh(std::vector<VectorType> vertices_, std::vector<IndexType> indices_);
+
+	/// <summary>
+	/// Returns the vertices.
+	/// </summary>
+	/// <returns>The vertices.</returns>
+	std::vector<VectorType> const & getVertices() const;
+
+	/// <summary>
+	/// Returns the vertex indices, three per triangle.
+	/// </summary>
+	/// <returns>The vertex indices.</returns>
+	std::vector<IndexType> const & getIndices() const;
+
+	/// <summary>
+	/// Returns number of triangles.
+	/// </summary>
+	/// <returns>Number of triangles.</returns>
+	std::size_t getTriangleCount() const;
+
+	/// <summary>
+	/// Returns corners of the triangle.
+	/// </summary>
+	/// <param name="triangle_">The triangle index.</param>
+	/// <returns>Corners of the triangle.</returns>
+	std::array<VectorType, 3> getTriangle(std::size_t const triangle_) const;
+
+	/// <summary>
+	/// Computes normal of every vertex as the normalized, area-weighted sum of normals of triangles sharing it.
+	/// </summary>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <returns>Unit normal of every vertex; zero for vertices not used by any non-degenerate triangle.</returns>
+	/// <remarks>
+	/// <para>
+	/// Triangles are split between threads and every thread accumulates into its own buffer of vertex normals,
+	/// so no atomics are needed; the buffers are summed afterwards, again in parallel over vertices.
+	/// Normals follow counter-clockwise winding. Needs one buffer of vertex normals per thread.
+	/// </para>
+	/// </remarks>
+	std::vector<VectorType> computeVertexNormals(std::size_t const threadCount_ = 0) const;
+
+	/// <summary>
+	/// Finds the first triangle hit by the ray. Both sides of the triangles are hit.
+	/// </summary>
+	/// <param name="ray_">The ray.</param>
+	/// <returns>The nearest hit; triangle is npos when the ray misses.</returns>
+	HitType castRay(RayType const & ray_) const;
+
+	/// <summary>
+	/// Finds the first triangle hit by every ray, splitting rays between threads.
+	/// </summary>
+	/// <param name="rays_">The rays.</param>
+	/// <param name="threadCount_">Number of worker threads; 0 means one thread per hardware thread.</param>
+	/// <returns>The nearest hit of every ray.</returns>
+	std::vector<HitType> castRays(std::vector<RayType> const & rays_, std::size_t const threadCount_ = 0) const;
+
+private:
+
+	std::vector<VectorType>						m_vertices;
+	std::vector<IndexType>						m_indices;
+
+	// First corner and both edges of every triangle, structure of arrays.
+	std::array< std::vector<ValueType>, 3 >		m_corners;
+	std::array< std::vector<ValueType>, 3 >		m_edges1;
+	std::array< std::vector<ValueType>, 3 >		m_edges2;
+};
+
+using TriangleMeshf		= TriangleMesh<float>;
+using TriangleMeshd		= TriangleMesh<double>;
+using TriangleMeshld	= TriangleMesh<long double>;
+
+}
+
+#include "Private/TriangleMesh.inl"
\ No newline at end of file
@@ -161,23 +161,23 @@ public:
 	}
 
 	/// <summary>
-	/// Computes cross product of two vectors (this and rhs).
+	/// Computes cross product of two vectors (this and other_).
 	/// </summary>
 	/// <param name="other_">The other vector.</param>
-	/// <returns>Cross product of two vectors.</returns>
-	template <typename TCrossType,
+	/// <returns>Z component of the cross product: positive when `other_` is counterclockwise from this vector.</returns>
+	template <typename TCrossType = ValueType,
 		typename = std::enable_if_t< type_traits::isMathScalarV<TCrossType> > >
 	constexpr TCrossType cross(Vector2 const & other_) const
 	{
 		if constexpr(std::is_same_v<TCrossType, ValueType>)
-			return x * other_.y + y * other_.x;
+			return x * other_.y - y * other_.x;
 		else
 		{
 			auto convThis = this->convert<TCrossType>();
 			auto convOther = other_.convert<TCrossType>();
 
 			return static_cast<TCrossType>(
-				convThis.x * convOther.y + convThis.y * convOther.x
+				convThis.x * convOther.y - convThis.y * convOther.x
 			);
 		}
 	}
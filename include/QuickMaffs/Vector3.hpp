@@ -231,7 +231,7 @@ public:
 	/// <returns>Vector with absolute values.</returns>
 	Vector3 absolute() const
 	{
-		return Vector3{ std::abs(x), std::abs(y), std::abs(y) };
+		return Vector3{ std::abs(x), std::abs(y), std::abs(z) };
 	}
 
 	// yet non-constexpr
@@ -328,7 +328,7 @@ public:
 	/// </returns>
 	constexpr static Vector3 upperBounds(Vector3 const & left_, Vector3 const & right_)
 	{
-		return Vector3{ std::max(left_.x, right_.x), std::max(left_.y, right_.y), std::min(left_.z, right_.z) };
+		return Vector3{ std::max(left_.x, right_.x), std::max(left_.y, right_.y), std::max(left_.z, right_.z) };
 	}
 
 	/// <summary>